@@ -0,0 +1,150 @@
+// The inputs where 32-bit targets differ the most: 64-bit products and long
+// runs of digits. The bench_32bit_m32 target, built when the compiler can
+// link -m32 programs (gcc-multilib), runs the same code as a 32-bit program.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// Every number is followed by a '\0' so that strtod can parse it in place.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+template <typename Generate> dataset make_dataset(size_t n, Generate gen) {
+  dataset data;
+  for (size_t i = 0; i < n; ++i) {
+    char buf[64];
+    gen(buf, sizeof(buf));
+    data.buffer.append(buf);
+    data.buffer.push_back('\0');
+  }
+  data.count = n;
+  return data;
+}
+
+template <typename T> T reference(char const *p, char **end) {
+  return std::strtod(p, end);
+}
+
+template <> float reference<float>(char const *p, char **end) {
+  return std::strtof(p, end);
+}
+
+template <typename T> void validate(dataset const &data) {
+  char const *p = data.buffer.data();
+  for (size_t i = 0; i < data.count; ++i) {
+    size_t const length = std::strlen(p);
+    T expected = reference<T>(p, nullptr);
+    T value;
+    auto r = fast_float::from_chars(p, p + length, value);
+    if (r.ptr != p + length || std::memcmp(&value, &expected, sizeof(T))) {
+      printf("Validation failed for %s\n", p);
+      std::abort();
+    }
+    p += length + 1;
+  }
+}
+
+template <typename T> void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  validate<T>(data);
+  volatile double sink = 0;
+  pretty_print(data.count, data.buffer.size(), "strtod",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char *end;
+                   sum += reference<T>(p, &end);
+                   if (end == p)
+                     std::abort();
+                   p = end + 1;
+                 }
+                 sink = sink + sum;
+               }));
+  pretty_print(data.count, data.buffer.size(), "fastfloat",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char const *pend = p + std::strlen(p);
+                   T value;
+                   auto r = fast_float::from_chars(p, pend, value);
+                   if (r.ptr != pend)
+                     std::abort();
+                   sum += value;
+                   p = pend + 1;
+                 }
+                 sink = sink + sum;
+               }));
+}
+
+int main() {
+#ifdef FASTFLOAT_32BIT
+  printf("# 32-bit target\n");
+#else
+  printf("# 64-bit target\n");
+#endif
+  constexpr size_t N = 100000;
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+  std::uniform_real_distribution<double> measure_dist(-1000, 1000);
+
+  run<float>(make_dataset(N,
+                          [&](char *buf, size_t size) {
+                            float value;
+                            do {
+                              uint32_t const bits = uint32_t(rng());
+                              std::memcpy(&value, &bits, sizeof(value));
+                            } while (!std::isfinite(value));
+                            snprintf(buf, size, "%.9g", double(value));
+                          }),
+             "float, full exponent range, 9 digits");
+  run<double>(make_dataset(N,
+                           [&](char *buf, size_t size) {
+                             snprintf(buf, size, "%.17g", unit_dist(rng));
+                           }),
+              "unit interval, 17 digits");
+  run<double>(make_dataset(N,
+                           [&](char *buf, size_t size) {
+                             snprintf(buf, size, "%.3f", measure_dist(rng));
+                           }),
+              "measurements, 3 decimals");
+  run<double>(make_dataset(N,
+                           [&](char *buf, size_t size) {
+                             snprintf(buf, size, "%llu",
+                                      static_cast<unsigned long long>(
+                                          rng() >> (rng() % 40)));
+                           }),
+              "integers, 8 to 20 digits");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// Every number is followed by a '\0'.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+template <typename Generate> dataset make_dataset(size_t n, Generate gen) {
+  dataset data;
+  for (size_t i = 0; i < n; ++i) {
+    char buf[128];
+    gen(buf, sizeof(buf));
+    data.buffer.append(buf);
+    data.buffer.push_back('\0');
+  }
+  data.count = n;
+  return data;
+}
+
+// Counts the results that differ from from_chars, and checks that they are
+// the neighbours of the exact results.
+void validate(dataset const &data) {
+  char const *p = data.buffer.data();
+  size_t off_by_one = 0;
+  for (size_t i = 0; i < data.count; ++i) {
+    size_t const length = std::strlen(p);
+    double expected, value;
+    fast_float::from_chars(p, p + length, expected);
+    auto r = fast_float::from_chars_approximate(p, p + length, value);
+    if (r.ptr != p + length) {
+      printf("Validation failed for %s\n", p);
+      std::abort();
+    }
+    if (value != expected) {
+      if (value != std::nextafter(expected, 0.0) &&
+          value != std::nextafter(expected, 2 * expected)) {
+        printf("More than 1 ULP away for %s\n", p);
+        std::abort();
+      }
+      ++off_by_one;
+    }
+    p += length + 1;
+  }
+  printf("# %zu results (%.3f%%) are 1 ULP away\n", off_by_one,
+         100.0 * double(off_by_one) / double(data.count));
+}
+
+template <typename Parse>
+counters::event_aggregate time_it(dataset const &data, Parse parse) {
+  volatile double sink = 0;
+  return counters::bench([&]() {
+    double sum = 0;
+    char const *p = data.buffer.data();
+    for (size_t i = 0; i < data.count; ++i) {
+      char const *pend = p + std::strlen(p);
+      double value;
+      if (parse(p, pend, value) != pend)
+        std::abort();
+      sum += value;
+      p = pend + 1;
+    }
+    sink = sink + sum;
+  });
+}
+
+void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  validate(data);
+  pretty_print(data.count, data.buffer.size(), "from_chars",
+               time_it(data, [](char const *p, char const *pend, double &d) {
+                 return fast_float::from_chars(p, pend, d).ptr;
+               }));
+  pretty_print(data.count, data.buffer.size(), "from_chars_approximate",
+               time_it(data, [](char const *p, char const *pend, double &d) {
+                 return fast_float::from_chars_approximate(p, pend, d).ptr;
+               }));
+}
+
+double random_double(std::mt19937_64 &rng) {
+  double value;
+  do {
+    uint64_t const bits = rng();
+    std::memcpy(&value, &bits, sizeof(value));
+  } while (!std::isfinite(value));
+  return value;
+}
+
+int main() {
+  constexpr size_t N = 200000;
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     snprintf(buf, size, "%.17g", unit_dist(rng));
+                   }),
+      "unit interval, 17 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     snprintf(buf, size, "%.25g", unit_dist(rng));
+                   }),
+      "unit interval, 25 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     // a high-precision export: 20 to 40 random digits
+                     size_t const digits = 20 + rng() % 21;
+                     size_t i = 0;
+                     buf[i++] = '0';
+                     buf[i++] = '.';
+                     for (size_t d = 0; d < digits && i + 1 < size; ++d) {
+                       buf[i++] = char('0' + rng() % 10);
+                     }
+                     buf[i] = '\0';
+                   }),
+      "random digits, 20 to 40 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     // close to the halfway point between two doubles
+                     double const value = random_double(rng);
+                     long double const halfway =
+                         (static_cast<long double>(value) +
+                          std::nextafter(value, INFINITY)) /
+                         2;
+                     snprintf(buf, size, "%.30Le", halfway);
+                   }),
+      "halfway points, 31 digits");
+  return EXIT_SUCCESS;
+}
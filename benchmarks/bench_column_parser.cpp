@@ -0,0 +1,99 @@
+// Columns of prices and coordinates, where every number has the same shape,
+// parsed with from_chars and with a column_parser_t which learns the shape.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+double sum_from_chars(std::string const &text, size_t count) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    double x;
+    auto const r = fast_float::from_chars(p, end, x);
+    if (r.ec != std::errc()) {
+      printf("bug in sum_from_chars\n");
+      std::abort();
+    }
+    answer += x;
+    p = r.ptr + 1;
+  }
+  return answer;
+}
+
+double sum_column_parser(std::string const &text, size_t count) {
+  fast_float::column_parser_t<double> parser;
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    double x;
+    auto const r = parser.parse(p, end, x);
+    if (r.ec != std::errc()) {
+      printf("bug in sum_column_parser\n");
+      std::abort();
+    }
+    answer += x;
+    p = r.ptr + 1;
+  }
+  return answer;
+}
+
+void run(char const *format, double low, double high) {
+  std::mt19937_64 rng(45);
+  std::uniform_real_distribution<double> dis(low, high);
+  size_t const count = 100000;
+  std::string text;
+  char buffer[64];
+  for (size_t i = 0; i < count; ++i) {
+    snprintf(buffer, sizeof(buffer), format, dis(rng));
+    text += buffer;
+    text += '\n';
+  }
+  printf("# %s in [%g, %g): %zu bytes\n", format, low, high, text.size());
+  double const expected = sum_from_chars(text, count);
+  if (sum_column_parser(text, count) != expected) {
+    printf("Validation failed for %s\n", format);
+    std::abort();
+  }
+  volatile double sink = 0;
+  pretty_print(count, text.size(), "from_chars", counters::bench([&]() {
+                 sink = sink + sum_from_chars(text, count);
+               }));
+  pretty_print(count, text.size(), "column_parser_t", counters::bench([&]() {
+                 sink = sink + sum_column_parser(text, count);
+               }));
+}
+
+int main() {
+  run("%.2f", 10000, 99999);   // prices
+  run("%.6f", -89, -10);       // latitudes
+  run("%.6f", 100, 179);       // longitudes
+  run("%.0f", 100000, 999999); // identifiers
+  run("%.9g", -1, 1);          // no common shape
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// Every number is followed by a '\0'.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+template <typename Generate> dataset make_dataset(size_t n, Generate gen) {
+  dataset data;
+  for (size_t i = 0; i < n; ++i) {
+    char buf[64];
+    gen(buf, sizeof(buf));
+    data.buffer.append(buf);
+    data.buffer.push_back('\0');
+  }
+  data.count = n;
+  return data;
+}
+
+void validate(dataset const &data) {
+  char const *p = data.buffer.data();
+  for (size_t i = 0; i < data.count; ++i) {
+    size_t const length = std::strlen(p);
+    double expected_d, d;
+    float expected_f, f;
+    fast_float::from_chars(p, p + length, expected_d);
+    fast_float::from_chars(p, p + length, expected_f);
+    auto r = fast_float::from_chars_dual(p, p + length, d, f);
+    if (r.ptr != p + length || d != expected_d || f != expected_f) {
+      printf("Validation failed for %s\n", p);
+      std::abort();
+    }
+    p += length + 1;
+  }
+}
+
+template <typename Parse>
+counters::event_aggregate time_it(dataset const &data, Parse parse) {
+  volatile double sink = 0;
+  return counters::bench([&]() {
+    double sum = 0;
+    char const *p = data.buffer.data();
+    for (size_t i = 0; i < data.count; ++i) {
+      char const *pend = p + std::strlen(p);
+      double d;
+      float f;
+      if (parse(p, pend, d, f) != pend)
+        std::abort();
+      sum += d + f;
+      p = pend + 1;
+    }
+    sink = sink + sum;
+  });
+}
+
+void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  validate(data);
+  pretty_print(data.count, data.buffer.size(), "from_chars double, then float",
+               time_it(data, [](char const *p, char const *pend, double &d,
+                                float &f) {
+                 fast_float::from_chars(p, pend, d);
+                 return fast_float::from_chars(p, pend, f).ptr;
+               }));
+  // Not correctly rounded (double rounding), only here for reference.
+  pretty_print(data.count, data.buffer.size(), "from_chars double, cast",
+               time_it(data, [](char const *p, char const *pend, double &d,
+                                float &f) {
+                 auto r = fast_float::from_chars(p, pend, d);
+                 f = float(d);
+                 return r.ptr;
+               }));
+  pretty_print(data.count, data.buffer.size(), "from_chars_dual",
+               time_it(data, [](char const *p, char const *pend, double &d,
+                                float &f) {
+                 return fast_float::from_chars_dual(p, pend, d, f).ptr;
+               }));
+}
+
+int main() {
+  constexpr size_t N = 200000;
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> latitude(-90, 90);
+  std::uniform_real_distribution<double> longitude(-180, 180);
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     snprintf(buf, size, "%.7f",
+                              (rng() & 1) ? latitude(rng) : longitude(rng));
+                   }),
+      "coordinates, 7 decimals");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     snprintf(buf, size, "%.17g", unit_dist(rng));
+                   }),
+      "unit interval, 17 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     double value;
+                     do {
+                       uint64_t const bits = rng();
+                       std::memcpy(&value, &bits, sizeof(value));
+                     } while (!std::isfinite(value) || std::fabs(value) > 1e38 ||
+                              std::fabs(value) < 1e-38);
+                     snprintf(buf, size, "%.17g", value);
+                   }),
+      "float exponent range, 17 digits");
+  return EXIT_SUCCESS;
+}
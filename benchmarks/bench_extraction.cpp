@@ -0,0 +1,172 @@
+// Log lines with numbers at unknown positions: std::regex finds them, or a
+// hand-written loop calls from_chars at every digit, sign or point, or
+// extract_numbers scans the text between them 16 chars at a time.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mnum/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/n ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/n ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/n ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+struct summary {
+  size_t count;
+  double sum;
+};
+
+summary sum_regex(std::string const &text) {
+  static std::regex const number("-?([0-9]+[.]?[0-9]*|[.][0-9]+)"
+                                 "([eE][-+]?[0-9]+)?");
+  summary answer{0, 0};
+  for (std::sregex_iterator it(text.begin(), text.end(), number), end;
+       it != end; ++it) {
+    char const *const first = text.data() + it->position();
+    double x;
+    if (fast_float::from_chars(first, first + it->length(), x).ec !=
+        std::errc()) {
+      printf("bug in sum_regex\n");
+      std::abort();
+    }
+    answer.sum += x;
+    ++answer.count;
+  }
+  return answer;
+}
+
+bool is_digit(char const *p, char const *end) {
+  return p != end && *p >= '0' && *p <= '9';
+}
+
+summary sum_loop(std::string const &text) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  summary answer{0, 0};
+  while (p != end) {
+    if (is_digit(p, end) ||
+        ((*p == '-' || *p == '.') && is_digit(p + 1, end)) ||
+        (*p == '-' && p[1] == '.' && is_digit(p + 2, end))) {
+      double x;
+      auto const r = fast_float::from_chars(p, end, x);
+      if (r.ec == std::errc()) {
+        answer.sum += x;
+        ++answer.count;
+        p = r.ptr;
+        continue;
+      }
+    }
+    ++p;
+  }
+  return answer;
+}
+
+summary sum_extract(std::string const &text,
+                    std::vector<fast_float::extracted_number> &numbers,
+                    fast_float::number_boundary const boundary) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  summary answer{0, 0};
+  while (true) {
+    auto const r = fast_float::extract_numbers(
+        p, end, numbers.data(), numbers.size(),
+        fast_float::extract_options(boundary, false));
+    if (r.ec != std::errc()) {
+      printf("bug in sum_extract\n");
+      std::abort();
+    }
+    for (size_t i = 0; i < r.count; ++i) {
+      answer.sum += numbers[i].decimal;
+    }
+    answer.count += r.count;
+    if (r.ptr == end) {
+      return answer;
+    }
+    p = r.ptr;
+  }
+}
+
+void run(char const *title, std::string const &text) {
+  std::vector<fast_float::extracted_number> numbers(256);
+  summary const expected = sum_loop(text);
+  summary const regex = sum_regex(text);
+  summary const extracted =
+      sum_extract(text, numbers, fast_float::number_boundary::none);
+  if (regex.count != expected.count || regex.sum != expected.sum ||
+      extracted.count != expected.count || extracted.sum != expected.sum) {
+    printf("Validation failed for %s\n", title);
+    std::abort();
+  }
+  printf("# %s, %zu numbers\n", title, expected.count);
+  volatile double sink = 0;
+  pretty_print(expected.count, text.size(), "std::regex",
+               counters::bench([&]() { sink = sink + sum_regex(text).sum; }));
+  pretty_print(expected.count, text.size(), "from_chars at every candidate",
+               counters::bench([&]() { sink = sink + sum_loop(text).sum; }));
+  pretty_print(expected.count, text.size(), "extract_numbers, boundary none",
+               counters::bench([&]() {
+                 sink = sink + sum_extract(text, numbers,
+                                           fast_float::number_boundary::none)
+                                   .sum;
+               }));
+  pretty_print(expected.count, text.size(), "extract_numbers, boundary start",
+               counters::bench([&]() {
+                 sink = sink + sum_extract(text, numbers,
+                                           fast_float::number_boundary::start)
+                                   .sum;
+               }));
+  pretty_print(expected.count, text.size(), "extract_numbers, boundary word",
+               counters::bench([&]() {
+                 sink = sink + sum_extract(text, numbers,
+                                           fast_float::number_boundary::word)
+                                   .sum;
+               }));
+}
+
+int main() {
+  std::mt19937_64 rng(50);
+  std::uniform_real_distribution<double> dis(0, 1000);
+  size_t const lines = 20000;
+  std::string dense;
+  std::string sparse;
+  char buffer[256];
+  for (size_t i = 0; i < lines; ++i) {
+    snprintf(buffer, sizeof(buffer),
+             "2024-10-19T12:%02d:%02d INFO request id=%llu took %.1fms, %d "
+             "retries, size=%d user=u%d latency=%.3fs status=200\n",
+             int(i / 60 % 60), int(i % 60),
+             static_cast<unsigned long long>(rng() >> 20), dis(rng),
+             int(rng() % 4), int(rng() % 65536), int(rng() % 10000),
+             dis(rng) / 1000);
+    dense += buffer;
+    snprintf(buffer, sizeof(buffer),
+             "WARN upstream connection reset by peer while reading the "
+             "response headers from the backend, retrying in %.1f seconds "
+             "(attempt %d)\n",
+             dis(rng) / 100, int(rng() % 8));
+    sparse += buffer;
+  }
+  run("log lines, 13 numbers each", dense);
+  run("log lines, 2 numbers each", sparse);
+  return EXIT_SUCCESS;
+}
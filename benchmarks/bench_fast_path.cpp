@@ -0,0 +1,193 @@
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// Every number is followed by a '\0' so that strtod can parse it in place.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+template <typename Generate> dataset make_dataset(size_t n, Generate gen) {
+  dataset data;
+  for (size_t i = 0; i < n; ++i) {
+    char buf[64];
+    gen(buf, sizeof(buf));
+    data.buffer.append(buf);
+    data.buffer.push_back('\0');
+  }
+  data.count = n;
+  return data;
+}
+
+// Which path from_chars takes for a double, following the conditions of
+// clinger_fast_path_impl when rounding to nearest.
+enum path { clinger, larger_exponent, smaller_exponent, slow, path_count };
+
+char const *path_names[] = {"Clinger's fast path", "exponent above 22",
+                            "exponent below -22 (fma)", "compute_float"};
+
+path classify(char const *p, char const *pend) {
+  using format = fast_float::binary_format<double>;
+  auto const pns = fast_float::parse_number_string<false, char>(
+      p, pend, fast_float::parse_options(), false);
+  auto const mantissa = pns.mantissa;
+  auto const exponent = pns.exponent;
+  if (pns.too_many_digits || mantissa > format::max_mantissa_fast_path()) {
+    return slow;
+  }
+  if (format::min_exponent_fast_path() <= exponent &&
+      exponent <= format::max_exponent_fast_path()) {
+    return clinger;
+  }
+  if (mantissa == 0) {
+    return slow;
+  }
+  if (exponent > format::max_exponent_fast_path()) {
+    auto const shift = static_cast<fast_float::am_pow_t>(
+        exponent - format::max_exponent_fast_path());
+    return shift <= format::max_exponent_fast_path() &&
+                   mantissa <= (format::max_mantissa_fast_path(shift) >> shift)
+               ? larger_exponent
+               : slow;
+  }
+#ifdef FASTFLOAT_HAS_FAST_FMA
+  double value;
+  if (fast_float::detail::negative_power_fast_path(mantissa, exponent,
+                                                   value)) {
+    return smaller_exponent;
+  }
+#endif
+  return slow;
+}
+
+void validate(dataset const &data) {
+  char const *p = data.buffer.data();
+  size_t counts[path_count] = {};
+  for (size_t i = 0; i < data.count; ++i) {
+    size_t const length = std::strlen(p);
+    double value;
+    auto r = fast_float::from_chars(p, p + length, value);
+    double const expected = std::strtod(p, nullptr);
+    if (r.ptr != p + length || std::memcmp(&value, &expected, 8) != 0) {
+      printf("Validation failed for %s\n", p);
+      std::abort();
+    }
+    ++counts[classify(p, p + length)];
+    p += length + 1;
+  }
+  for (size_t i = 0; i < path_count; ++i) {
+    printf("#   %-28s %6.2f%%\n", path_names[i],
+           100.0 * double(counts[i]) / double(data.count));
+  }
+}
+
+void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  validate(data);
+  volatile double sink = 0;
+  pretty_print(data.count, data.buffer.size(), "fastfloat from_chars",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char const *pend = p + std::strlen(p);
+                   double value;
+                   auto r = fast_float::from_chars(p, pend, value);
+                   if (r.ptr != pend)
+                     std::abort();
+                   sum += value;
+                   p = pend + 1;
+                 }
+                 sink = sink + sum;
+               }));
+  pretty_print(data.count, data.buffer.size(), "strtod",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char *end;
+                   double const value = std::strtod(p, &end);
+                   if (end == p)
+                     std::abort();
+                   sum += value;
+                   p = end + 1;
+                 }
+                 sink = sink + sum;
+               }));
+}
+
+int main() {
+#ifndef FASTFLOAT_HAS_FAST_FMA
+  printf("# no fast fused multiply-add: exponents below -22 take the slow "
+         "path (try -march=native)\n");
+#endif
+  constexpr size_t N = 200000;
+  std::mt19937_64 rng(1234);
+
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     // a mantissa of 4 to 8 digits, exponents -40 to 40
+                     int const digits = 4 + int(rng() % 5);
+                     double const mantissa =
+                         1 + double(rng() % 9000000) / 1000000;
+                     snprintf(buf, size, "%.*e", digits - 1,
+                              mantissa * std::pow(10.0, int(rng() % 81) - 40));
+                   }),
+      "scientific notation, 4 to 8 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     // e.g. a particle physics export, 1e-35 to 1e-25
+                     snprintf(buf, size, "%.6e",
+                              std::pow(10.0, -35 + double(rng() % 10000) /
+                                                       1000));
+                   }),
+      "small magnitudes, 7 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     // e.g. 123456e25: an integer with a large exponent
+                     snprintf(buf, size, "%llue%d",
+                              static_cast<unsigned long long>(rng() % 1000000),
+                              23 + int(rng() % 10));
+                   }),
+      "integers with large exponents");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     double value;
+                     do {
+                       uint64_t const bits = rng();
+                       std::memcpy(&value, &bits, sizeof(value));
+                     } while (!std::isfinite(value));
+                     snprintf(buf, size, "%.17g", value);
+                   }),
+      "full exponent range, 17 digits");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+// A CSV text of 100000 numbers, indexed with a field_index_t, then edited a
+// character at a time or extended a line at a time. An update parses the
+// fields it touches, so it costs about as much as parsing one or a few
+// fields, plus shifting the fields after it when the length changes.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+int main() {
+  std::mt19937_64 rng(47);
+  std::uniform_real_distribution<double> dis(0, 1000);
+  size_t const count = 100000;
+  std::string text;
+  char buffer[64];
+  for (size_t i = 0; i < count; ++i) {
+    snprintf(buffer, sizeof(buffer), "%.3f%c", dis(rng),
+             i % 10 == 9 ? '\n' : ',');
+    text += buffer;
+  }
+  std::string const line = text.substr(0, text.find('\n') + 1);
+  size_t const lines = 1000;
+  std::vector<fast_float::indexed_field_t<double>> fields(count + lines * 10);
+  fast_float::field_index_t<double> index(fields.data(), fields.size());
+  // the digits to edit, which stay digits
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < 1000; ++i) {
+    size_t offset = rng() % text.size();
+    while (text[offset] < '0' || text[offset] > '9') {
+      ++offset;
+    }
+    offsets.push_back(offset);
+  }
+  pretty_print(count, text.size(), "build", counters::bench([&]() {
+                 index.build(text.data(), text.data() + text.size());
+               }));
+  pretty_print(offsets.size(), offsets.size(), "replace a digit",
+               counters::bench([&]() {
+                 for (size_t offset : offsets) {
+                   text[offset] = char('0' + (text[offset] - '0' + 1) % 10);
+                   index.replace(text.data(), text.data() + text.size(),
+                                 offset, 1, 1);
+                 }
+               }));
+  // The fields between an edit and the next one are shifted: edits in the
+  // order of the text shift each field once.
+  std::vector<size_t> sorted = offsets;
+  std::sort(sorted.begin(), sorted.end());
+  pretty_print(2 * sorted.size(), 2 * sorted.size(),
+               "(the edits of the text alone)", counters::bench([&]() {
+                 for (size_t offset : sorted) {
+                   text.insert(offset, 1, '1');
+                   text.erase(offset, 1);
+                 }
+               }));
+  pretty_print(2 * sorted.size(), 2 * sorted.size(),
+               "insert and remove a digit, in order", counters::bench([&]() {
+                 for (size_t offset : sorted) {
+                   text.insert(offset, 1, '1');
+                   index.replace(text.data(), text.data() + text.size(),
+                                 offset, 0, 1);
+                   text.erase(offset, 1);
+                   index.replace(text.data(), text.data() + text.size(),
+                                 offset, 1, 0);
+                 }
+               }));
+  size_t const size = text.size();
+  text.reserve(size + lines * line.size());
+  pretty_print(lines, lines * line.size(), "append a line",
+               counters::bench([&]() {
+                 for (size_t i = 0; i < lines; ++i) {
+                   text += line;
+                   index.append(text.data(), text.data() + text.size());
+                 }
+                 // back to the text before the lines
+                 text.resize(size);
+                 index.replace(text.data(), text.data() + text.size(), size,
+                               lines * line.size(), 0);
+               }));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// float to binary16, rounding to nearest with ties to even
+uint16_t float_to_float16(float f) {
+#ifdef __F16C__
+  return static_cast<uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  uint32_t const sign = (x >> 16) & 0x8000;
+  x &= 0x7fffffff;
+  if (x >= 0x7f800000) { // inf or nan
+    return static_cast<uint16_t>(sign | 0x7c00 | (x > 0x7f800000 ? 0x200 : 0));
+  }
+  if (x >= 0x477ff000) { // rounds to inf
+    return static_cast<uint16_t>(sign | 0x7c00);
+  }
+  if (x < 0x38800000) { // subnormal or zero
+    float magic;
+    uint32_t const magic_bits = 0x3f000000; // 0.5: aligns the subnormal ulp
+    std::memcpy(&magic, &magic_bits, sizeof(magic));
+    float value;
+    std::memcpy(&value, &x, sizeof(value));
+    value += magic;
+    std::memcpy(&x, &value, sizeof(x));
+    return static_cast<uint16_t>(sign | (x - magic_bits));
+  }
+  uint32_t const odd = (x >> 13) & 1;
+  x += 0xc8000fff + odd; // rebias the exponent and round
+  return static_cast<uint16_t>(sign | (x >> 13));
+#endif
+}
+
+// float to bfloat16, rounding to nearest with ties to even (no nan inputs)
+uint16_t float_to_bfloat16(float f) {
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  return static_cast<uint16_t>((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+}
+
+// Rows of comma-separated features, like a CSV file of model inputs.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+dataset make_dataset(size_t rows, size_t columns, char const *format,
+                     double low, double high) {
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> dist(low, high);
+  dataset data;
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < columns; ++c) {
+      char buf[64];
+      snprintf(buf, sizeof(buf), format, dist(rng));
+      data.buffer.append(buf);
+      data.buffer.push_back(c + 1 < columns ? ',' : '\n');
+    }
+  }
+  data.count = rows * columns;
+  return data;
+}
+
+template <typename Convert>
+size_t parse_via_float(dataset const &data, std::vector<uint16_t> &out,
+                       Convert convert) {
+  char const *p = data.buffer.data();
+  char const *pend = p + data.buffer.size();
+  size_t n = 0;
+  while (p != pend) {
+    float value;
+    auto r = fast_float::from_chars(p, pend, value);
+    if (r.ec != std::errc()) {
+      std::abort();
+    }
+    out[n++] = convert(value);
+    p = r.ptr + 1; // the separator or the end of the line
+  }
+  return n;
+}
+
+template <typename Parse>
+size_t parse_bulk(dataset const &data, std::vector<uint16_t> &out,
+                  Parse parse) {
+  char const *p = data.buffer.data();
+  char const *pend = p + data.buffer.size();
+  size_t n = 0;
+  while (p != pend) {
+    auto r = parse(p, pend, out.data() + n, out.size() - n);
+    if (r.ec != std::errc()) {
+      std::abort();
+    }
+    n += r.count;
+    p = r.ptr + 1; // the end of the line
+  }
+  return n;
+}
+
+void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  std::vector<uint16_t> expected(data.count), out(data.count);
+  auto const to_float16 = [](char const *first, char const *last,
+                             uint16_t *values, size_t count) {
+    return fast_float::from_chars_float16(first, last, values, count);
+  };
+  auto const to_bfloat16 = [](char const *first, char const *last,
+                              uint16_t *values, size_t count) {
+    return fast_float::from_chars_bfloat16(first, last, values, count);
+  };
+
+  // Rounding to float first may round twice: report how often it differs.
+  parse_via_float(data, expected, float_to_float16);
+  parse_bulk(data, out, to_float16);
+  size_t differ = 0;
+  for (size_t i = 0; i < data.count; ++i) {
+    differ += expected[i] != out[i];
+  }
+  printf("# float16: %zu values differ from float then convert\n", differ);
+
+  volatile size_t sink = 0;
+#ifdef __F16C__
+  std::string const float16_baseline = "float then F16C float16";
+#else
+  std::string const float16_baseline = "float then convert float16";
+#endif
+  pretty_print(data.count, data.buffer.size(), float16_baseline,
+               counters::bench([&]() {
+                 sink = sink + parse_via_float(data, out, float_to_float16);
+               }));
+  pretty_print(data.count, data.buffer.size(), "fastfloat from_chars_float16",
+               counters::bench([&]() {
+                 sink = sink + parse_bulk(data, out, to_float16);
+               }));
+  pretty_print(data.count, data.buffer.size(), "float then convert bfloat16",
+               counters::bench([&]() {
+                 sink = sink + parse_via_float(data, out, float_to_bfloat16);
+               }));
+  pretty_print(data.count, data.buffer.size(), "fastfloat from_chars_bfloat16",
+               counters::bench([&]() {
+                 sink = sink + parse_bulk(data, out, to_bfloat16);
+               }));
+}
+
+int main() {
+  constexpr size_t rows = 10000;
+  constexpr size_t columns = 32;
+  run(make_dataset(rows, columns, "%.4f", -1, 1),
+      "normalized features, 4 decimals");
+  run(make_dataset(rows, columns, "%.0f", 0, 255), "pixel intensities");
+  run(make_dataset(rows, columns, "%.6g", -1000, 1000),
+      "wide features, 6 digits");
+  return EXIT_SUCCESS;
+}
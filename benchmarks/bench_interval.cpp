@@ -0,0 +1,167 @@
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// Every number is followed by a '\0' so that strtod can parse it in place.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+template <typename Generate> dataset make_dataset(size_t n, Generate gen) {
+  dataset data;
+  for (size_t i = 0; i < n; ++i) {
+    char buf[64];
+    gen(buf, sizeof(buf));
+    data.buffer.append(buf);
+    data.buffer.push_back('\0');
+  }
+  data.count = n;
+  return data;
+}
+
+// The classic way: parse twice with the rounding mode switched. strtod follows
+// the rounding mode with glibc, but not with every C library.
+void strtod_interval(char const *p, char **end, double &lo, double &hi) {
+  std::fesetround(FE_DOWNWARD);
+  lo = std::strtod(p, end);
+  std::fesetround(FE_UPWARD);
+  hi = std::strtod(p, end);
+  std::fesetround(FE_TONEAREST);
+}
+
+void validate(dataset const &data) {
+#ifdef __GLIBC__
+  char const *p = data.buffer.data();
+  for (size_t i = 0; i < data.count; ++i) {
+    size_t const length = std::strlen(p);
+    double expected_lo, expected_hi, lo, hi;
+    strtod_interval(p, nullptr, expected_lo, expected_hi);
+    auto r = fast_float::from_chars_interval(p, p + length, lo, hi);
+    if (r.ptr != p + length || lo != expected_lo || hi != expected_hi ||
+        r.exact != (expected_lo == expected_hi)) {
+      printf("Validation failed for %s\n", p);
+      std::abort();
+    }
+    p += length + 1;
+  }
+#else
+  static_cast<void>(data);
+#endif
+}
+
+void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  validate(data);
+  volatile double sink = 0;
+  pretty_print(data.count, data.buffer.size(), "fastfloat from_chars (nearest)",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char const *pend = p + std::strlen(p);
+                   double value;
+                   auto r = fast_float::from_chars(p, pend, value);
+                   if (r.ptr != pend)
+                     std::abort();
+                   sum += value;
+                   p = pend + 1;
+                 }
+                 sink = sink + sum;
+               }));
+  pretty_print(data.count, data.buffer.size(), "strtod, fesetround twice",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char *end;
+                   double lo, hi;
+                   strtod_interval(p, &end, lo, hi);
+                   if (end == p)
+                     std::abort();
+                   sum += hi - lo;
+                   p = end + 1;
+                 }
+                 sink = sink + sum;
+               }));
+  pretty_print(data.count, data.buffer.size(), "fastfloat from_chars_interval",
+               counters::bench([&]() {
+                 double sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char const *pend = p + std::strlen(p);
+                   double lo, hi;
+                   auto r = fast_float::from_chars_interval(p, pend, lo, hi);
+                   if (r.ptr != pend)
+                     std::abort();
+                   sum += hi - lo;
+                   p = pend + 1;
+                 }
+                 sink = sink + sum;
+               }));
+}
+
+int main() {
+  constexpr size_t N = 200000;
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+  std::uniform_real_distribution<double> measure_dist(-1000, 1000);
+
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     snprintf(buf, size, "%.17g", unit_dist(rng));
+                   }),
+      "unit interval, 17 digits");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     snprintf(buf, size, "%.3f", measure_dist(rng));
+                   }),
+      "measurements, 3 decimals");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     // mostly exact: multiples of 1/1024
+                     snprintf(buf, size, "%.10g",
+                              double(rng() % 10000000) / 1024);
+                   }),
+      "binary fractions");
+  run(make_dataset(N,
+                   [&](char *buf, size_t size) {
+                     double value;
+                     do {
+                       uint64_t const bits = rng();
+                       std::memcpy(&value, &bits, sizeof(value));
+                     } while (!std::isfinite(value));
+                     snprintf(buf, size, "%.17g", value);
+                   }),
+      "full exponent range, 17 digits");
+  return EXIT_SUCCESS;
+}
@@ -2,6 +2,7 @@
 // #define FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
 // #define FASTFLOAT_ONLY_ROUNDS_TO_NEAREST_SUPPORTED
 // #define FASTFLOAT_ISNOT_CHECKED_BOUNDS
+// #define FASTFLOAT_TRUSTED_INPUT
 
 #include "counters/bench.h"
 #include "fast_float/fast_float.h"
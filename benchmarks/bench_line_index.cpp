@@ -0,0 +1,132 @@
+// A CSV text of a million rows of ten numbers, from which a range of rows of
+// one column is parsed: by scanning the text from the start, or from a
+// line_index_t. The index is built in one pass, or in parts by threads.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+void in_threads(size_t const count, std::function<void(size_t)> const &job) {
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < count; ++i) {
+    threads.emplace_back(job, i);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+// The rows [row, row + count) of the column, from the start of the text.
+double sum_scan(std::string const &text, size_t row, size_t count,
+                size_t column) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  for (size_t i = 0; i < row; ++i) {
+    p = static_cast<char const *>(std::memchr(p, '\n', size_t(end - p))) + 1;
+  }
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t c = 0; c < column; ++c) {
+      p = static_cast<char const *>(std::memchr(p, ',', size_t(end - p))) + 1;
+    }
+    double x;
+    auto const r = fast_float::from_chars(p, end, x);
+    if (r.ec != std::errc()) {
+      printf("bug in sum_scan\n");
+      std::abort();
+    }
+    answer += x;
+    p = static_cast<char const *>(
+            std::memchr(r.ptr, '\n', size_t(end - r.ptr))) +
+        1;
+  }
+  return answer;
+}
+
+double sum_index(fast_float::line_index_t<char> const &index,
+                 std::string const &text, size_t row, size_t count,
+                 size_t column, std::vector<double> &values) {
+  auto const r = index.parse_column(text.data(), text.data() + text.size(),
+                                    row, count, column, values.data());
+  if (r.ec != std::errc() || r.count != count) {
+    printf("bug in sum_index\n");
+    std::abort();
+  }
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    answer += values[i];
+  }
+  return answer;
+}
+
+int main() {
+  std::mt19937_64 rng(48);
+  std::uniform_real_distribution<double> dis(0, 1000);
+  size_t const rows = 1000000;
+  std::string text;
+  char buffer[64];
+  for (size_t i = 0; i < rows * 10; ++i) {
+    snprintf(buffer, sizeof(buffer), "%.3f%c", dis(rng),
+             i % 10 == 9 ? '\n' : ',');
+    text += buffer;
+  }
+  std::vector<uint64_t> starts(rows / 1024 + 1);
+  fast_float::line_index_t<char> index(starts.data(), starts.size());
+  size_t const threads =
+      std::thread::hardware_concurrency() == 0
+          ? 1
+          : size_t(std::thread::hardware_concurrency());
+  printf("# %zu rows, %zu bytes, %zu threads\n", rows, text.size(), threads);
+  pretty_print(rows, text.size(), "build, one pass", counters::bench([&]() {
+                 index.build(text.data(), text.data() + text.size());
+               }));
+  pretty_print(rows, text.size(), "build, in parts", counters::bench([&]() {
+                 index.build(text.data(), text.data() + text.size(), threads,
+                             in_threads);
+               }));
+  size_t const row = rows / 2;
+  size_t const count = 10000;
+  std::vector<double> values(count);
+  if (sum_scan(text, row, count, 7) !=
+      sum_index(index, text, row, count, 7, values)) {
+    printf("Validation failed\n");
+    std::abort();
+  }
+  volatile double sink = 0;
+  pretty_print(count, text.size() / 100, "column 7, scan from the start",
+               counters::bench([&]() {
+                 sink = sink + sum_scan(text, row, count, 7);
+               }));
+  pretty_print(count, text.size() / 100, "column 7, from the index",
+               counters::bench([&]() {
+                 sink = sink + sum_index(index, text, row, count, 7, values);
+               }));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// strtof128 is the glibc parser for _Float128 (ISO/IEC TS 18661-3).
+#if defined(__SIZEOF_FLOAT128__) && defined(__GLIBC__) &&                     \
+    defined(__HAVE_FLOAT128) && defined(__GLIBC_USE)
+#if __HAVE_FLOAT128 && __GLIBC_USE(IEC_60559_TYPES_EXT)
+#define BENCH_HAS_STRTOF128 1
+#endif
+#endif
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+// Every number is followed by a '\0' so that the strto* functions can parse
+// it in place.
+struct dataset {
+  std::string buffer;
+  size_t count = 0;
+};
+
+// the x87 80-bit format has padding bytes
+template <typename T> constexpr size_t value_bytes() {
+  return std::is_same<T, long double>::value && LDBL_MANT_DIG == 64
+             ? 10
+             : sizeof(T);
+}
+
+template <typename T>
+void validate(dataset const &data, T (*reference)(char const *, char **)) {
+  char const *p = data.buffer.data();
+  for (size_t i = 0; i < data.count; ++i) {
+    size_t const length = std::strlen(p);
+    T expected = reference(p, nullptr);
+    T value;
+    auto r = fast_float::from_chars(p, p + length, value);
+    if (r.ec != std::errc() || r.ptr != p + length ||
+        std::memcmp(&value, &expected, value_bytes<T>()) != 0) {
+      printf("Validation failed for %s\n", p);
+      std::abort();
+    }
+    p += length + 1;
+  }
+}
+
+template <typename T>
+void bench_fast_float(dataset const &data, std::string name) {
+  volatile T sink = 0;
+  pretty_print(data.count, data.buffer.size(), name, counters::bench([&]() {
+                 T sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char const *pend = p + std::strlen(p);
+                   T value;
+                   auto r = fast_float::from_chars(p, pend, value);
+                   if (r.ec != std::errc())
+                     std::abort();
+                   sum += value;
+                   p = pend + 1;
+                 }
+                 sink = sink + sum;
+               }));
+}
+
+template <typename T>
+void bench_strto(dataset const &data, std::string name,
+                 T (*parse)(char const *, char **)) {
+  volatile T sink = 0;
+  pretty_print(data.count, data.buffer.size(), name, counters::bench([&]() {
+                 T sum = 0;
+                 char const *p = data.buffer.data();
+                 for (size_t i = 0; i < data.count; ++i) {
+                   char *end;
+                   sum += parse(p, &end);
+                   if (end == p)
+                     std::abort();
+                   p = end + 1;
+                 }
+                 sink = sink + sum;
+               }));
+}
+
+void run(dataset const &data, std::string name) {
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), data.count,
+         data.buffer.size());
+  validate<long double>(data, std::strtold);
+  bench_strto<long double>(data, "strtold", std::strtold);
+  bench_fast_float<long double>(data, "fastfloat long double");
+#ifdef BENCH_HAS_STRTOF128
+  __float128 (*reference)(char const *, char **) =
+      [](char const *p, char **end) -> __float128 { return strtof128(p, end); };
+  validate<__float128>(data, reference);
+  bench_strto<__float128>(data, "strtof128", reference);
+  bench_fast_float<__float128>(data, "fastfloat __float128");
+#endif
+}
+
+int main() {
+  constexpr size_t N = 200000;
+  std::mt19937_64 rng(1234);
+
+  // numbers in [0,1) with 17 significant digits, as printed from doubles
+  dataset unit;
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+  for (size_t i = 0; i < N; ++i) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.17g", unit_dist(rng));
+    unit.buffer.append(buf);
+    unit.buffer.push_back('\0');
+  }
+  unit.count = N;
+
+  // long doubles over the whole exponent range, printed with 21 digits
+  dataset wide;
+  std::uniform_int_distribution<int> exponent_dist(LDBL_MIN_10_EXP + 20,
+                                                  LDBL_MAX_10_EXP - 1);
+  for (size_t i = 0; i < N; ++i) {
+    char buf[64];
+    long double const value =
+        (1 + (long double)(rng() >> 11) / 9007199254740992.0L) *
+        std::pow(10.0L, (long double)exponent_dist(rng));
+    snprintf(buf, sizeof(buf), "%.21Lg", value);
+    wide.buffer.append(buf);
+    wide.buffer.push_back('\0');
+  }
+  wide.count = N;
+
+  run(unit, "unit interval, 17 digits");
+  run(wide, "full exponent range, 21 digits");
+  return EXIT_SUCCESS;
+}
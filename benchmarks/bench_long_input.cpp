@@ -0,0 +1,68 @@
+// Adversarially long numbers: megabytes of digits or of zeros in one token.
+// The cost per byte must not grow with the length of the token.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+void pretty_print(size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-44s : ", name.c_str());
+  printf(" %6.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %6.3f ns/b ", agg.fastest_elapsed_ns() / bytes);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %6.3f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %6.3f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+void run(std::string const &token, std::string name) {
+  double expected = std::strtod(token.c_str(), nullptr);
+  double value;
+  auto const r =
+      fast_float::from_chars(token.data(), token.data() + token.size(), value);
+  if (r.ptr != token.data() + token.size() ||
+      std::memcmp(&value, &expected, sizeof(value))) {
+    printf("Validation failed for %s\n", name.c_str());
+    std::abort();
+  }
+  volatile double sink = 0;
+  pretty_print(token.size(), name, counters::bench([&]() {
+                 double v;
+                 fast_float::from_chars(token.data(),
+                                        token.data() + token.size(), v);
+                 sink = sink + v;
+               }));
+}
+
+int main() {
+  std::mt19937_64 rng(41);
+  for (size_t size : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 20,
+                      size_t(1) << 24}) {
+    std::string digits(size, '0');
+    for (char &c : digits) {
+      c = char('0' + rng() % 10);
+    }
+    digits[0] = '7';
+    std::string const zeros(size, '0');
+    std::string const label = std::to_string(size >> 10) + " KB";
+    printf("# %s tokens\n", label.c_str());
+    run(digits, "digits");
+    run("3." + digits, "3.digits");
+    run("0." + zeros + "1", "0.zeros1");
+    run(zeros + "1.5", "zeros1.5");
+    // A halfway point between two doubles, decided by the last digit.
+    run("9007199254740993" + zeros + "1", "9007199254740993zeros1");
+  }
+  return EXIT_SUCCESS;
+}
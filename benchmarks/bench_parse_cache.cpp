@@ -0,0 +1,110 @@
+// Inputs which repeat a set of distinct values, as tick data repeats its
+// price levels, parsed with from_chars and through a parse_cache_t. The cache
+// wins while the values fit in it and the tokens take long enough to parse.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+template <typename T>
+double sum_from_chars(std::string const &text, size_t count) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    T x;
+    auto const r = fast_float::from_chars(p, end, x);
+    if (r.ec != std::errc()) {
+      printf("bug in sum_from_chars\n");
+      std::abort();
+    }
+    answer += double(x);
+    p = r.ptr + 1;
+  }
+  return answer;
+}
+
+template <typename T, typename Cache>
+double sum_cache(Cache &cache, std::string const &text, size_t count) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    T x;
+    auto const r = cache.parse(p, end, x);
+    if (r.ec != std::errc()) {
+      printf("bug in sum_cache\n");
+      std::abort();
+    }
+    answer += double(x);
+    p = r.ptr + 1;
+  }
+  return answer;
+}
+
+template <typename T>
+void run(char const *format, double scale, size_t distinct) {
+  std::mt19937_64 rng(46);
+  std::uniform_real_distribution<double> dis(0, scale);
+  std::vector<std::string> values;
+  char buffer[64];
+  for (size_t i = 0; i < distinct; ++i) {
+    snprintf(buffer, sizeof(buffer), format, dis(rng));
+    values.push_back(buffer);
+  }
+  size_t const count = 100000;
+  std::string text;
+  for (size_t i = 0; i < count; ++i) {
+    text += values[rng() % distinct];
+    text += '\n';
+  }
+  double const expected = sum_from_chars<T>(text, count);
+  fast_float::parse_cache_t<T> cache;
+  if (sum_cache<T>(cache, text, count) != expected) {
+    printf("Validation failed for %s\n", format);
+    std::abort();
+  }
+  printf("# %s, %zu distinct values, %.1f%% hits\n", format, distinct,
+         100.0 * double(cache.hits()) / double(cache.hits() + cache.misses()));
+  volatile double sink = 0;
+  pretty_print(count, text.size(), "from_chars", counters::bench([&]() {
+                 sink = sink + sum_from_chars<T>(text, count);
+               }));
+  pretty_print(count, text.size(), "parse_cache_t (1024 slots)",
+               counters::bench([&]() {
+                 sink = sink + sum_cache<T>(cache, text, count);
+               }));
+}
+
+int main() {
+  for (size_t distinct : {16, 256, 1024, 4096, 100000}) {
+    run<double>("%.2f", 10000, distinct);  // price levels
+    run<double>("%.6e", 1, distinct);      // longer tokens
+    run<int64_t>("%.0f", 1000, distinct);  // status codes
+  }
+  return EXIT_SUCCESS;
+}
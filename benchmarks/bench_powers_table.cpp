@@ -0,0 +1,202 @@
+// Build twice, with and without FASTFLOAT_COMPACT_POWERS_TABLE, to compare
+// the full and the compact tables of powers of five. Floats are parsed with
+// float_powers in both builds.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#define BENCH_HAS_RDTSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define BENCH_HAS_RDTSC 1
+#endif
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+struct memory_range {
+  void const *data;
+  size_t size;
+};
+
+// The tables that compute_float reads.
+template <typename T> std::vector<memory_range> table_ranges() {
+  if (std::is_same<T, float>::value) {
+    return {{fast_float::float_powers::power_of_five_high,
+             sizeof(fast_float::float_powers::power_of_five_high)},
+            {fast_float::float_powers::power_of_five_low,
+             sizeof(fast_float::float_powers::power_of_five_low)}};
+  }
+#ifdef FASTFLOAT_COMPACT_POWERS_TABLE
+  return {{fast_float::compact_powers::power_of_five_128,
+           sizeof(fast_float::compact_powers::power_of_five_128)},
+          {fast_float::compact_powers::small_power_of_five,
+           sizeof(fast_float::compact_powers::small_power_of_five)},
+          {fast_float::compact_powers::correction,
+           sizeof(fast_float::compact_powers::correction)}};
+#else
+  return {{fast_float::powers::power_of_five_128,
+           sizeof(fast_float::powers::power_of_five_128)}};
+#endif
+}
+
+// Our own data: every parse is preceded by reads of 32 new cache lines from a
+// 16 MB buffer, like a scan of the input or of some other structure. Lines of
+// the table that are not used by nearly every parse are pushed out of L1 and
+// L2 before they are used again.
+struct competing_data {
+  std::vector<uint8_t> buffer = std::vector<uint8_t>(16 * 1024 * 1024, 1);
+  size_t next = 0;
+  uint8_t sum = 0;
+
+  void touch() {
+    for (size_t i = 0; i < 32; ++i) {
+      sum = uint8_t(sum + buffer[next]);
+      next = (next + 64) % buffer.size();
+    }
+  }
+};
+
+void evict(std::vector<memory_range> const &ranges) {
+#ifdef BENCH_HAS_RDTSC
+  for (auto const &range : ranges) {
+    char const *p = static_cast<char const *>(range.data);
+    for (size_t i = 0; i < range.size; i += 64) {
+      _mm_clflush(p + i);
+    }
+  }
+  _mm_mfence();
+#else
+  static_cast<void>(ranges);
+#endif
+}
+
+template <typename T>
+void run(std::vector<std::string> const &lines, std::string const &name) {
+  size_t bytes = 0;
+  for (auto const &line : lines) {
+    bytes += line.size();
+  }
+  printf("# %s: %zu numbers, %zu bytes\n", name.c_str(), lines.size(), bytes);
+  volatile double sink = 0;
+  pretty_print(lines.size(), bytes, "from_chars, warm table",
+               counters::bench([&]() {
+                 double sum = 0;
+                 for (auto const &line : lines) {
+                   T value;
+                   auto r = fast_float::from_chars(
+                       line.data(), line.data() + line.size(), value);
+                   if (r.ec != std::errc())
+                     std::abort();
+                   sum += value;
+                 }
+                 sink = sink + sum;
+               }));
+#ifdef BENCH_HAS_RDTSC
+  // Each parse is timed on its own, so that what happens in between is not
+  // counted.
+  auto const latency = [&](char const *label, std::function<void()> between) {
+    std::vector<uint64_t> cycles;
+    cycles.reserve(lines.size());
+    double sum = 0;
+    for (auto const &line : lines) {
+      between();
+      _mm_lfence();
+      uint64_t const start = __rdtsc();
+      _mm_lfence();
+      T value;
+      fast_float::from_chars(line.data(), line.data() + line.size(), value);
+      sum += value;
+      _mm_lfence();
+      cycles.push_back(__rdtsc() - start);
+    }
+    sink = sink + sum;
+    std::sort(cycles.begin(), cycles.end());
+    printf("%-40s :  median %5llu cycles, 90th percentile %5llu cycles\n",
+           label, static_cast<unsigned long long>(cycles[cycles.size() / 2]),
+           static_cast<unsigned long long>(cycles[cycles.size() * 9 / 10]));
+  };
+  latency("one parse, warm table", []() {});
+  competing_data other;
+  latency("one parse, competing data", [&]() { other.touch(); });
+  sink = sink + other.sum;
+  std::vector<memory_range> const ranges = table_ranges<T>();
+  latency("one parse, table flushed", [&]() { evict(ranges); });
+#endif
+}
+
+int main() {
+  size_t table_bytes = 0;
+  for (auto const &range : table_ranges<double>()) {
+    table_bytes += range.size;
+  }
+#ifdef FASTFLOAT_COMPACT_POWERS_TABLE
+  printf("# compact table of powers of five: %zu bytes\n", table_bytes);
+#else
+  printf("# full table of powers of five: %zu bytes\n", table_bytes);
+#endif
+  printf("# float table of powers of five: %zu + %zu bytes\n",
+         sizeof(fast_float::float_powers::power_of_five_high),
+         sizeof(fast_float::float_powers::power_of_five_low));
+  constexpr size_t N = 20000;
+  std::mt19937_64 rng(1234);
+  std::vector<std::string> lines;
+  char buf[64];
+  for (size_t i = 0; i < N; ++i) {
+    double value;
+    do {
+      uint64_t const bits = rng();
+      std::memcpy(&value, &bits, sizeof(value));
+    } while (!std::isfinite(value));
+    snprintf(buf, sizeof(buf), "%.17g", value);
+    lines.emplace_back(buf);
+  }
+  run<double>(lines, "full exponent range, 17 digits");
+  lines.clear();
+  std::uniform_real_distribution<double> unit_dist(0, 1);
+  for (size_t i = 0; i < N; ++i) {
+    snprintf(buf, sizeof(buf), "%.17g", unit_dist(rng));
+    lines.emplace_back(buf);
+  }
+  run<double>(lines, "unit interval, 17 digits");
+  lines.clear();
+  for (size_t i = 0; i < N; ++i) {
+    float value;
+    do {
+      uint32_t const bits = uint32_t(rng());
+      std::memcpy(&value, &bits, sizeof(value));
+    } while (!std::isfinite(value));
+    snprintf(buf, sizeof(buf), "%.9g", double(value));
+    lines.emplace_back(buf);
+  }
+  run<float>(lines, "float, full exponent range, 9 digits");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+// A CSV text of 40 columns, of which 2 are wanted: every field is parsed with
+// from_chars, or the fields are found one by one with memchr and the 2 parsed,
+// or from_chars_columns scans past the other fields 16 chars at a time.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+size_t const columns = 40;
+size_t const wanted[] = {3, 27};
+
+double sum_all(std::string const &text, size_t rows) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t c = 0; c < columns; ++c) {
+      double x;
+      auto const r = fast_float::from_chars(p, end, x);
+      if (r.ec != std::errc()) {
+        printf("bug in sum_all\n");
+        std::abort();
+      }
+      if (c == wanted[0] || c == wanted[1]) {
+        answer += x;
+      }
+      p = r.ptr + 1;
+    }
+  }
+  return answer;
+}
+
+double sum_memchr(std::string const &text, size_t rows) {
+  char const *p = text.data();
+  char const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t c = 0; c < columns; ++c) {
+      char const *const next = static_cast<char const *>(
+          std::memchr(p, c + 1 == columns ? '\n' : ',', size_t(end - p)));
+      if (c == wanted[0] || c == wanted[1]) {
+        double x;
+        if (fast_float::from_chars(p, next, x).ec != std::errc()) {
+          printf("bug in sum_memchr\n");
+          std::abort();
+        }
+        answer += x;
+      }
+      p = next + 1;
+    }
+  }
+  return answer;
+}
+
+double sum_projection(std::string const &text, size_t rows,
+                      std::vector<double> &a, std::vector<double> &b) {
+  double *const outputs[] = {a.data(), b.data()};
+  auto const r = fast_float::from_chars_columns(
+      text.data(), text.data() + text.size(), wanted, 2, outputs, rows);
+  if (r.ec != std::errc() || r.count != rows) {
+    printf("bug in sum_projection\n");
+    std::abort();
+  }
+  double answer = 0;
+  for (size_t i = 0; i < rows; ++i) {
+    answer += a[i];
+    answer += b[i];
+  }
+  return answer;
+}
+
+void run(char const *format) {
+  std::mt19937_64 rng(49);
+  std::uniform_real_distribution<double> dis(0, 1000);
+  size_t const rows = 20000;
+  std::string text;
+  char buffer[64];
+  for (size_t i = 0; i < rows * columns; ++i) {
+    snprintf(buffer, sizeof(buffer), format, dis(rng));
+    text += buffer;
+    text += (i % columns == columns - 1) ? '\n' : ',';
+  }
+  std::vector<double> a(rows);
+  std::vector<double> b(rows);
+  double const expected = sum_all(text, rows);
+  if (sum_memchr(text, rows) != expected ||
+      sum_projection(text, rows, a, b) != expected) {
+    printf("Validation failed for %s\n", format);
+    std::abort();
+  }
+  printf("# %s, %zu rows of %zu columns, 2 wanted\n", format, rows, columns);
+  volatile double sink = 0;
+  pretty_print(2 * rows, text.size(), "from_chars, every field",
+               counters::bench([&]() { sink = sink + sum_all(text, rows); }));
+  pretty_print(2 * rows, text.size(), "memchr, 2 fields parsed",
+               counters::bench([&]() {
+                 sink = sink + sum_memchr(text, rows);
+               }));
+  pretty_print(2 * rows, text.size(), "from_chars_columns",
+               counters::bench([&]() {
+                 sink = sink + sum_projection(text, rows, a, b);
+               }));
+}
+
+int main() {
+  run("%.2f");
+  run("%.17g");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+// Column-aligned rows, as Fortran-style programs print them: every number is
+// right-aligned in a wide field and parsed with skip_white_space.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+template <typename CharT>
+double sum_columns(std::basic_string<CharT> const &text, size_t count) {
+  fast_float::parse_options_t<CharT> const options{
+      fast_float::chars_format::general |
+      fast_float::chars_format::skip_white_space};
+  CharT const *p = text.data();
+  CharT const *const end = p + text.size();
+  double answer = 0;
+  for (size_t i = 0; i < count; ++i) {
+    double x;
+    auto const r = fast_float::from_chars_advanced(p, end, x, options);
+    if (r.ec != std::errc()) {
+      printf("bug in sum_columns\n");
+      std::abort();
+    }
+    answer += x;
+    p = r.ptr;
+  }
+  return answer;
+}
+
+template <typename CharT>
+void run(std::string const &text, size_t count, std::string name,
+         double expected) {
+  // this is okay, all chars are ASCII
+  std::basic_string<CharT> const wide(text.begin(), text.end());
+  if (sum_columns(wide, count) != expected) {
+    printf("Validation failed for %s\n", name.c_str());
+    std::abort();
+  }
+  volatile double sink = 0;
+  pretty_print(
+      count, text.size() * sizeof(CharT), name,
+      counters::bench([&]() { sink = sink + sum_columns(wide, count); }));
+}
+
+int main() {
+  std::mt19937_64 rng(43);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  size_t const count = 100000;
+  // field widths from the default formats of list-directed Fortran output
+  for (int width : {0, 8, 16, 24, 40}) {
+    std::string text;
+    char buffer[64];
+    for (size_t i = 0; i < count; ++i) {
+      snprintf(buffer, sizeof(buffer), "%*.9g", width, dis(rng));
+      text += buffer;
+      text += (i % 6 == 5) ? '\n' : ' ';
+    }
+    printf("# width %d: %zu bytes as char\n", width, text.size());
+    double const expected = sum_columns(text, count);
+    run<char>(text, count, "char", expected);
+    run<char16_t>(text, count, "char16_t (UTF-16)", expected);
+    run<char32_t>(text, count, "char32_t (UTF-32)", expected);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+// The realbenchmark data sets in UTF-16, UTF-32 and wchar_t, next to char,
+// to compare the wide code unit kernels with the char ones.
+#include "counters/bench.h"
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+void pretty_print(size_t volume, size_t bytes, std::string name,
+                  counters::event_aggregate agg) {
+  if (agg.inner_count > 1) {
+    printf("# (inner count: %d)\n", agg.inner_count);
+  }
+  printf("%-40s : ", name.c_str());
+  printf(" %5.2f GB/s ", bytes / agg.fastest_elapsed_ns());
+  printf(" %5.1f Mfloat/s ", volume * 1000.0 / agg.fastest_elapsed_ns());
+  printf(" %5.2f ns/f ", agg.fastest_elapsed_ns() / volume);
+  if (counters::event_collector().has_events()) {
+    printf(" %5.2f GHz ", agg.fastest_cycles() / agg.fastest_elapsed_ns());
+    printf(" %5.2f c/f ", agg.fastest_cycles() / volume);
+    printf(" %5.2f i/f ", agg.fastest_instructions() / volume);
+    printf(" %5.2f c/b ", agg.fastest_cycles() / bytes);
+    printf(" %5.2f i/b ", agg.fastest_instructions() / bytes);
+    printf(" %5.2f i/c ", agg.fastest_instructions() / agg.fastest_cycles());
+  }
+  printf("\n");
+}
+
+template <typename CharT>
+double findmax(std::vector<std::basic_string<CharT>> const &lines) {
+  double answer = 0;
+  for (auto const &line : lines) {
+    double x;
+    auto const r =
+        fast_float::from_chars(line.data(), line.data() + line.size(), x);
+    if (r.ptr == line.data()) {
+      printf("bug in findmax\n");
+      std::abort();
+    }
+    answer = answer > x ? answer : x;
+  }
+  return answer;
+}
+
+template <typename CharT>
+void run(std::vector<std::string> const &lines, size_t volume,
+         std::string name, double expected) {
+  // this is okay, all chars are ASCII
+  std::vector<std::basic_string<CharT>> wide;
+  wide.reserve(lines.size());
+  for (auto const &line : lines) {
+    wide.emplace_back(line.begin(), line.end());
+  }
+  if (findmax(wide) != expected) {
+    printf("Validation failed for %s\n", name.c_str());
+    std::abort();
+  }
+  volatile double sink = 0;
+  pretty_print(lines.size(), volume * sizeof(CharT), name,
+               counters::bench([&]() { sink = sink + findmax(wide); }));
+}
+
+void fileload(std::string const &filename) {
+  std::ifstream inputfile(filename);
+  if (!inputfile) {
+    printf("can't open %s\n", filename.c_str());
+    return;
+  }
+  std::string line;
+  std::vector<std::string> lines;
+  size_t volume = 0;
+  while (getline(inputfile, line)) {
+    volume += line.size();
+    lines.emplace_back(line);
+  }
+  printf("# %s: %zu lines, %zu bytes as char\n", filename.c_str(),
+         lines.size(), volume);
+  double const expected = findmax(lines);
+  run<char>(lines, volume, "char", expected);
+  run<char16_t>(lines, volume, "char16_t (UTF-16)", expected);
+  run<char32_t>(lines, volume, "char32_t (UTF-32)", expected);
+  run<wchar_t>(lines, volume,
+               sizeof(wchar_t) == 2 ? "wchar_t (UTF-16)" : "wchar_t (UTF-32)",
+               expected);
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    fileload(argv[1]);
+    return EXIT_SUCCESS;
+  }
+  fileload(std::string(BENCHMARK_DATA_DIR) + "/canada.txt");
+  fileload(std::string(BENCHMARK_DATA_DIR) + "/canada_short.txt");
+  fileload(std::string(BENCHMARK_DATA_DIR) + "/mesh.txt");
+  return EXIT_SUCCESS;
+}
@@ -2,6 +2,7 @@
 #define FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
 #define FASTFLOAT_ONLY_ROUNDS_TO_NEAREST_SUPPORTED
 #define FASTFLOAT_ISNOT_CHECKED_BOUNDS
+// #define FASTFLOAT_TRUSTED_INPUT
 
 #if defined(__linux__) || (__APPLE__ && __aarch64__)
 #define USING_COUNTERS
@@ -243,6 +244,9 @@ int main(int argc, char **argv) {
 #ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
   std::cout << "# FASTFLOAT_ISNOT_CHECKED_BOUNDS is enabled" << std::endl;
 #endif
+#ifdef FASTFLOAT_TRUSTED_INPUT
+  std::cout << "# FASTFLOAT_TRUSTED_INPUT is enabled" << std::endl;
+#endif
 #ifdef USING_COUNTERS
   if (collector.has_events()) {
     std::cout << "# Using hardware counters" << std::endl;
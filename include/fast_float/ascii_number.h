@@ -20,8 +20,9 @@ namespace fast_float {
 
 template <typename UC>
 fastfloat_really_inline FASTFLOAT_CONSTEVAL bool has_simd_opt() noexcept {
-#ifdef FASTFLOAT_USE_SIMD
-  return std::is_same<UC, char16_t>::value;
+#if FASTFLOAT_USE_SIMD
+  return std::is_same<UC, char16_t>::value ||
+         std::is_same<UC, char32_t>::value || std::is_same<UC, wchar_t>::value;
 #else
   return false;
 #endif
@@ -104,13 +105,42 @@ fastfloat_really_inline uint64_t simd_read8(__m128i const data) {
 #endif
 }
 
-fastfloat_really_inline uint64_t simd_read8(char16_t const *chars) {
+// Loads 8 UTF-16 code units into the 16-bit lanes.
+fastfloat_really_inline __m128i simd_load8(char16_t const *chars) noexcept {
   FASTFLOAT_SIMD_DISABLE_WARNINGS
   // unaligned SIMD instruction -> all fine.
-  return simd_read8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(chars)));
+  return _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
   FASTFLOAT_SIMD_RESTORE_WARNINGS
 }
 
+// Loads 8 UTF-32 code units into the 16-bit lanes. The narrowing saturates,
+// so a code unit above 0xFFFF can't alias a digit.
+fastfloat_really_inline __m128i simd_load8(char32_t const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m128i const lo = _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
+  __m128i const hi =
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars + 4));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+#if FASTFLOAT_X86_SIMD >= 41
+  return _mm_packus_epi32(lo, hi);
+#else
+  // SSE2 only saturates signed: a negative wchar_t becomes 0x8000.
+  return _mm_packs_epi32(lo, hi);
+#endif
+}
+
+// Branchless "are all digits?" trick from Lemire:
+// (x - '0') <= 9  <=> (x + 32720) <= 32729
+// encoded as signed comparison: (x + 32720) > -32759 ? not digit : digit
+// http://0x80.pl/articles/simd-parsing-int-sequences.html
+fastfloat_really_inline bool simd_is_8_digits(__m128i const data) noexcept {
+  __m128i const t0 = _mm_add_epi16(data, _mm_set1_epi16(32720));
+  __m128i const mask = _mm_cmpgt_epi16(t0, _mm_set1_epi16(-32759));
+  return _mm_movemask_epi8(mask) == 0;
+}
+
+using simd_u16x8 = __m128i;
+
 #elif FASTFLOAT_ARM_NEON
 
 fastfloat_really_inline uint64_t simd_read8(uint16x8_t const &data) {
@@ -118,30 +148,72 @@ fastfloat_really_inline uint64_t simd_read8(uint16x8_t const &data) {
   return vget_lane_u64(vreinterpret_u64_u8(utf8_packed), 0);
 }
 
-fastfloat_really_inline uint64_t simd_read8(char16_t const *chars) {
+fastfloat_really_inline uint16x8_t simd_load8(char16_t const *chars) noexcept {
   FASTFLOAT_SIMD_DISABLE_WARNINGS
-  return simd_read8(vld1q_u16(reinterpret_cast<uint16_t const *>(chars)));
+  return vld1q_u16(reinterpret_cast<uint16_t const *>(chars));
   FASTFLOAT_SIMD_RESTORE_WARNINGS
 }
 
+// The narrowing saturates, so a code unit above 0xFFFF can't alias a digit.
+fastfloat_really_inline uint16x8_t simd_load8(char32_t const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  uint32_t const *const units = reinterpret_cast<uint32_t const *>(chars);
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  return vcombine_u16(vqmovn_u32(vld1q_u32(units)),
+                      vqmovn_u32(vld1q_u32(units + 4)));
+}
+
+// (x - '0') <= 9
+// http://0x80.pl/articles/simd-parsing-int-sequences.html
+fastfloat_really_inline bool simd_is_8_digits(uint16x8_t const data) noexcept {
+  uint16x8_t const t0 = vsubq_u16(data, vmovq_n_u16('0'));
+  uint16x8_t const mask = vcltq_u16(t0, vmovq_n_u16('9' - '0' + 1));
+  return vminvq_u16(mask) == 0xFFFF;
+}
+
+using simd_u16x8 = uint16x8_t;
+
 #endif // FASTFLOAT_X86_SIMD
 
-#endif
+// wchar_t holds UTF-16 on Windows and UTF-32 elsewhere.
+fastfloat_really_inline simd_u16x8 simd_load8(wchar_t const *chars) noexcept {
+  using unit =
+      std::conditional<sizeof(wchar_t) == 2, char16_t, char32_t>::type;
+  return simd_load8(reinterpret_cast<unit const *>(chars));
+}
+
+// dummy for compile
+template <typename UC> simd_u16x8 simd_load8(UC const *) {
+  return simd_u16x8();
+}
 
-// MSVC SFINAE is broken pre-VS2017
-#if defined(_MSC_VER) && _MSC_VER <= 1900
 template <typename UC>
+fastfloat_really_inline uint64_t simd_read8(UC const *chars) noexcept {
+  return simd_read8(simd_load8(chars));
+}
+
 #else
-template <typename UC, FASTFLOAT_ENABLE_IF(!has_simd_opt<UC>()) = 0>
-#endif
+
 // dummy for compile
-uint64_t simd_read8(UC const *) {
-  return 0;
+template <typename UC> uint64_t simd_read8(UC const *) { return 0; }
+
+#endif
+
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 uint32_t
+parse_4_digits(uint32_t val) noexcept {
+  val -= 0x30303030;
+  val = (val * 10) + (val >> 8);
+  return (((val & 0x00FF00FF) * 0x00640001) >> 16) & 0xFFFF;
 }
 
 // credit  @aqrit
 fastfloat_really_inline FASTFLOAT_CONSTEXPR14 uint32_t
 parse_8_digits(uint64_t val) noexcept {
+#ifdef FASTFLOAT_32BIT
+  // 64-bit multiplications are emulated: two halves of 4 digits are cheaper.
+  return parse_4_digits(static_cast<uint32_t>(val)) * 10000 +
+         parse_4_digits(static_cast<uint32_t>(val >> 32));
+#else
   uint64_t const mask = 0x000000FF000000FF;
   uint64_t const mul1 = 0x000F424000000064; // 100 + (1000000ULL << 32)
   uint64_t const mul2 = 0x0000271000000001; // 1 + (10000ULL << 32)
@@ -149,6 +221,7 @@ parse_8_digits(uint64_t val) noexcept {
   val = (val * 10) + (val >> 8); // val = (val * 2561) >> 8;
   val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
   return static_cast<uint32_t>(val);
+#endif
 }
 
 // Call this if chars are definitely 8 digits.
@@ -174,11 +247,537 @@ is_made_of_4_digits(uint32_t val) noexcept {
   return !((((val + 0x46464646) | (val - 0x30303030)) & 0x80808080));
 }
 
-fastfloat_really_inline FASTFLOAT_CONSTEXPR14 uint32_t
-parse_4_digits(uint32_t val) noexcept {
-  val -= 0x30303030;
-  val = (val * 10) + (val >> 8);
-  return (((val & 0x00FF00FF) * 0x00640001) >> 16) & 0xFFFF;
+// Long runs of zeros are skipped one vector at a time, so that a hostile
+// megabyte-long number costs a small constant per byte.
+#if FASTFLOAT_USE_SIMD
+
+#if FASTFLOAT_X86_SIMD >= 52
+
+constexpr static size_t simd_run_bytes = 32;
+
+template <typename UC>
+fastfloat_really_inline bool simd_is_zeros(UC const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m256i const data =
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  __m256i const zeros = (sizeof(UC) == 1)   ? _mm256_set1_epi8('0')
+                        : (sizeof(UC) == 2) ? _mm256_set1_epi16('0')
+                                            : _mm256_set1_epi32('0');
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(data, zeros)) == -1;
+}
+
+#elif FASTFLOAT_X86_SIMD
+
+constexpr static size_t simd_run_bytes = 16;
+
+template <typename UC>
+fastfloat_really_inline bool simd_is_zeros(UC const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  __m128i const zeros = (sizeof(UC) == 1)   ? _mm_set1_epi8('0')
+                        : (sizeof(UC) == 2) ? _mm_set1_epi16('0')
+                                            : _mm_set1_epi32('0');
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(data, zeros)) == 0xFFFF;
+}
+
+#elif FASTFLOAT_ARM_NEON
+
+constexpr static size_t simd_run_bytes = 16;
+
+template <typename UC>
+fastfloat_really_inline bool simd_is_zeros(UC const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  uint8x16_t const data = vld1q_u8(reinterpret_cast<uint8_t const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  uint8x16_t const zeros =
+      vreinterpretq_u8_u64(vdupq_n_u64(int_cmp_zeros<UC>()));
+  return vminvq_u8(vceqq_u8(data, zeros)) == 0xFF;
+}
+
+#endif // FASTFLOAT_X86_SIMD
+
+#endif
+
+// Returns the end of the run of '0' which starts at p.
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR20 UC const *skip_zero_digits(UC const *p,
+                                                        UC const *pend) noexcept {
+  if (!is_constant_evaluated()) {
+#if FASTFLOAT_USE_SIMD
+    constexpr auto step = static_cast<int>(simd_run_bytes / sizeof(UC));
+    while (std::distance(p, pend) >= step && simd_is_zeros(p)) {
+      p += step;
+    }
+#endif
+    while (std::distance(p, pend) >= int_cmp_len<UC>()) {
+      uint64_t val;
+      std::memcpy(&val, p, sizeof(uint64_t));
+      if (val != int_cmp_zeros<UC>()) {
+        break;
+      }
+      p += int_cmp_len<UC>();
+    }
+  }
+  while ((p != pend) && (*p == UC('0'))) {
+    ++p;
+  }
+  return p;
+}
+
+// Leading white space is skipped one vector at a time too: column-aligned
+// files pad every number with ten or more spaces. A field is rarely wider than
+// 32 bytes, so 16-byte vectors are tried even when AVX2 is available.
+#if FASTFLOAT_USE_SIMD
+
+#if FASTFLOAT_X86_SIMD
+
+// Returns the offset in bytes of the first code unit which is not one of
+// " \t\n\v\f\r", or 16. The comparisons are as wide as the code unit, so a
+// wide unit whose low byte is a space is not one.
+template <typename UC>
+fastfloat_really_inline size_t simd_space_prefix(UC const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  __m128i const blank =
+      (sizeof(UC) == 1)   ? _mm_cmpeq_epi8(data, _mm_set1_epi8(' '))
+      : (sizeof(UC) == 2) ? _mm_cmpeq_epi16(data, _mm_set1_epi16(' '))
+                          : _mm_cmpeq_epi32(data, _mm_set1_epi32(' '));
+  // (x - '\t') <= 4 unsigned, as a signed comparison after a bias
+  __m128i const control =
+      (sizeof(UC) == 1)
+          ? _mm_cmplt_epi8(_mm_add_epi8(data, _mm_set1_epi8(0x77)),
+                           _mm_set1_epi8(-128 + 5))
+      : (sizeof(UC) == 2)
+          ? _mm_cmplt_epi16(_mm_add_epi16(data, _mm_set1_epi16(0x7FF7)),
+                            _mm_set1_epi16(-32768 + 5))
+          : _mm_cmplt_epi32(_mm_add_epi32(data, _mm_set1_epi32(0x7FFFFFF7)),
+                            _mm_set1_epi32(INT32_MIN + 5));
+  // bit 16 stops the count when all 16 bytes are white space
+  return countr_zero_32(
+      ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(blank, control))));
+}
+
+#if FASTFLOAT_X86_SIMD >= 52
+
+// Returns the offset in bytes of the first code unit which is not one of
+// " \t\n\v\f\r", or 32. The comparisons are as wide as the code unit, so a
+// wide unit whose low byte is a space is not one.
+template <typename UC>
+fastfloat_really_inline size_t simd_space_prefix32(UC const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m256i const data =
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  __m256i const blank =
+      (sizeof(UC) == 1)   ? _mm256_cmpeq_epi8(data, _mm256_set1_epi8(' '))
+      : (sizeof(UC) == 2) ? _mm256_cmpeq_epi16(data, _mm256_set1_epi16(' '))
+                          : _mm256_cmpeq_epi32(data, _mm256_set1_epi32(' '));
+  // (x - '\t') <= 4 unsigned, as a signed comparison after a bias
+  __m256i const control =
+      (sizeof(UC) == 1)
+          ? _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 5),
+                              _mm256_add_epi8(data, _mm256_set1_epi8(0x77)))
+      : (sizeof(UC) == 2)
+          ? _mm256_cmpgt_epi16(
+                _mm256_set1_epi16(-32768 + 5),
+                _mm256_add_epi16(data, _mm256_set1_epi16(0x7FF7)))
+          : _mm256_cmpgt_epi32(
+                _mm256_set1_epi32(INT32_MIN + 5),
+                _mm256_add_epi32(data, _mm256_set1_epi32(0x7FFFFFF7)));
+  return countr_zero_32(~static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_or_si256(blank, control))));
+}
+
+#endif
+
+#elif FASTFLOAT_ARM_NEON
+
+// Returns the offset in bytes of the first code unit which is not one of
+// " \t\n\v\f\r", or 16. The comparisons are as wide as the code unit, so a
+// wide unit whose low byte is a space is not one.
+template <typename UC>
+fastfloat_really_inline size_t simd_space_prefix(UC const *chars) noexcept {
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  uint8_t const *const bytes = reinterpret_cast<uint8_t const *>(chars);
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  uint8x16_t other;
+  if (sizeof(UC) == 1) {
+    uint8x16_t const data = vld1q_u8(bytes);
+    other = vmvnq_u8(
+        vorrq_u8(vceqq_u8(data, vdupq_n_u8(' ')),
+                 vcltq_u8(vsubq_u8(data, vdupq_n_u8('\t')), vdupq_n_u8(5))));
+  } else if (sizeof(UC) == 2) {
+    uint16x8_t const data = vreinterpretq_u16_u8(vld1q_u8(bytes));
+    other = vmvnq_u8(vreinterpretq_u8_u16(vorrq_u16(
+        vceqq_u16(data, vdupq_n_u16(' ')),
+        vcltq_u16(vsubq_u16(data, vdupq_n_u16('\t')), vdupq_n_u16(5)))));
+  } else {
+    uint32x4_t const data = vreinterpretq_u32_u8(vld1q_u8(bytes));
+    other = vmvnq_u8(vreinterpretq_u8_u32(vorrq_u32(
+        vceqq_u32(data, vdupq_n_u32(' ')),
+        vcltq_u32(vsubq_u32(data, vdupq_n_u32('\t')), vdupq_n_u32(5)))));
+  }
+  // one nibble per byte, as NEON has no movemask
+  uint64_t const nibbles = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(other), 4)), 0);
+  uint32_t const lo = static_cast<uint32_t>(nibbles);
+  return (lo ? countr_zero_32(lo)
+             : 32 + countr_zero_32(static_cast<uint32_t>(nibbles >> 32))) >>
+         2;
+}
+
+#endif // FASTFLOAT_X86_SIMD
+
+#endif
+
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+
+// Returns the end of the white space which starts at p, as is_space sees it.
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR20 UC const *
+skip_spaces(UC const *p, UC const *pend) noexcept {
+  // most numbers have no leading white space at all
+  if ((p == pend) || !is_space(*p)) {
+    return p;
+  }
+#if FASTFLOAT_USE_SIMD
+  if (!is_constant_evaluated()) {
+#if FASTFLOAT_X86_SIMD >= 52
+    constexpr auto wide_step = static_cast<int>(32 / sizeof(UC));
+    while (std::distance(p, pend) >= wide_step) {
+      size_t const prefix = simd_space_prefix32(p);
+      if (prefix != 32) {
+        return p + prefix / sizeof(UC);
+      }
+      p += wide_step;
+    }
+#endif
+    constexpr auto step = static_cast<int>(16 / sizeof(UC));
+    while (std::distance(p, pend) >= step) {
+      size_t const prefix = simd_space_prefix(p);
+      if (prefix != 16) {
+        return p + prefix / sizeof(UC);
+      }
+      p += step;
+    }
+  }
+#endif
+  while ((p != pend) && is_space(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+#endif
+
+// The characters which may continue a decimal number: the digits, '.', the
+// decimal point, 'e', 'E', '+' and '-'. A run of them ends every token that
+// from_chars can accept, whatever the format, Fortran aside.
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 bool
+is_number_char(char const c, char const decimal_point) noexcept {
+  return is_integer(c) || c == '.' || c == decimal_point ||
+         (c | 0x20) == 'e' || c == '+' || c == '-';
+}
+
+// Returns the length of the run of number characters at the start of the 16
+// chars at `chars`, or 16.
+fastfloat_really_inline size_t number_run16(char const *chars,
+                                            char const decimal_point) noexcept {
+#if FASTFLOAT_X86_SIMD
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  // (x - '0') <= 9 unsigned, as a signed comparison after a bias
+  __m128i const digit =
+      _mm_cmplt_epi8(_mm_add_epi8(data, _mm_set1_epi8(0x50)),
+                     _mm_set1_epi8(-128 + 10));
+  __m128i const exponent = _mm_cmpeq_epi8(
+      _mm_or_si128(data, _mm_set1_epi8(0x20)), _mm_set1_epi8('e'));
+  __m128i const point =
+      _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('.')),
+                   _mm_cmpeq_epi8(data, _mm_set1_epi8(decimal_point)));
+  __m128i const sign = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('+')),
+                                    _mm_cmpeq_epi8(data, _mm_set1_epi8('-')));
+  // bit 16 stops the count when all 16 chars are number characters
+  return countr_zero_32(~static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_or_si128(_mm_or_si128(digit, exponent), _mm_or_si128(point, sign)))));
+#elif FASTFLOAT_ARM_NEON
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  uint8x16_t const data = vld1q_u8(reinterpret_cast<uint8_t const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  uint8x16_t const digit =
+      vcltq_u8(vsubq_u8(data, vdupq_n_u8('0')), vdupq_n_u8(10));
+  uint8x16_t const exponent =
+      vceqq_u8(vorrq_u8(data, vdupq_n_u8(0x20)), vdupq_n_u8('e'));
+  uint8x16_t const point =
+      vorrq_u8(vceqq_u8(data, vdupq_n_u8('.')),
+               vceqq_u8(data, vdupq_n_u8(uint8_t(decimal_point))));
+  uint8x16_t const sign = vorrq_u8(vceqq_u8(data, vdupq_n_u8('+')),
+                                   vceqq_u8(data, vdupq_n_u8('-')));
+  uint8x16_t const other = vmvnq_u8(
+      vorrq_u8(vorrq_u8(digit, exponent), vorrq_u8(point, sign)));
+  // one nibble per byte, as NEON has no movemask
+  uint64_t const nibbles = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(other), 4)), 0);
+  uint32_t const lo = static_cast<uint32_t>(nibbles);
+  return (lo ? countr_zero_32(lo)
+             : 32 + countr_zero_32(static_cast<uint32_t>(nibbles >> 32))) >>
+         2;
+#else
+  size_t length = 0;
+  while (length != 16 && is_number_char(chars[length], decimal_point)) {
+    ++length;
+  }
+  return length;
+#endif
+}
+
+#if FASTFLOAT_USE_SIMD
+
+// A mask of the chars of 16 which are a newline or the separator: bit i on
+// x86, bit 4 i + 3 on NEON, so that a set bit is a char in any case.
+#if FASTFLOAT_X86_SIMD
+constexpr int delimiter_mask_shift = 0;
+#elif FASTFLOAT_ARM_NEON
+constexpr int delimiter_mask_shift = 2;
+#endif
+
+fastfloat_really_inline uint64_t
+delimiter_mask16(char const *chars, char const separator) noexcept {
+#if FASTFLOAT_X86_SIMD
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  return static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\n')),
+                   _mm_cmpeq_epi8(data, _mm_set1_epi8(separator)))));
+#elif FASTFLOAT_ARM_NEON
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  uint8x16_t const data = vld1q_u8(reinterpret_cast<uint8_t const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  uint8x16_t const delimiter =
+      vorrq_u8(vceqq_u8(data, vdupq_n_u8('\n')),
+               vceqq_u8(data, vdupq_n_u8(uint8_t(separator))));
+  // one nibble per byte, as NEON has no movemask, and one bit per nibble
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(
+                           vreinterpretq_u16_u8(delimiter), 4)),
+                       0) &
+         0x8888888888888888;
+#endif
+}
+
+// The offset of the first char of a mask which is not zero.
+fastfloat_really_inline size_t
+delimiter_mask_first(uint64_t const mask) noexcept {
+  uint32_t const lo = static_cast<uint32_t>(mask);
+  return static_cast<size_t>(
+             lo ? countr_zero_32(lo)
+                : 32 + countr_zero_32(static_cast<uint32_t>(mask >> 32))) >>
+         delimiter_mask_shift;
+}
+
+// A mask of the digits of 16 chars, laid out as delimiter_mask16.
+fastfloat_really_inline uint64_t digit_mask16(char const *chars) noexcept {
+#if FASTFLOAT_X86_SIMD
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  // (x - '0') <= 9 unsigned, as a signed comparison after a bias
+  return static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_cmplt_epi8(_mm_add_epi8(data, _mm_set1_epi8(0x50)),
+                     _mm_set1_epi8(-128 + 10))));
+#elif FASTFLOAT_ARM_NEON
+  FASTFLOAT_SIMD_DISABLE_WARNINGS
+  uint8x16_t const data = vld1q_u8(reinterpret_cast<uint8_t const *>(chars));
+  FASTFLOAT_SIMD_RESTORE_WARNINGS
+  uint8x16_t const digit =
+      vcltq_u8(vsubq_u8(data, vdupq_n_u8('0')), vdupq_n_u8(10));
+  return vget_lane_u64(vreinterpret_u64_u8(
+                           vshrn_n_u16(vreinterpretq_u16_u8(digit), 4)),
+                       0) &
+         0x8888888888888888;
+#endif
+}
+
+#endif
+
+// Returns the first separator or newline of [p, pend), or pend.
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR14 UC const *
+find_delimiter(UC const *p, UC const *const pend, UC const separator) noexcept {
+  while (p != pend && *p != separator && *p != UC('\n')) {
+    ++p;
+  }
+  return p;
+}
+
+inline char const *find_delimiter(char const *p, char const *const pend,
+                                  char const separator) noexcept {
+#if FASTFLOAT_USE_SIMD
+  for (; pend - p >= 16; p += 16) {
+    uint64_t const mask = delimiter_mask16(p, separator);
+    if (mask != 0) {
+      return p + delimiter_mask_first(mask);
+    }
+  }
+#endif
+  while (p != pend && *p != separator && *p != '\n') {
+    ++p;
+  }
+  return p;
+}
+
+// Skips the next n newlines of [p, pend): returns the char after the n-th,
+// with n set to zero, or pend, with n set to the number of newlines missing.
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR14 UC const *
+skip_lines(UC const *p, UC const *const pend, uint64_t &n) noexcept {
+  for (; n != 0 && p != pend; ++p) {
+    if (*p == UC('\n') && --n == 0) {
+      return p + 1;
+    }
+  }
+  return p;
+}
+
+inline char const *skip_lines(char const *p, char const *const pend,
+                              uint64_t &n) noexcept {
+  if (n == 0) {
+    return p;
+  }
+#if FASTFLOAT_USE_SIMD
+  for (; pend - p >= 16; p += 16) {
+    uint64_t mask = delimiter_mask16(p, '\n');
+    uint64_t const count = popcount_64(mask);
+    if (count < n) {
+      n -= count;
+      continue;
+    }
+    for (; n != 1; --n) {
+      mask &= mask - 1;
+    }
+    n = 0;
+    return p + delimiter_mask_first(mask) + 1;
+  }
+#endif
+  for (; p != pend; ++p) {
+    if (*p == '\n' && --n == 0) {
+      return p + 1;
+    }
+  }
+  return p;
+}
+
+// Skips the next n separators of the line at p: returns the char after the
+// n-th, with n set to zero, or the newline or pend which ends the line first,
+// with n set to the number of separators missing.
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR14 UC const *
+skip_fields(UC const *p, UC const *const pend, UC const separator,
+            size_t &n) noexcept {
+  for (; n != 0 && p != pend && *p != UC('\n'); ++p) {
+    if (*p == separator && --n == 0) {
+      return p + 1;
+    }
+  }
+  return p;
+}
+
+inline char const *skip_fields(char const *p, char const *const pend,
+                               char const separator, size_t &n) noexcept {
+  if (n == 0) {
+    return p;
+  }
+#if FASTFLOAT_USE_SIMD
+  for (; pend - p >= 16; p += 16) {
+    uint64_t const newlines = delimiter_mask16(p, '\n');
+    uint64_t separators = delimiter_mask16(p, separator) & ~newlines;
+    if (newlines != 0) {
+      // the separators before the end of the line
+      separators &= (newlines & (0 - newlines)) - 1;
+    }
+    uint64_t const count = popcount_64(separators);
+    if (count >= n) {
+      for (; n != 1; --n) {
+        separators &= separators - 1;
+      }
+      n = 0;
+      return p + delimiter_mask_first(separators) + 1;
+    }
+    n -= size_t(count);
+    if (newlines != 0) {
+      return p + delimiter_mask_first(newlines);
+    }
+  }
+#endif
+  for (; p != pend && *p != '\n'; ++p) {
+    if (*p == separator && --n == 0) {
+      return p + 1;
+    }
+  }
+  return p;
+}
+
+// Tells if a number which ends at p fills its field: p is at the end of the
+// text, at a separator, or at a newline, "\r\n" included.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 bool
+is_field_end(UC const *const p, UC const *const pend,
+             UC const separator) noexcept {
+  return p == pend || *p == separator || *p == UC('\n') ||
+         (*p == UC('\r') && (p + 1 == pend || p[1] == UC('\n')));
+}
+
+// Returns the number of newlines of [p, pend).
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR14 uint64_t
+count_newlines(UC const *p, UC const *const pend) noexcept {
+  uint64_t count = 0;
+  for (; p != pend; ++p) {
+    count += (*p == UC('\n'));
+  }
+  return count;
+}
+
+inline uint64_t count_newlines(char const *p, char const *const pend) noexcept {
+  uint64_t count = 0;
+#if FASTFLOAT_USE_SIMD
+  for (; pend - p >= 16; p += 16) {
+    count += popcount_64(delimiter_mask16(p, '\n'));
+  }
+#endif
+  for (; p != pend; ++p) {
+    count += (*p == '\n');
+  }
+  return count;
+}
+
+// Returns the first digit of [p, pend), or pend.
+template <typename UC>
+inline FASTFLOAT_CONSTEXPR14 UC const *
+find_digit(UC const *p, UC const *const pend) noexcept {
+  while (p != pend && !is_integer(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+inline char const *find_digit(char const *p, char const *const pend) noexcept {
+#if FASTFLOAT_USE_SIMD
+  for (; pend - p >= 16; p += 16) {
+    uint64_t const mask = digit_mask16(p);
+    if (mask != 0) {
+      return p + delimiter_mask_first(mask);
+    }
+  }
+#endif
+  while (p != pend && !is_integer(*p)) {
+    ++p;
+  }
+  return p;
 }
 
 #if FASTFLOAT_USE_SIMD
@@ -266,12 +865,69 @@ fastfloat_really_inline uint64_t parse_16_digits(char const *p) noexcept {
   const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
   return convert_4x4_to_16_digits(parse_4x4_digits(data));
 }
+
+// 16 UTF-16 or UTF-32 code units, narrowed to bytes with saturation: a code
+// unit outside of the byte range stays outside of the digits.
+template <typename UC>
+fastfloat_really_inline __m128i simd_load16(UC const *chars) noexcept {
+  return _mm_packus_epi16(simd_load8(chars), simd_load8(chars + 8));
+}
+
+template <typename UC>
+fastfloat_really_inline bool simd_parse_if_16_digits(UC const *chars,
+                                                     uint64_t &value) noexcept {
+  __m128i const data = simd_load16(chars);
+  // Signed comparisons: the saturated bytes 0xFF are negative, below '0'.
+  __m128i const outside =
+      _mm_or_si128(_mm_cmplt_epi8(data, _mm_set1_epi8('0')),
+                   _mm_cmpgt_epi8(data, _mm_set1_epi8('9')));
+  if (_mm_movemask_epi8(outside) != 0) {
+    return false;
+  }
+  value = value * 10000000000000000ULL +
+          convert_4x4_to_16_digits(parse_4x4_digits(data));
+  return true;
+}
+
+// Call this if chars are definitely 16 digits.
+template <typename UC>
+fastfloat_really_inline uint64_t parse_16_digits(UC const *chars) noexcept {
+  return convert_4x4_to_16_digits(parse_4x4_digits(simd_load16(chars)));
+}
+#endif
+
+#endif // FASTFLOAT_X86_SIMD
+
+// Call this if chars might not be 8 digits.
+// Using this style (instead of is_made_of_8_digits() then
+// parse_8_digits()) ensures we don't load SIMD registers twice.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
+simd_parse_if_8_digits(UC const *chars, uint64_t &i) noexcept {
+  if (is_constant_evaluated()) {
+    return false;
+  }
+  simd_u16x8 const data = simd_load8(chars);
+  if (simd_is_8_digits(data)) {
+    i = i * 100000000 + parse_8_digits(simd_read8(data));
+    return true;
+  }
+  return false;
+}
+
+#else
+
+// dummy for compiler
+template <typename UC> bool simd_parse_if_8_digits(UC const *, uint64_t &) {
+  return false;
+}
+
 #endif
 
 // credit @hedgehoginthecpp
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
 parse_digits_until_19(char const *&p, char const *pend, am_mant_t &mantissa) {
-#if FASTFLOAT_X86_SIMD >= 31
+#if FASTFLOAT_USE_SIMD && FASTFLOAT_X86_SIMD >= 31
   if (!is_constant_evaluated()) {
     // If mantissa < 10^2, a 16-digit block is guaranteed < 10^18 - 1.
     while (std::distance(p, pend) >= 16 && mantissa < 100) {
@@ -305,89 +961,26 @@ template <typename UC, FASTFLOAT_ENABLE_IF(!std::is_same<UC, char>::value) = 0>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
 parse_digits_until_19(UC const *&p, UC const *pend,
                       am_mant_t &mantissa) noexcept {
-  do {
-    mantissa = mantissa * 10 + static_cast<uint8_t>(*p - UC('0'));
-  } while ((++p != pend) && (mantissa < minimal_nineteen_digit_integer));
-}
-#else
-template <typename UC>
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
-parse_digits_until_19(UC const *&p, UC const *pend,
-                      am_mant_t &mantissa) noexcept {
-  do {
-    mantissa = mantissa * 10 + static_cast<uint8_t>(*p - UC('0'));
-  } while ((++p != pend) && (mantissa < minimal_nineteen_digit_integer));
-}
+#if FASTFLOAT_USE_SIMD
+  if (!is_constant_evaluated() && has_simd_opt<UC>()) {
+#if FASTFLOAT_X86_SIMD >= 31
+    // If mantissa < 10^2, a 16-digit block is guaranteed < 10^18 - 1.
+    while (std::distance(p, pend) >= 16 && mantissa < 100) {
+      mantissa = mantissa * 10000000000000000ULL + parse_16_digits(p);
+      p += 16;
+    }
 #endif
-
-// Call this if chars might not be 8 digits.
-// Using this style (instead of is_made_of_8_digits() then
-// parse_8_digits()) ensures we don't load SIMD registers twice.
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
-simd_parse_if_8_digits(char16_t const *chars, uint64_t &i) noexcept {
-  if (is_constant_evaluated()) {
-    return false;
-  }
-#if FASTFLOAT_X86_SIMD
-  FASTFLOAT_SIMD_DISABLE_WARNINGS
-  // Load 8 UTF-16 characters (16 bytes)
-  // unaligned SIMD instruction -> all fine.
-  __m128i const data =
-      _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars));
-  FASTFLOAT_SIMD_RESTORE_WARNINGS
-
-  // Branchless "are all digits?" trick from Lemire:
-  // (x - '0') <= 9  <=> (x + 32720) <= 32729
-  // encoded as signed comparison: (x + 32720) > -32759 ? not digit : digit
-  // http://0x80.pl/articles/simd-parsing-int-sequences.html
-  __m128i const t0 = _mm_add_epi16(data, _mm_set1_epi16(32720));
-  __m128i const mask = _mm_cmpgt_epi16(t0, _mm_set1_epi16(-32759));
-
-  // If mask == 0 → all digits valid.
-  if (_mm_movemask_epi8(mask) == 0) {
-    i = i * 100000000 + parse_8_digits(simd_read8(data));
-    return true;
-  }
-#elif FASTFLOAT_ARM_NEON
-  FASTFLOAT_SIMD_DISABLE_WARNINGS
-  uint16x8_t const data = vld1q_u16(reinterpret_cast<uint16_t const *>(chars));
-  FASTFLOAT_SIMD_RESTORE_WARNINGS
-
-  // (x - '0') <= 9
-  // http://0x80.pl/articles/simd-parsing-int-sequences.html
-  uint16x8_t const t0 = vsubq_u16(data, vmovq_n_u16('0'));
-  uint16x8_t const mask = vcltq_u16(t0, vmovq_n_u16('9' - '0' + 1));
-
-  if (vminvq_u16(mask) == 0xFFFF) {
-    i = i * 100000000 + parse_8_digits(simd_read8(data));
-    return true;
+    // If mantissa < 10^10, a 8-digit block is guaranteed < 10^18 - 1.
+    while (std::distance(p, pend) >= 8 && mantissa < 10000000000ULL) {
+      mantissa = mantissa * 100000000ULL + parse_8_digits(p);
+      p += 8;
+    }
   }
-#else
-  (void)chars;
-  (void)i;
 #endif
-  return false;
-}
-#else
-template <typename UC>
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
-parse_digits_until_19(UC const *&p, UC const *pend,
-                      am_mant_t &mantissa) noexcept {
-  do {
+  while (p != pend && mantissa < minimal_nineteen_digit_integer) {
     mantissa = mantissa * 10 + static_cast<uint8_t>(*p - UC('0'));
-  } while ((++p != pend) && (mantissa < minimal_nineteen_digit_integer));
-}
-#endif
-
-// MSVC SFINAE is broken pre-VS2017
-#if defined(_MSC_VER) && _MSC_VER <= 1900
-template <typename UC>
-#else
-template <typename UC, FASTFLOAT_ENABLE_IF(!has_simd_opt<UC>()) = 0>
-#endif
-// dummy for compiler
-bool simd_parse_if_8_digits(UC const *, uint64_t &) {
-  return false;
+    ++p;
+  }
 }
 
 template <typename UC, FASTFLOAT_ENABLE_IF(!std::is_same<UC, char>::value) = 0>
@@ -422,33 +1015,89 @@ loop_parse_if_digits(char const *&p, char const *const pend,
       }
   }
 #endif
-  // Optimizes better than parse_if_eight_digits_unrolled() for char.
-  while (std::distance(p, pend) >= 8 /*sizeof(uint64_t)*/) {
+  // Optimizes better than parse_if_eight_digits_unrolled() for char.
+  while (std::distance(p, pend) >= 8 /*sizeof(uint64_t)*/) {
+    auto const val = read_chars_to_unsigned<uint64_t>(p);
+    if (is_made_of_8_digits(val)) {
+      i = i * 100000000 + parse_8_digits(val); // may overflow, that's ok
+      p += sizeof(uint64_t);
+    } else {
+      break;
+    }
+  }
+  // Consume a remaining 4-7 digit run in a single SWAR step instead of
+  // byte-by-byte (reuses the existing 4-digit helpers). The parsed result is
+  // identical either way. Historically gated to clang because gcc regressed on
+  // short remainders, but that verdict predates the span-elision restructure;
+  // with the leaner hot path the 4-digit step now wins on gcc as well.
+  if (std::distance(p, pend) >= 4 /*sizeof(uint32_t)*/) {
+    auto const val = read_chars_to_unsigned<uint32_t>(p);
+    if (is_made_of_4_digits(val)) {
+      i = i * 10000 + parse_4_digits(val); // may overflow, that's ok
+      p += sizeof(uint32_t);
+    }
+  }
+  // Finalizer
+  while ((p != pend) && is_integer(*p)) {
+    i = i * 10 + static_cast<uint8_t>(*p - '0'); // may overflow, that's ok
+    ++p;
+  }
+}
+
+// Parse at most 19 digits into a 64-bit lane, which therefore never overflows.
+// Returns the number of digits consumed.
+template <typename UC, FASTFLOAT_ENABLE_IF(!std::is_same<UC, char>::value) = 0>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 am_digits
+parse_19_digits_lane(UC const *&p, UC const *const pend,
+                     uint64_t &lane) noexcept {
+  auto const *const start = p;
+  if (!is_constant_evaluated()) {
+    if FASTFLOAT_CONSTEXPR17 (has_simd_opt<UC>()) {
+#if FASTFLOAT_USE_SIMD && FASTFLOAT_X86_SIMD >= 31
+      if (std::distance(p, pend) >= 16 && simd_parse_if_16_digits(p, lane)) {
+        p += 16;
+      }
+#endif
+      // With at most 11 digits in the lane, another 8-digit block still fits.
+      while ((std::distance(p, pend) >= 8) && (std::distance(start, p) <= 11) &&
+             simd_parse_if_8_digits(p, lane)) {
+        p += 8;
+      }
+    }
+  }
+  while ((p != pend) && (std::distance(start, p) < 19) && is_integer(*p)) {
+    lane = lane * 10 + static_cast<uint8_t>(*p - UC('0'));
+    ++p;
+  }
+  return static_cast<am_digits>(p - start);
+}
+
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 am_digits
+parse_19_digits_lane(char const *&p, char const *const pend,
+                     uint64_t &lane) noexcept {
+  auto const *const start = p;
+#if FASTFLOAT_USE_SIMD && FASTFLOAT_X86_SIMD >= 31
+  if (!is_constant_evaluated() && std::distance(p, pend) >= 16 &&
+      is_made_of_8_digits(read_chars_to_unsigned<uint64_t>(p)) &&
+      is_made_of_8_digits(read_chars_to_unsigned<uint64_t>(p + 8))) {
+    lane = parse_16_digits(p);
+    p += 16;
+  }
+#endif
+  // With at most 11 digits in the lane, another 8-digit block still fits.
+  while ((std::distance(p, pend) >= 8) && (std::distance(start, p) <= 11)) {
     auto const val = read_chars_to_unsigned<uint64_t>(p);
-    if (is_made_of_8_digits(val)) {
-      i = i * 100000000 + parse_8_digits(val); // may overflow, that's ok
-      p += sizeof(uint64_t);
-    } else {
+    if (!is_made_of_8_digits(val)) {
       break;
     }
+    lane = lane * 100000000 + parse_8_digits(val);
+    p += 8;
   }
-  // Consume a remaining 4-7 digit run in a single SWAR step instead of
-  // byte-by-byte (reuses the existing 4-digit helpers). The parsed result is
-  // identical either way. Historically gated to clang because gcc regressed on
-  // short remainders, but that verdict predates the span-elision restructure;
-  // with the leaner hot path the 4-digit step now wins on gcc as well.
-  if (std::distance(p, pend) >= 4 /*sizeof(uint32_t)*/) {
-    auto const val = read_chars_to_unsigned<uint32_t>(p);
-    if (is_made_of_4_digits(val)) {
-      i = i * 10000 + parse_4_digits(val); // may overflow, that's ok
-      p += sizeof(uint32_t);
-    }
-  }
-  // Finalizer
-  while ((p != pend) && is_integer(*p)) {
-    i = i * 10 + static_cast<uint8_t>(*p - '0'); // may overflow, that's ok
+  while ((p != pend) && (std::distance(start, p) < 19) && is_integer(*p)) {
+    lane = lane * 10 + static_cast<uint8_t>(*p - '0');
     ++p;
   }
+  return static_cast<am_digits>(p - start);
 }
 
 enum class parse_error : uint_fast8_t {
@@ -502,6 +1151,55 @@ report_parse_error(parsed_number_string_t<UC> &answer, UC const *p,
   return answer;
 }
 
+// The first 19 significant digits of a long number, past its leading zeros.
+struct truncated_mantissa {
+  am_mant_t mantissa;
+  am_pow_t exponent;
+  bool too_many_digits;
+};
+
+// Each digit of a long input is read a bounded number of times: the zeros
+// are skipped a vector at a time, and only 19 digits are accumulated. Out of
+// line, so that it does not weigh on the hot path of parse_number_string.
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 truncated_mantissa truncate_long_mantissa(
+    UC const *const start_digits, UC const *const end_of_integer_part,
+    UC const *const fraction_start, UC const *const end_of_mantissa,
+    am_pow_t const exp_number) noexcept {
+  // We have to handle the case where we have 0.0000somenumber, and the case
+  // where we only have zeroes, e.g., 0.000000000...000.
+  UC const *first = skip_zero_digits(start_digits, end_of_integer_part);
+  if (first == end_of_integer_part) {
+    first = skip_zero_digits(fraction_start, end_of_mantissa);
+  }
+  truncated_mantissa answer;
+  answer.too_many_digits =
+      std::distance(first, end_of_mantissa) -
+          (first < end_of_integer_part && fraction_start != end_of_integer_part) >
+      19;
+  answer.mantissa = 0;
+  // The digit counts may not fit in am_pow_t: saturate the exponent well
+  // past the range of every format.
+  int64_t exponent = exp_number;
+  UC const *p = first;
+  if (p < end_of_integer_part) {
+    parse_digits_until_19(p, end_of_integer_part, answer.mantissa);
+    exponent += std::distance(p, end_of_integer_part);
+    p = fraction_start;
+  }
+  if (answer.mantissa < minimal_nineteen_digit_integer &&
+      p < end_of_mantissa) {
+    parse_digits_until_19(p, end_of_mantissa, answer.mantissa);
+    exponent -= std::distance(fraction_start, p);
+  }
+  constexpr int64_t exponent_limit = 10 * int64_t(am_bias_limit);
+  answer.exponent = static_cast<am_pow_t>(
+      exponent < -exponent_limit  ? -exponent_limit
+      : exponent > exponent_limit ? exponent_limit
+                                  : exponent);
+  return answer;
+}
+
 // Assuming that you use no more than 19 digits, this will
 // parse an ASCII string.
 //
@@ -509,8 +1207,9 @@ report_parse_error(parsed_number_string_t<UC> &answer, UC const *p,
 // template would create a second instantiation of this whole function and the
 // extra icache pressure wipes out the gain). When false, the integer/fraction
 // spans (read only by the rare digit_comp slow path) are not materialized,
-// which keeps the fat parsed_number_string_t off the hot path. The caller
-// re-parses with store_spans=true if the slow path is actually reached.
+// which keeps the fat parsed_number_string_t off the hot path. They are always
+// stored for more than 19 digits; otherwise the caller re-parses with
+// store_spans=true if the slow path is actually reached.
 template <bool basic_json_fmt, typename UC>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 parsed_number_string_t<UC>
 parse_number_string(UC const *p, UC const *pend,
@@ -525,6 +1224,7 @@ parse_number_string(UC const *p, UC const *pend,
       ((chars_format_t(options.format & chars_format::allow_leading_plus)) &&
        (!basic_json_fmt && *p == UC('+')))) {
     ++p;
+#ifndef FASTFLOAT_TRUSTED_INPUT
     if (p == pend) {
       return report_parse_error<UC>(
           answer, p, parse_error::missing_integer_or_dot_after_sign);
@@ -543,7 +1243,11 @@ parse_number_string(UC const *p, UC const *pend,
             answer, p, parse_error::missing_integer_or_dot_after_sign);
       }
     }
+#endif
   }
+#endif
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  FASTFLOAT_DEBUG_ASSERT((p != pend) && is_integer(*p));
 #endif
   auto const *const start_digits = p;
 
@@ -574,11 +1278,7 @@ parse_number_string(UC const *p, UC const *pend,
             answer.mantissa = static_cast<fast_float::am_mant_t>(
                 answer.mantissa * 10 + static_cast<uint8_t>(*p - UC('0')));
             ++p;
-            while ((p != pend) && is_integer(*p)) {
-              answer.mantissa = static_cast<fast_float::am_mant_t>(
-                  answer.mantissa * 10 + static_cast<uint8_t>(*p - UC('0')));
-              ++p;
-            }
+            loop_parse_if_digits(p, pend, answer.mantissa);
           }
         }
       }
@@ -587,13 +1287,16 @@ parse_number_string(UC const *p, UC const *pend,
   }
 #endif
   UC const *const end_of_integer_part = p;
-  auto digit_count = static_cast<am_digits>(end_of_integer_part - start_digits);
+  // A long input can have more digits than am_digits counts.
+  auto digit_count = std::distance(start_digits, end_of_integer_part);
   if fastfloat_unlikely (store_spans) {
-    answer.integer = span<UC const>(start_digits, digit_count);
+    answer.integer =
+        span<UC const>(start_digits, static_cast<am_digits>(digit_count));
   }
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
   if FASTFLOAT_CONSTEXPR17 (basic_json_fmt) {
     // at least 1 digit in integer part, without leading zeros
+#ifndef FASTFLOAT_TRUSTED_INPUT
     if (digit_count == 0) {
       return report_parse_error<UC>(answer, p,
                                     parse_error::no_digits_in_integer_part);
@@ -602,6 +1305,9 @@ parse_number_string(UC const *p, UC const *pend,
       return report_parse_error<UC>(answer, start_digits,
                                     parse_error::leading_zeros_in_integer_part);
     }
+#else
+    FASTFLOAT_DEBUG_ASSERT(start_digits[0] != UC('0') || digit_count == 1);
+#endif
   }
 #endif
 
@@ -619,14 +1325,18 @@ parse_number_string(UC const *p, UC const *pend,
       answer.fraction =
           span<UC const>(before, static_cast<am_digits>(p - before));
     }
-    digit_count -= static_cast<am_digits>(answer.exponent);
+    digit_count += std::distance(before, p);
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
     if FASTFLOAT_CONSTEXPR17 (basic_json_fmt) {
       // at least 1 digit in fractional part
-      if (answer.exponent == 0) {
+#ifndef FASTFLOAT_TRUSTED_INPUT
+      if (p == before) {
         return report_parse_error<UC>(
             answer, p, parse_error::no_digits_in_fractional_part);
       }
+#else
+      FASTFLOAT_DEBUG_ASSERT(p != before);
+#endif
     }
 #endif
   }
@@ -639,6 +1349,7 @@ parse_number_string(UC const *p, UC const *pend,
   }
 #endif
   // We have now parsed the integer and the fraction part of the mantissa.
+  UC const *const end_of_mantissa = p;
 
   // Now we can parse the explicit exponential part.
   am_pow_t exp_number = 0; // explicit exponential part
@@ -651,7 +1362,9 @@ parse_number_string(UC const *p, UC const *pend,
             (UC('D') == *p)))
 #endif
            )) {
+#ifndef FASTFLOAT_TRUSTED_INPUT
     auto const *location_of_e = p;
+#endif
 #ifdef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
     ++p;
 #else
@@ -674,6 +1387,7 @@ parse_number_string(UC const *p, UC const *pend,
       }
     }
     // We have now parsed the sign of the exponent.
+#ifndef FASTFLOAT_TRUSTED_INPUT
     if ((p == pend) || !is_integer(*p)) {
       if (!(chars_format_t(options.format & chars_format::fixed))) {
         // The exponential part is invalid for scientific notation, so it
@@ -684,7 +1398,11 @@ parse_number_string(UC const *p, UC const *pend,
       }
       // Otherwise, we will be ignoring the 'e'.
       p = location_of_e;
-    } else {
+    } else
+#else
+    FASTFLOAT_DEBUG_ASSERT((p != pend) && is_integer(*p));
+#endif
+    {
       // Now let's parse the explicit exponent.
       while ((p != pend) && is_integer(*p)) {
         if (exp_number < am_bias_limit) {
@@ -701,11 +1419,17 @@ parse_number_string(UC const *p, UC const *pend,
     }
   } else {
     // If it scientific and not fixed, we have to bail out.
-    if ((chars_format_t(options.format & chars_format::scientific)) &&
-        !(chars_format_t(options.format & chars_format::fixed))) {
+    bool const needs_exponent =
+        (chars_format_t(options.format & chars_format::scientific)) &&
+        !(chars_format_t(options.format & chars_format::fixed));
+#ifndef FASTFLOAT_TRUSTED_INPUT
+    if (needs_exponent) {
       return report_parse_error<UC>(answer, p,
                                     parse_error::missing_exponential_part);
     }
+#else
+    FASTFLOAT_DEBUG_ASSERT(!needs_exponent);
+#endif
   }
 
   // We sucessfully parsed all parts of the number, let's save progress.
@@ -719,52 +1443,251 @@ parse_number_string(UC const *p, UC const *pend,
   //
   // We can deal with up to 19 digits.
   if (digit_count > 19) {
-    // It is possible that the integer had an overflow.
-    // We have to handle the case where we have 0.0000somenumber.
-    // We need to be mindful of the case where we only have zeroes...
-    // E.g., 0.000000000...000.
-    auto const *start = start_digits;
-    do {
-      if (*start == UC('0')) {
-        --digit_count;
-      } else if (*start != options.decimal_point) {
+    // Past 19 digits the mantissa stopped accumulating. The spans are always
+    // stored here, so that the caller never has to parse the digits again.
+    UC const *const fraction_start = end_of_integer_part + has_decimal_point;
+    answer.integer = span<UC const>(
+        start_digits,
+        static_cast<am_digits>(end_of_integer_part - start_digits));
+    if (has_decimal_point) {
+      answer.fraction = span<UC const>(
+          fraction_start,
+          static_cast<am_digits>(end_of_mantissa - fraction_start));
+    }
+    truncated_mantissa const truncated = truncate_long_mantissa(
+        start_digits, end_of_integer_part, fraction_start, end_of_mantissa,
+        exp_number);
+    answer.mantissa = truncated.mantissa;
+    answer.exponent = truncated.exponent;
+    answer.too_many_digits = truncated.too_many_digits;
+  }
+
+  // Not a plain `return answer;`: when no error can be reported, as with
+  // FASTFLOAT_TRUSTED_INPUT, that would let the compiler build `answer` in
+  // the caller's memory (NRVO) instead of in registers.
+  return static_cast<parsed_number_string_t<UC> const &>(answer);
+}
+
+// Walks the significant digits of a parsed number (leading zeros skipped)
+// across its integer and fraction spans.
+template <typename UC> struct significant_digits {
+  FASTFLOAT_CONSTEXPR20 explicit significant_digits(
+      parsed_number_string_t<UC> const &pns) noexcept
+      : p(pns.integer.ptr), pend(pns.integer.ptr + pns.integer.len()),
+        fraction(pns.fraction), in_fraction(false) {
+    skip_leading_zeros();
+  }
+
+  FASTFLOAT_CONSTEXPR20 am_digits remaining() const noexcept {
+    return am_digits(pend - p) + (in_fraction ? 0 : fraction.len());
+  }
+
+  FASTFLOAT_CONSTEXPR20 uint8_t next() noexcept {
+    if (p == pend) {
+      next_span();
+    }
+    return static_cast<uint8_t>(*p++ - UC('0'));
+  }
+
+  // true if any of the remaining digits is not zero
+  FASTFLOAT_CONSTEXPR20 bool nonzero_tail() noexcept {
+    while (remaining() != 0) {
+      if (next() != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  FASTFLOAT_CONSTEXPR20 void next_span() noexcept {
+    in_fraction = true;
+    p = fraction.ptr;
+    pend = fraction.ptr + fraction.len();
+  }
+
+  FASTFLOAT_CONSTEXPR20 void skip_leading_zeros() noexcept {
+    while (p != pend && *p == UC('0')) {
+      ++p;
+    }
+    if (p == pend && fraction.len() != 0) {
+      next_span();
+      while (p != pend && *p == UC('0')) {
+        ++p;
+      }
+    }
+  }
+
+  UC const *p;
+  UC const *pend;
+  span<UC const> fraction;
+  bool in_fraction;
+};
+
+// Store a magnitude into an integer type, returns false if it is out of range.
+template <typename T, FASTFLOAT_ENABLE_IF(!is_int128<T>::value) = 0>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
+integer_from_magnitude(value128 const v,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                       bool const negative,
+#endif
+                       T &value) noexcept {
+  if (v.high != 0 || v.low > am_mant_t(std::numeric_limits<T>::max())
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                 + uint8_t(negative)
+#endif
+  ) {
+    return false;
+  }
+  am_mant_t const i = v.low;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (negative) {
+#ifdef FASTFLOAT_VISUAL_STUDIO
+#pragma warning(push)
+#pragma warning(disable : 4146)
+#pragma warning(disable : 4804)
+#endif
+    // this weird workaround is required because:
+    // - converting unsigned to signed when its value is greater than signed max
+    // is UB pre-C++23.
+    // - reinterpret_casting (~i + 1) would work, but it is not constexpr
+    // this is always optimized into a neg instruction (note: T is an integer
+    // type)
+    value = T(-std::numeric_limits<T>::max() -
+              T(i - am_mant_t(std::numeric_limits<T>::max())));
+#ifdef FASTFLOAT_VISUAL_STUDIO
+#pragma warning(pop)
+#endif
+    return true;
+  }
+#endif
+  value = T(i);
+  return true;
+}
+
+#ifdef FASTFLOAT_HAS_INT128
+template <typename T, FASTFLOAT_ENABLE_IF(is_int128<T>::value) = 0>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
+integer_from_magnitude(value128 const v,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                       bool const negative,
+#endif
+                       T &value) noexcept {
+  if (is_signed_integer<T>::value) {
+    // the magnitude must stay below 2^127, or be exactly 2^127 if negative
+    if ((v.high >> 63) != 0
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+        && !(negative && v.high == (uint64_t(1) << 63) && v.low == 0)
+#endif
+    ) {
+      return false;
+    }
+  }
+  auto const i = (__uint128_t(v.high) << 64) | v.low;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (negative) {
+    // same workaround as above
+    auto const max = ~__uint128_t(0) >> 1;
+    value = T(-T(max) - T(i - max));
+    return true;
+  }
+#endif
+  value = T(i);
+  return true;
+}
+
+// Parse the digits of a 128-bit integer. The digits are accumulated into 64-bit
+// lanes which are folded into a value128 with an exact overflow check, so a
+// 39-digit value costs about as much as two uint64_t parses.
+template <typename T, typename UC, FASTFLOAT_ENABLE_IF(is_int128<T>::value) = 0>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+parse_int128_digits(UC const *const first, UC const *p, UC const *const pend,
+                    bool const has_leading_zeros,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                    bool const negative,
+#endif
+                    T &value, base_t const base) noexcept {
+  from_chars_result_t<UC> answer;
+  auto const *const start_digits = p;
+
+  value128 v;
+  bool fits = true;
+  if (base == 10) {
+    for (;;) {
+      uint64_t lane = 0;
+      auto const n = parse_19_digits_lane(p, pend, lane);
+      if (n == 0) {
         break;
       }
-    } while (++start != pend);
-
-    // We have to check if number has more than 19 significant digits.
-    if (digit_count > 19) {
-      answer.too_many_digits = true;
-      // The truncation recompute below reads the integer/fraction spans. When
-      // store_spans is false we didn't materialize them, so just flag
-      // too_many_digits; the caller re-parses with store_spans=true to obtain
-      // the corrected mantissa/exponent before taking the slow path.
-      if fastfloat_unlikely (store_spans) {
-        // Let us start again, this time, avoiding overflows.
-        // We don't need to call if is_integer, since we use the
-        // pre-tokenized spans from above.
-        answer.mantissa = 0;
-        p = answer.integer.ptr;
-        UC const *int_end = p + answer.integer.len();
-        parse_digits_until_19(p, int_end, answer.mantissa);
-        if (answer.mantissa >= minimal_nineteen_digit_integer) {
-          // We have a big integers, so skip the fraction part completely.
-          answer.exponent = am_pow_t(end_of_integer_part - p) + exp_number;
-        } else if (answer.fraction.len()) {
-          // We have a value with a significant fractional component.
-          p = answer.fraction.ptr;
-          UC const *const frac_end = p + answer.fraction.len();
-          parse_digits_until_19(p, frac_end, answer.mantissa);
-          answer.exponent = am_pow_t(answer.fraction.ptr - p) + exp_number;
+      // keep consuming digits after an overflow, answer.ptr must skip them
+      fits = fits && multiply_add(v, powers_of_ten_uint64[n], lane);
+      if (n != 19) {
+        break;
+      }
+    }
+  } else {
+    // A lane of max_digits_u64(base) - 1 digits never overflows.
+    limb_t const lane_digits = max_digits_u64(base) - 1;
+    for (;;) {
+      uint64_t lane = 0;
+      uint64_t scale = 1;
+      limb_t n = 0;
+      while ((p != pend) && (n != lane_digits)) {
+        auto const digit = ch_to_digit(*p);
+        if (digit >= base) {
+          break;
         }
-        // We have now corrected both exponent and mantissa, to a truncated
-        // value
+        lane = lane * base + digit;
+        scale *= base;
+        ++p;
+        ++n;
+      }
+      if (n == 0) {
+        break;
+      }
+      fits = fits && multiply_add(v, scale, lane);
+      if (n != lane_digits) {
+        break;
       }
     }
   }
 
+  if (p == start_digits) {
+    if (has_leading_zeros) {
+      value = 0;
+      answer.ec = std::errc();
+      answer.ptr = p;
+      return answer;
+    }
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+
+  answer.ptr = p;
+  if (!fits || !integer_from_magnitude(v,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                       negative,
+#endif
+                                       value)) {
+    answer.ec = std::errc::result_out_of_range;
+    return answer;
+  }
+  answer.ec = std::errc();
   return answer;
 }
+#endif
+
+// dummy for compiler
+template <typename T, typename UC, FASTFLOAT_ENABLE_IF(!is_int128<T>::value) = 0>
+from_chars_result_t<UC> parse_int128_digits(UC const *, UC const *, UC const *,
+                                            bool,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                            bool,
+#endif
+                                            T &, base_t) {
+  return from_chars_result_t<UC>();
+}
 
 template <typename T, typename UC>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
@@ -783,7 +1706,7 @@ parse_int_string(UC const *p, UC const *pend, T &value,
 #pragma warning(push)
 #pragma warning(disable : 4127)
 #endif
-  if (!std::is_signed<T>::value && negative) {
+  if (!is_signed_integer<T>::value && negative) {
 #ifdef FASTFLOAT_VISUAL_STUDIO
 #pragma warning(pop)
 #endif
@@ -811,22 +1734,22 @@ parse_int_string(UC const *p, UC const *pend, T &value,
 
   if (options.base == 10) {
     auto const len = static_cast<am_digits>(pend - p);
-#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
-    // parser already check that this is num and it's exist
     if (len == 0) {
-#endif
-      if (has_leading_zeros) {
-        value = 0;
-        answer.ec = std::errc();
-        answer.ptr = p;
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+      if (!has_leading_zeros) {
+        answer.ec = std::errc::invalid_argument;
+        answer.ptr = first;
         return answer;
       }
-#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
-      answer.ec = std::errc::invalid_argument;
-      answer.ptr = first;
+#else
+      // parser already check that this is num and it's exist
+      FASTFLOAT_DEBUG_ASSERT(has_leading_zeros);
+#endif
+      value = 0;
+      answer.ec = std::errc();
+      answer.ptr = p;
       return answer;
     }
-#endif
 
     if FASTFLOAT_CONSTEXPR17 (std::is_same<T, std::uint8_t>::value &&
                               sizeof(UC) == 1) {
@@ -847,22 +1770,22 @@ parse_int_string(UC const *p, UC const *pend, T &value,
       auto const tz = countr_zero_32(magic); // 7, 15, 23, 31, or 32
       auto nd = static_cast<am_digits>(tz >> 3);
       nd = nd < len ? nd : len;
-#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
-      // parser already check that this is num and it's exist
       if (nd == 0) {
-#endif
-        if (has_leading_zeros) {
-          value = 0;
-          answer.ec = std::errc();
-          answer.ptr = p;
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+        if (!has_leading_zeros) {
+          answer.ec = std::errc::invalid_argument;
+          answer.ptr = first;
           return answer;
         }
-#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
-        answer.ec = std::errc::invalid_argument;
-        answer.ptr = first;
+#else
+        // parser already check that this is num and it's exist
+        FASTFLOAT_DEBUG_ASSERT(has_leading_zeros);
+#endif
+        value = 0;
+        answer.ec = std::errc();
+        answer.ptr = p;
         return answer;
       }
-#endif
       if (nd > 3) {
         const UC *q = p + nd;
         auto rem = len - nd;
@@ -931,6 +1854,14 @@ parse_int_string(UC const *p, UC const *pend, T &value,
     }
   }
 
+  if FASTFLOAT_CONSTEXPR17 (is_int128<T>::value) {
+    return parse_int128_digits(first, p, pend, has_leading_zeros,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                               negative,
+#endif
+                               value, options.base);
+  }
+
   // Parse digits
   am_mant_t i = 0;
   if (options.base == 10) {
@@ -949,21 +1880,22 @@ parse_int_string(UC const *p, UC const *pend, T &value,
   auto const digit_count = static_cast<am_digits>(p - start_digits);
 
 #ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
-  // parser already check that this is num and it's exist
   if (digit_count == 0) {
-#endif
     if (has_leading_zeros) {
       value = 0;
       answer.ec = std::errc();
       answer.ptr = p;
       return answer;
     }
-#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
     answer.ec = std::errc::invalid_argument;
     answer.ptr = first;
 
     return answer;
   }
+#else
+  // parser already check that this is num and it's exist: without digits
+  // past the leading zeros, the value below is zero.
+  FASTFLOAT_DEBUG_ASSERT(digit_count != 0 || has_leading_zeros);
 #endif
 
   answer.ptr = p;
@@ -1000,46 +1932,105 @@ parse_int_string(UC const *p, UC const *pend, T &value,
   }
 
   // check other types overflow
-  if (!std::is_same<T, am_mant_t>::value) {
-    if (i > am_mant_t(std::numeric_limits<T>::max())
+  if (!integer_from_magnitude(value128(i, 0),
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
-                + uint8_t(negative)
-#endif
-    ) {
-      answer.ec = std::errc::result_out_of_range;
-      return answer;
-    }
-  }
-
-#ifdef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
-  value = T(i);
-#else
-  if (negative) {
-#ifdef FASTFLOAT_VISUAL_STUDIO
-#pragma warning(push)
-#pragma warning(disable : 4146)
-#pragma warning(disable : 4804)
-#endif
-    // this weird workaround is required because:
-    // - converting unsigned to signed when its value is greater than signed max
-    // is UB pre-C++23.
-    // - reinterpret_casting (~i + 1) would work, but it is not constexpr
-    // this is always optimized into a neg instruction (note: T is an integer
-    // type)
-    value = T(-std::numeric_limits<T>::max() -
-              T(i - am_mant_t(std::numeric_limits<T>::max())));
-#ifdef FASTFLOAT_VISUAL_STUDIO
-#pragma warning(pop)
+                              negative,
 #endif
-  } else {
-    value = T(i);
+                              value)) {
+    answer.ec = std::errc::result_out_of_range;
+    return answer;
   }
-#endif
 
   answer.ec = std::errc();
   return answer;
 }
 
+
+// Compute the exact magnitude of a parsed number that must be an integer, e.g.
+// "1e6" or "2.50E3". Returns std::errc::invalid_argument if the value has a
+// non-zero fractional part and std::errc::result_out_of_range if it does not
+// fit in 128 bits. Only exact integer arithmetic is used: when
+// pns.too_many_digits is set the integer/fraction spans must be available.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 std::errc
+integral_magnitude(parsed_number_string_t<UC> const &pns,
+                   value128 &v) noexcept {
+  am_mant_t const m = pns.mantissa;
+  am_pow_t e = pns.exponent;
+  v = value128();
+  if (m == 0) {
+    return std::errc();
+  }
+  if fastfloat_unlikely (pns.too_many_digits) {
+    // The mantissa holds the first 19 significant digits, the value is
+    // (mantissa + 0.tail) * 10^exponent with the remaining digits as tail.
+    UC const *p = pns.integer.ptr;
+    UC const *const pend = p + pns.integer.len();
+    UC const *q = pns.fraction.ptr;
+    UC const *const qend = q + pns.fraction.len();
+    am_digits seen = 0;
+    for (; (p != pend) && (seen != 19); ++p) {
+      seen += am_digits(seen != 0 || *p != UC('0'));
+    }
+    for (; (q != qend) && (seen != 19); ++q) {
+      seen += am_digits(seen != 0 || *q != UC('0'));
+    }
+    bool const scaled = e > 0;
+    if (scaled) {
+      // mantissa >= 10^18, so anything above 10^20 * mantissa overflows
+      if (e > 20) {
+        return std::errc::result_out_of_range;
+      }
+      v.low = m;
+      for (; e != 0; --e) {
+        uint64_t digit = 0;
+        if (p != pend) {
+          digit = static_cast<uint8_t>(*p++ - UC('0'));
+        } else if (q != qend) {
+          digit = static_cast<uint8_t>(*q++ - UC('0'));
+        }
+        if (!multiply_add(v, 10, digit)) {
+          return std::errc::result_out_of_range;
+        }
+      }
+    }
+    for (; p != pend; ++p) {
+      if (*p != UC('0')) {
+        return std::errc::invalid_argument;
+      }
+    }
+    for (; q != qend; ++q) {
+      if (*q != UC('0')) {
+        return std::errc::invalid_argument;
+      }
+    }
+    if (scaled) {
+      return std::errc();
+    }
+  }
+  if (e >= 0) {
+    // m >= 1, so 10^39 and above cannot fit
+    if (e > 38) {
+      return std::errc::result_out_of_range;
+    }
+    v = full_multiplication(m, powers_of_ten_uint64[e < 19 ? e : 19]);
+    if (e > 19 && !multiply_add(v, powers_of_ten_uint64[e - 19], 0)) {
+      return std::errc::result_out_of_range;
+    }
+    return std::errc();
+  }
+  // m < 10^19, so it cannot be a multiple of a larger power of ten
+  if (e < -19) {
+    return std::errc::invalid_argument;
+  }
+  uint64_t const divisor = powers_of_ten_uint64[-e];
+  if (m % divisor != 0) {
+    return std::errc::invalid_argument;
+  }
+  v.low = m / divisor;
+  return std::errc();
+}
+
 } // namespace fast_float
 
 #endif
@@ -34,14 +34,18 @@ typedef span<limb> limb_span;
 // ~3600 bits, so we round to 4000.
 typedef uint_fast16_t bigint_bits_t;
 constexpr bigint_bits_t bigint_bits = 4000;
-constexpr limb_t bigint_limbs = bigint_bits / limb_bits;
+
+// The number of limbs in a bigint.
+typedef uint_fast16_t bigint_limbs_t;
+constexpr bigint_limbs_t bigint_limbs = bigint_bits / limb_bits;
 
 // vector-like type that is allocated on the stack. the entire
 // buffer is pre-allocated, and only the length changes.
-template <limb_t size> struct stackvec {
+template <bigint_limbs_t size> struct stackvec {
   limb data[size];
-  // we never need more than 150 limbs
-  limb_t length{0};
+  // we never need more than 150 limbs for double, and 608 for binary128. a
+  // narrow field also lets the compiler bound len() in the shifts below.
+  uint16_t length{0};
 
   FASTFLOAT_CONSTEXPR20 stackvec() noexcept = default;
   stackvec(stackvec const &) = delete;
@@ -54,31 +58,33 @@ template <limb_t size> struct stackvec {
     FASTFLOAT_ASSERT(try_extend(s));
   }
 
-  FASTFLOAT_CONSTEXPR14 limb &operator[](limb_t index) noexcept {
+  FASTFLOAT_CONSTEXPR14 limb &operator[](bigint_limbs_t index) noexcept {
     FASTFLOAT_DEBUG_ASSERT(index < length);
     return data[index];
   }
 
-  FASTFLOAT_CONSTEXPR14 const limb &operator[](limb_t index) const noexcept {
+  FASTFLOAT_CONSTEXPR14 const limb &operator[](bigint_limbs_t index) const noexcept {
     FASTFLOAT_DEBUG_ASSERT(index < length);
     return data[index];
   }
 
   // index from the end of the container
-  FASTFLOAT_CONSTEXPR14 const limb &rindex(limb_t index) const noexcept {
+  FASTFLOAT_CONSTEXPR14 const limb &rindex(bigint_limbs_t index) const noexcept {
     FASTFLOAT_DEBUG_ASSERT(index < length);
     auto rindex = length - index - 1;
     return data[rindex];
   }
 
   // set the length, without bounds checking.
-  FASTFLOAT_CONSTEXPR14 void set_len(limb_t len) noexcept { length = len; }
+  FASTFLOAT_CONSTEXPR14 void set_len(bigint_limbs_t len) noexcept {
+    length = static_cast<uint16_t>(len);
+  }
 
-  constexpr limb_t len() const noexcept { return length; }
+  constexpr bigint_limbs_t len() const noexcept { return length; }
 
   constexpr bool is_empty() const noexcept { return length == 0; }
 
-  constexpr limb_t capacity() const noexcept { return size; }
+  constexpr bigint_limbs_t capacity() const noexcept { return size; }
 
   // append item to vector, without bounds checking
   FASTFLOAT_CONSTEXPR14 void push_unchecked(limb value) noexcept {
@@ -100,7 +106,7 @@ template <limb_t size> struct stackvec {
   FASTFLOAT_CONSTEXPR20 void extend_unchecked(limb_span s) noexcept {
     limb *ptr = data + length;
     std::copy_n(s.ptr, s.len(), ptr);
-    set_len(len() + static_cast<limb_t>(s.len()));
+    set_len(len() + static_cast<bigint_limbs_t>(s.len()));
   }
 
   // try to add items to the vector, returning if items were added
@@ -117,7 +123,7 @@ template <limb_t size> struct stackvec {
   // if the new size is longer than the vector, assign value to each
   // appended item.
   FASTFLOAT_CONSTEXPR20
-  void resize_unchecked(limb_t new_len, limb value) noexcept {
+  void resize_unchecked(bigint_limbs_t new_len, limb value) noexcept {
     if (new_len > len()) {
       auto const count = new_len - len();
       limb *first = data + len();
@@ -128,7 +134,7 @@ template <limb_t size> struct stackvec {
   }
 
   // try to resize the vector, returning if the vector was resized.
-  FASTFLOAT_CONSTEXPR20 bool try_resize(limb_t new_len, limb value) noexcept {
+  FASTFLOAT_CONSTEXPR20 bool try_resize(bigint_limbs_t new_len, limb value) noexcept {
     if (new_len > capacity()) {
       return false;
     } else {
@@ -140,7 +146,7 @@ template <limb_t size> struct stackvec {
   // check if any limbs are non-zero after the given index.
   // this needs to be done in reverse order, since the index
   // is relative to the most significant limbs.
-  FASTFLOAT_CONSTEXPR14 bool nonzero(limb_t index) const noexcept {
+  FASTFLOAT_CONSTEXPR14 bool nonzero(bigint_limbs_t index) const noexcept {
     while (index < len()) {
       if (rindex(index) != 0) {
         return true;
@@ -253,9 +259,9 @@ scalar_mul(limb x, limb y, limb &carry) noexcept {
 
 // add scalar value to bigint starting from offset.
 // used in grade school multiplication
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
-small_add_from(stackvec<size> &vec, limb carry, limb_t start) noexcept {
+small_add_from(stackvec<size> &vec, limb carry, bigint_limbs_t start) noexcept {
   bool overflow;
   while (carry != 0 && start < vec.len()) {
     vec[start] = scalar_add(vec[start], carry, overflow);
@@ -269,18 +275,18 @@ small_add_from(stackvec<size> &vec, limb carry, limb_t start) noexcept {
 }
 
 // add scalar value to bigint.
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
 small_add(stackvec<size> &vec, limb y) noexcept {
   return small_add_from(vec, y, 0);
 }
 
 // multiply bigint by scalar value.
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
 small_mul(stackvec<size> &vec, limb y) noexcept {
   limb carry = 0;
-  for (limb_t index = 0; index != vec.len(); ++index) {
+  for (bigint_limbs_t index = 0; index != vec.len(); ++index) {
     vec[index] = scalar_mul(vec[index], y, carry);
   }
   if (carry != 0) {
@@ -291,18 +297,18 @@ small_mul(stackvec<size> &vec, limb y) noexcept {
 
 // add bigint to bigint starting from index.
 // used in grade school multiplication
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
-large_add_from(stackvec<size> &x, limb_span y, limb_t start) noexcept {
+large_add_from(stackvec<size> &x, limb_span y, bigint_limbs_t start) noexcept {
   // the effective x buffer is from `xstart..x.len()`, so exit early
   // if we can't get that current range.
   if (x.len() < start ||
       y.len() > static_cast<uint_fast16_t>(x.len() - start)) {
-    FASTFLOAT_TRY(x.try_resize(static_cast<limb_t>(y.len()) + start, 0));
+    FASTFLOAT_TRY(x.try_resize(static_cast<bigint_limbs_t>(y.len()) + start, 0));
   }
 
   bool carry = false;
-  for (limb_t index = 0; index != y.len(); ++index) {
+  for (bigint_limbs_t index = 0; index != y.len(); ++index) {
     limb xi = x[index + start];
     limb const yi = y[index];
     bool c1 = false;
@@ -317,20 +323,20 @@ large_add_from(stackvec<size> &x, limb_span y, limb_t start) noexcept {
 
   // handle overflow
   if (carry) {
-    FASTFLOAT_TRY(small_add_from(x, 1, static_cast<limb_t>(y.len()) + start));
+    FASTFLOAT_TRY(small_add_from(x, 1, static_cast<bigint_limbs_t>(y.len()) + start));
   }
   return true;
 }
 
 // add bigint to bigint.
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
 large_add_from(stackvec<size> &x, limb_span y) noexcept {
   return large_add_from(x, y, 0);
 }
 
 // grade-school multiplication algorithm
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
 long_mul(stackvec<size> &x, limb_span y) noexcept {
   limb_span xs = limb_span(x.data, x.len());
@@ -340,7 +346,7 @@ long_mul(stackvec<size> &x, limb_span y) noexcept {
   if (y.len() != 0) {
     limb y0 = y[0];
     FASTFLOAT_TRY(small_mul(x, y0));
-    for (limb_t index = 1; index != y.len(); ++index) {
+    for (bigint_limbs_t index = 1; index != y.len(); ++index) {
       limb const yi = y[index];
       stackvec<size> zi;
       if (yi != 0) {
@@ -359,7 +365,7 @@ long_mul(stackvec<size> &x, limb_span y) noexcept {
 }
 
 // grade-school multiplication algorithm
-template <limb_t size>
+template <bigint_limbs_t size>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
 large_mul(stackvec<size> &x, limb_span y) noexcept {
   if (y.len() == 1) {
@@ -427,18 +433,18 @@ template <typename T> constexpr limb pow5_tables<T>::large_power_of_5[];
 // arithmetic, using simple algorithms since asymptotically
 // faster algorithms are slower for a small number of limbs.
 // all operations assume the big-integer is normalized.
-struct bigint : pow5_tables<> {
+template <bigint_limbs_t size> struct basic_bigint : pow5_tables<> {
   // storage of the limbs, in little-endian order.
-  stackvec<bigint_limbs> vec;
+  stackvec<size> vec;
 
-  FASTFLOAT_CONSTEXPR20 bigint() noexcept : vec() {}
+  FASTFLOAT_CONSTEXPR20 basic_bigint() noexcept : vec() {}
 
-  bigint(bigint const &) = delete;
-  bigint &operator=(bigint const &) = delete;
-  bigint(bigint &&) = delete;
-  bigint &operator=(bigint &&other) = delete;
+  basic_bigint(basic_bigint const &) = delete;
+  basic_bigint &operator=(basic_bigint const &) = delete;
+  basic_bigint(basic_bigint &&) = delete;
+  basic_bigint &operator=(basic_bigint &&other) = delete;
 
-  FASTFLOAT_CONSTEXPR20 bigint(uint64_t value) noexcept : vec() {
+  FASTFLOAT_CONSTEXPR20 basic_bigint(uint64_t value) noexcept : vec() {
 #ifdef FASTFLOAT_64BIT_LIMB
     vec.push_unchecked(value);
 #else
@@ -483,13 +489,13 @@ struct bigint : pow5_tables<> {
   // positive, this is larger, otherwise they are equal.
   // the limbs are stored in little-endian order, so we
   // must compare the limbs in ever order.
-  FASTFLOAT_CONSTEXPR20 int compare(bigint const &other) const noexcept {
+  FASTFLOAT_CONSTEXPR20 int compare(basic_bigint const &other) const noexcept {
     if (vec.len() > other.vec.len()) {
       return 1;
     } else if (vec.len() < other.vec.len()) {
       return -1;
     } else {
-      for (limb_t index = vec.len(); index != 0; --index) {
+      for (bigint_limbs_t index = vec.len(); index != 0; --index) {
         limb const xi = vec[index - 1];
         limb const yi = other.vec[index - 1];
         if (xi > yi) {
@@ -516,7 +522,7 @@ struct bigint : pow5_tables<> {
     limb_t const shl = n;
     limb_t const shr = limb_bits - shl;
     limb prev = 0;
-    for (limb_t index = 0; index != vec.len(); ++index) {
+    for (bigint_limbs_t index = 0; index != vec.len(); ++index) {
       limb xi = vec[index];
       vec[index] = (xi << shl) | (prev >> shr);
       prev = xi;
@@ -530,7 +536,7 @@ struct bigint : pow5_tables<> {
   }
 
   // move the limbs left by `n` limbs.
-  FASTFLOAT_CONSTEXPR20 bool shl_limbs(limb_t n) noexcept {
+  FASTFLOAT_CONSTEXPR20 bool shl_limbs(bigint_limbs_t n) noexcept {
     FASTFLOAT_DEBUG_ASSERT(n != 0);
     if (n + vec.len() > vec.capacity()) {
       // we can't shift more than the capacity of the vector.
@@ -554,7 +560,7 @@ struct bigint : pow5_tables<> {
   // move the limbs left by `n` bits.
   FASTFLOAT_CONSTEXPR20 bool shl(bigint_bits_t n) noexcept {
     auto const rem = static_cast<limb_t>(n % limb_bits);
-    auto const div = static_cast<limb_t>(n / limb_bits);
+    auto const div = static_cast<bigint_limbs_t>(n / limb_bits);
     if (rem != 0) {
       FASTFLOAT_TRY(shl_bits(rem));
     }
@@ -564,6 +570,36 @@ struct bigint : pow5_tables<> {
     return true;
   }
 
+  // shift right each limb n bits, dropping the shifted out bits.
+  FASTFLOAT_CONSTEXPR20 void shr_bits(limb_t n) noexcept {
+    FASTFLOAT_DEBUG_ASSERT(n != 0);
+    FASTFLOAT_DEBUG_ASSERT(n < sizeof(limb) * 8);
+
+    limb_t const shr = n;
+    limb_t const shl = limb_bits - shr;
+    limb next = 0;
+    for (bigint_limbs_t index = vec.len(); index != 0; --index) {
+      limb const xi = vec[index - 1];
+      vec[index - 1] = (xi >> shr) | (next << shl);
+      next = xi;
+    }
+    vec.normalize();
+  }
+
+  // subtract a big integer that is not larger than this one.
+  FASTFLOAT_CONSTEXPR20 void sub(basic_bigint const &other) noexcept {
+    FASTFLOAT_DEBUG_ASSERT(compare(other) >= 0);
+    bool borrow = false;
+    for (bigint_limbs_t index = 0; index != vec.len(); ++index) {
+      limb const yi = index < other.vec.len() ? other.vec[index] : 0;
+      limb const xi = vec[index];
+      limb const diff = xi - yi - limb(borrow);
+      borrow = xi < yi || (xi == yi && borrow);
+      vec[index] = diff;
+    }
+    vec.normalize();
+  }
+
   // get the number of leading zeros in the bigint.
   FASTFLOAT_CONSTEXPR20 bigint_bits_t ctlz() const noexcept {
     if (vec.is_empty()) {
@@ -636,6 +672,8 @@ struct bigint : pow5_tables<> {
   }
 };
 
+typedef basic_bigint<bigint_limbs> bigint;
+
 } // namespace fast_float
 
 #endif
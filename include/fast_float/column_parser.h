@@ -0,0 +1,328 @@
+#ifndef FASTFLOAT_COLUMN_PARSER_H
+#define FASTFLOAT_COLUMN_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "parse_number.h"
+
+namespace fast_float {
+
+namespace detail {
+
+// The shape of a plain decimal number: the count of integer digits and of
+// fraction digits, the sign aside. A shape is only learned when both counts
+// fit in 8 digits and the digits, as an integer, in the mantissa of Clinger's
+// fast path: the number is then one division away.
+struct column_shape {
+  static constexpr uint8_t max_digits = 8;
+
+  uint8_t integer_digits;
+  uint8_t fraction_digits;
+
+  // The number of distinct shapes, fraction_digits == 0 being the shape of
+  // the numbers without a decimal point.
+  static constexpr size_t count = max_digits * (max_digits + 1);
+
+  constexpr size_t index() const noexcept {
+    return size_t(integer_digits - 1) * (max_digits + 1) + fraction_digits;
+  }
+};
+
+// The shape of the token [first, last) which from_chars accepted, or false
+// for a token with an exponent, no integer digit, a decimal point without a
+// fraction or too many digits.
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 bool measure_shape(UC const *first, UC const *const last,
+                                         UC const decimal_point,
+                                         column_shape &shape) noexcept {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (first != last && *first == UC('-')) {
+    ++first;
+  }
+#endif
+  UC const *const start_digits = first;
+  while (first != last && is_integer(*first)) {
+    ++first;
+  }
+  auto const integer_digits = first - start_digits;
+  ptrdiff_t fraction_digits = 0;
+  if (first != last && *first == decimal_point) {
+    UC const *const start_fraction = ++first;
+    while (first != last && is_integer(*first)) {
+      ++first;
+    }
+    fraction_digits = first - start_fraction;
+    if (fraction_digits == 0) {
+      return false;
+    }
+  }
+  if (first != last || integer_digits == 0 ||
+      integer_digits > column_shape::max_digits ||
+      fraction_digits > column_shape::max_digits ||
+      powers_of_ten_uint64[integer_digits + fraction_digits] - 1 >
+          binary_format<T>::max_mantissa_fast_path()) {
+    return false;
+  }
+  shape.integer_digits = uint8_t(integer_digits);
+  shape.fraction_digits = uint8_t(fraction_digits);
+  return true;
+}
+
+} // namespace detail
+
+/**
+ * A parser for a column of numbers which, like prices or coordinates, are
+ * nearly all written the same way. The first `sample_size` values are parsed
+ * with from_chars_float_advanced while their shapes are counted: the number
+ * of integer and of fraction digits, with or without a minus sign. If one
+ * shape is held by most of them, the following values are parsed by a kernel
+ * for that shape alone: two loads at fixed offsets, constant shifts to align
+ * the digits, a check that all of them are digits, and a single division by
+ * the exact power of ten, which is correctly rounded. A value that does not
+ * have the shape goes back to from_chars_float_advanced; when too many do, the
+ * shape is learned again.
+ *
+ * The results, `ptr` and `ec` included, are those of
+ * from_chars_float_advanced with the same options. The kernel is only used
+ * for char inputs, float and double, and formats without the JSON or Fortran
+ * rules; the other columns are parsed with from_chars_float_advanced. The
+ * rounding environment is probed once, when the parser is constructed, and
+ * the kernel runs only if it rounds to nearest.
+ */
+template <typename T, typename UC> struct column_parser_t {
+  explicit FASTFLOAT_CONSTEXPR20
+  column_parser_t(parse_options_t<UC> const options = parse_options_t<UC>(),
+                  size_t const sample_size = 64) noexcept
+      : options_(options),
+        rounding_(detail::make_rounding_context(options.rounding)),
+        sample_size_(sample_size == 0 ? 1 : sample_size),
+        learnable_(std::is_same<UC, char>::value &&
+                   (std::is_same<T, double>::value ||
+                    std::is_same<T, float>::value) &&
+                   rounding_.hardware_nearest && is_plain_format()) {
+    if (learnable_) {
+      relearn();
+    }
+  }
+
+  /**
+   * Parses the next value of the column, as from_chars_float_advanced would.
+   */
+  FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+  parse(UC const *first, UC const *last, T &value) noexcept {
+    if (shape_.integer_digits != 0) {
+      UC const *start = first;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      if (chars_format_t(options_.format & chars_format::skip_white_space)) {
+        start = skip_spaces(first, last);
+      }
+#endif
+      size_t const length = size_t(last - start) >= window
+                                ? parse_shape(start, value)
+                                : parse_shape_padded(start, last, value);
+      if (length != 0) {
+        ++hits_;
+        if fastfloat_unlikely (--countdown_ == 0) {
+          end_window();
+        }
+        return from_chars_result_t<UC>{start + length, std::errc()};
+      }
+      ++misses_;
+    }
+    return parse_fallback(first, last, value);
+  }
+
+  /** Whether a shape was learned and the kernel is in use. */
+  FASTFLOAT_CONSTEXPR20 bool has_shape() const noexcept {
+    return shape_.integer_digits != 0;
+  }
+
+  /** The integer digits of the learned shape, 0 without one. */
+  FASTFLOAT_CONSTEXPR20 size_t integer_digits() const noexcept {
+    return shape_.integer_digits;
+  }
+
+  /** The fraction digits of the learned shape. */
+  FASTFLOAT_CONSTEXPR20 size_t fraction_digits() const noexcept {
+    return shape_.fraction_digits;
+  }
+
+  /** The values parsed by the kernel. */
+  FASTFLOAT_CONSTEXPR20 size_t kernel_hits() const noexcept { return hits_; }
+
+  /** The values parsed by from_chars_float_advanced. */
+  FASTFLOAT_CONSTEXPR20 size_t fallbacks() const noexcept { return fallbacks_; }
+
+private:
+  // The kernel reads a sign, two runs of 8 bytes around the decimal point and
+  // the unit after the number, so it needs this many units of input.
+  static constexpr size_t window = 1 + 8 + 1 + 8 + 1;
+  // Values parsed with the kernel between two checks of its miss rate, or
+  // without a shape between two attempts to learn one, in sample sizes.
+  static constexpr size_t kernel_windows = 16;
+
+  FASTFLOAT_CONSTEXPR20 bool is_plain_format() const noexcept {
+    chars_format_t const format = chars_format_t(options_.format);
+    return (format & chars_format_t(chars_format::fixed)) != 0 &&
+           (format & chars_format_t(chars_format::hex)) == 0
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+           && (format & chars_format_t(detail::basic_json_fmt |
+                                       detail::basic_fortran_fmt)) == 0
+#endif
+        ;
+  }
+
+  FASTFLOAT_CONSTEXPR20 void relearn() noexcept {
+    shape_ = detail::column_shape{0, 0};
+    sampling_ = true;
+    countdown_ = sample_size_;
+    for (uint32_t &vote : votes_) {
+      vote = 0;
+    }
+  }
+
+  // Ends a sample, or a run with or without a kernel.
+  FASTFLOAT_CONSTEXPR20 void end_window() noexcept {
+    if (!sampling_) {
+      // From the kernel, too many misses, or from no shape, a new sample.
+      if (shape_.integer_digits == 0 || misses_ * 4 > countdown_window()) {
+        relearn();
+        misses_ = 0;
+        return;
+      }
+      misses_ = 0;
+      countdown_ = countdown_window();
+      return;
+    }
+    sampling_ = false;
+    countdown_ = countdown_window();
+    size_t best = 0;
+    for (size_t i = 1; i < detail::column_shape::count; ++i) {
+      if (votes_[i] > votes_[best]) {
+        best = i;
+      }
+    }
+    if (size_t(votes_[best]) * 2 <= sample_size_) {
+      return;
+    }
+    shape_.integer_digits =
+        uint8_t(best / (detail::column_shape::max_digits + 1) + 1);
+    shape_.fraction_digits =
+        uint8_t(best % (detail::column_shape::max_digits + 1));
+    // The digits are shifted to the top bytes of a 64-bit word and the bytes
+    // below them are filled with '0': parse_8_digits reads leading zeros.
+    integer_shift_ = uint8_t(8 * (8 - shape_.integer_digits));
+    integer_fill_ = shape_.integer_digits == 8
+                        ? 0
+                        : 0x3030303030303030 >> (8 * shape_.integer_digits);
+    fraction_shift_ = uint8_t(8 * (8 - shape_.fraction_digits));
+    fraction_fill_ = shape_.fraction_digits == 8
+                         ? 0
+                         : 0x3030303030303030 >> (8 * shape_.fraction_digits);
+    fraction_scale_ = uint32_t(powers_of_ten_uint64[shape_.fraction_digits]);
+    divisor_ = binary_format<T>::exact_power_of_ten(shape_.fraction_digits);
+  }
+
+  FASTFLOAT_CONSTEXPR20 size_t countdown_window() const noexcept {
+    return sample_size_ * kernel_windows;
+  }
+
+  // The kernel: the length of the number of the learned shape at `start`,
+  // or 0 if there is none or the unit after it could continue it.
+  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 size_t
+  parse_shape(UC const *const start, T &value) const noexcept {
+    UC const *p = start;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    bool const negative = (*p == UC('-'));
+    p += negative;
+#endif
+    uint64_t const integer =
+        (read_chars_to_unsigned<uint64_t>(p) << integer_shift_) |
+        integer_fill_;
+    p += shape_.integer_digits;
+    am_mant_t mantissa = parse_8_digits(integer);
+    bool digits = is_made_of_8_digits(integer);
+    if (shape_.fraction_digits != 0) {
+      uint64_t const fraction =
+          (read_chars_to_unsigned<uint64_t>(p + 1) << fraction_shift_) |
+          fraction_fill_;
+      digits &= (*p == options_.decimal_point) & is_made_of_8_digits(fraction);
+      mantissa = mantissa * fraction_scale_ + parse_8_digits(fraction);
+      p += 1 + shape_.fraction_digits;
+    }
+    UC const next = *p;
+    if (!digits || is_integer(next) || next == options_.decimal_point ||
+        (next | UC(0x20)) == UC('e')) {
+      return 0;
+    }
+    // the mantissa is below 2^53: the signed conversion is exact and shorter
+    value = static_cast<T>(static_cast<int64_t>(mantissa)) / divisor_;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (negative) {
+      value = -value;
+    }
+#endif
+    return size_t(p - start);
+  }
+
+  // The kernel near the end of the input, on a copy padded with zeros.
+  FASTFLOAT_CONSTEXPR20 size_t parse_shape_padded(UC const *first,
+                                                  UC const *last,
+                                                  T &value) const noexcept {
+    UC buffer[window] = {};
+    for (size_t i = 0; i != size_t(last - first); ++i) {
+      buffer[i] = first[i];
+    }
+    return parse_shape(buffer, value);
+  }
+
+  // Values the kernel does not take, and the sample.
+  FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+  parse_fallback(UC const *first, UC const *last, T &value) noexcept {
+    ++fallbacks_;
+    from_chars_result_t<UC> const answer =
+        from_chars_float_advanced(first, last, value, options_, rounding_);
+    if (sampling_ && answer.ec == std::errc()) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      if (chars_format_t(options_.format & chars_format::skip_white_space)) {
+        first = skip_spaces(first, answer.ptr);
+      }
+#endif
+      detail::column_shape shape;
+      if (detail::measure_shape<T>(first, answer.ptr, options_.decimal_point,
+                                   shape)) {
+        ++votes_[shape.index()];
+      }
+    }
+    if (learnable_ && --countdown_ == 0) {
+      end_window();
+    }
+    return answer;
+  }
+
+  parse_options_t<UC> options_;
+  detail::rounding_context rounding_;
+  size_t sample_size_;
+  bool learnable_;
+  bool sampling_ = false;
+  detail::column_shape shape_{0, 0};
+  uint8_t integer_shift_ = 0;
+  uint8_t fraction_shift_ = 0;
+  uint32_t fraction_scale_ = 1;
+  uint64_t integer_fill_ = 0;
+  uint64_t fraction_fill_ = 0;
+  T divisor_ = T(1);
+  size_t countdown_ = 0;
+  size_t misses_ = 0;
+  size_t hits_ = 0;
+  size_t fallbacks_ = 0;
+  uint32_t votes_[detail::column_shape::count] = {};
+};
+
+} // namespace fast_float
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef FASTFLOAT_DECIMAL_BID_H
+#define FASTFLOAT_DECIMAL_BID_H
+
+#include <cstdint>
+
+#include "float_common.h"
+#include "ascii_number.h"
+
+namespace fast_float {
+
+// Parameters of the IEEE 754 decimal interchange formats. The exponents are
+// those of the integer coefficient: value = coefficient * 10^exponent.
+template <typename T> struct decimal_bid_format;
+
+template <> struct decimal_bid_format<decimal64> {
+  static constexpr am_digits digits() { return 16; }
+  static constexpr int64_t min_exponent() { return -398; }
+  static constexpr int64_t max_exponent() { return 369; }
+
+  static FASTFLOAT_CONSTEXPR14 void store(bool const negative,
+                                          value128 const coefficient,
+                                          int64_t const exponent,
+                                          decimal64 &value) noexcept {
+    uint64_t const sign = uint64_t(negative) << 63;
+    uint64_t const biased = uint64_t(exponent - min_exponent());
+    if (coefficient.low < (uint64_t(1) << 53)) {
+      value.bits = sign | (biased << 53) | coefficient.low;
+    } else {
+      // the coefficient has the implicit leading bits 100
+      value.bits = sign | (uint64_t(3) << 61) | (biased << 51) |
+                   (coefficient.low & ((uint64_t(1) << 51) - 1));
+    }
+  }
+
+  static FASTFLOAT_CONSTEXPR14 void special(bool const negative, bool const nan,
+                                            decimal64 &value) noexcept {
+    value.bits = (uint64_t(negative) << 63) |
+                 (nan ? uint64_t(0x7c00000000000000)
+                      : uint64_t(0x7800000000000000));
+  }
+};
+
+template <> struct decimal_bid_format<decimal128> {
+  static constexpr am_digits digits() { return 34; }
+  static constexpr int64_t min_exponent() { return -6176; }
+  static constexpr int64_t max_exponent() { return 6111; }
+
+  // 10^34 < 2^113, so the coefficient always fits the short encoding.
+  static FASTFLOAT_CONSTEXPR14 void store(bool const negative,
+                                          value128 const coefficient,
+                                          int64_t const exponent,
+                                          decimal128 &value) noexcept {
+    uint64_t const biased = uint64_t(exponent - min_exponent());
+    value.low = coefficient.low;
+    value.high = (uint64_t(negative) << 63) | (biased << 49) | coefficient.high;
+  }
+
+  static FASTFLOAT_CONSTEXPR14 void special(bool const negative, bool const nan,
+                                            decimal128 &value) noexcept {
+    value.low = 0;
+    value.high = (uint64_t(negative) << 63) |
+                 (nan ? uint64_t(0x7c00000000000000)
+                      : uint64_t(0x7800000000000000));
+  }
+};
+
+// Number of decimal digits of a non-zero 128-bit value below 10^38.
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 am_digits
+decimal_digit_count(value128 v) noexcept {
+  am_digits count = 0;
+  value128 bound(1, 0);
+  while (v.high > bound.high || (v.high == bound.high && v.low >= bound.low)) {
+    multiply_add(bound, 10, 0);
+    ++count;
+  }
+  return count;
+}
+
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
+increment(value128 &v) noexcept {
+  ++v.low;
+  v.high += uint64_t(v.low == 0);
+}
+
+// Rounds the parsed number to a coefficient of at most `digits` digits whose
+// exponent is at least `min_exponent`, to nearest with ties to even. The
+// mantissa is exact unless pns.too_many_digits is set, in which case the
+// digits are read back from the integer/fraction spans.
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 value128
+round_decimal_coefficient(parsed_number_string_t<UC> const &pns,
+                          am_digits const digits, int64_t const min_exponent,
+                          int64_t &exponent) noexcept {
+  value128 coefficient;
+  bool round_up;
+  if (!pns.too_many_digits) {
+    exponent = int64_t(pns.exponent);
+    if (pns.mantissa == 0) {
+      return coefficient;
+    }
+    int64_t const count =
+        int64_t(decimal_digit_count(value128(pns.mantissa, 0)));
+    int64_t drop = count - int64_t(digits);
+    if (min_exponent - exponent > drop) {
+      drop = min_exponent - exponent;
+    }
+    if (drop <= 0) {
+      coefficient.low = pns.mantissa;
+      return coefficient;
+    }
+    exponent += drop;
+    if (drop > count) {
+      // below half of the smallest step, rounds to zero
+      return coefficient;
+    }
+    uint64_t const pow = powers_of_ten_uint64[drop];
+    uint64_t const rest = pns.mantissa % pow;
+    coefficient.low = pns.mantissa / pow;
+    round_up = rest > pow / 2 || (rest == pow / 2 && (coefficient.low & 1));
+  } else {
+    significant_digits<UC> walker(pns);
+    int64_t const count = int64_t(walker.remaining());
+    // the truncated mantissa holds exactly the first 19 significant digits
+    exponent = int64_t(pns.exponent) + 19 - count;
+    int64_t drop = count - int64_t(digits);
+    if (min_exponent - exponent > drop) {
+      drop = min_exponent - exponent;
+    }
+    if (drop <= 0) {
+      for (int64_t i = 0; i != count; ++i) {
+        multiply_add(coefficient, 10, walker.next());
+      }
+      return coefficient;
+    }
+    exponent += drop;
+    if (drop > count) {
+      return coefficient;
+    }
+    for (int64_t i = 0; i != count - drop; ++i) {
+      multiply_add(coefficient, 10, walker.next());
+    }
+    uint8_t const round_digit = walker.next();
+    round_up = round_digit > 5 ||
+               (round_digit == 5 &&
+                (walker.nonzero_tail() || (coefficient.low & 1)));
+  }
+  if (round_up) {
+    increment(coefficient);
+    if (decimal_digit_count(coefficient) > digits) {
+      // 99..9 rounded up to 10^digits
+      coefficient = value128(1, 0);
+      for (am_digits i = 1; i != digits; ++i) {
+        multiply_add(coefficient, 10, 0);
+      }
+      ++exponent;
+    }
+  }
+  return coefficient;
+}
+
+// Converts a parsed number to a BID encoded decimal64 or decimal128 value,
+// rounding to nearest with ties to even. The exponent of exact results is
+// preserved ("1.50" keeps the coefficient 150). Out of range values become
+// infinity or zero and std::errc::result_out_of_range is returned.
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 std::errc
+to_decimal_bid(parsed_number_string_t<UC> const &pns, T &value) noexcept {
+  using format = decimal_bid_format<T>;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  bool const negative = pns.negative;
+#else
+  bool const negative = false;
+#endif
+  int64_t exponent;
+  value128 coefficient = round_decimal_coefficient(
+      pns, format::digits(), format::min_exponent(), exponent);
+  bool const zero = coefficient.low == 0 && coefficient.high == 0;
+  if (zero && exponent < format::min_exponent()) {
+    exponent = format::min_exponent();
+  } else if (exponent > format::max_exponent()) {
+    if (zero) {
+      exponent = format::max_exponent();
+    } else {
+      // pad the coefficient with zeros to lower the exponent
+      am_digits count = decimal_digit_count(coefficient);
+      while (exponent > format::max_exponent() && count < format::digits()) {
+        multiply_add(coefficient, 10, 0);
+        --exponent;
+        ++count;
+      }
+      if (exponent > format::max_exponent()) {
+        format::special(negative, false, value);
+        return std::errc::result_out_of_range;
+      }
+    }
+  }
+  format::store(negative, coefficient, exponent, value);
+  if (zero && (pns.mantissa != 0 || pns.too_many_digits)) {
+    return std::errc::result_out_of_range;
+  }
+  return std::errc();
+}
+
+} // namespace fast_float
+
+#endif
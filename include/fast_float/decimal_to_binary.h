@@ -12,20 +12,99 @@
 
 namespace fast_float {
 
+#ifdef FASTFLOAT_COMPACT_POWERS_TABLE
+// The entry of powers::power_of_five_128 for 5**q, high word first, rebuilt
+// from compact_powers.
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 value128
+compact_power_of_five_128(am_pow_t const q) noexcept {
+  am_pow_t const index = q - powers::smallest_power_of_five;
+  am_pow_t const base = 2 * (index / compact_powers::step);
+  uint64_t const small =
+      compact_powers::small_power_of_five[index % compact_powers::step];
+  value128 const hi =
+      full_multiplication(compact_powers::power_of_five_128[base], small);
+  value128 const lo =
+      full_multiplication(compact_powers::power_of_five_128[base + 1], small);
+  // the 192-bit product is hi.high:middle:lo.low
+  uint64_t const middle = hi.low + lo.high;
+  uint64_t const top = hi.high + uint64_t(middle < lo.high);
+  // both factors have their most significant bit set: at most one shift
+  uint64_t const shift = 1 - (top >> 63);
+  value128 answer((middle << shift) | ((lo.low >> 63) & shift),
+                  (top << shift) | ((middle >> 63) & shift));
+  // the correction, from -1 to +2, is stored plus one
+  uint64_t const correction =
+      (compact_powers::correction[index / 32] >> (2 * (index % 32))) & 3;
+  uint64_t const low = answer.low + correction - 1;
+  if (correction == 0) {
+    answer.high -= uint64_t(answer.low == 0);
+  } else {
+    answer.high += uint64_t(low < answer.low);
+  }
+  answer.low = low;
+  return answer;
+}
+#endif
+
+namespace detail {
+// The 128-bit approximations of 5**q in powers::power_of_five_128.
+struct wide_powers_of_five {
+  static fastfloat_really_inline FASTFLOAT_CONSTEXPR20 uint64_t
+  high(am_pow_t const q) noexcept {
+#ifdef FASTFLOAT_COMPACT_POWERS_TABLE
+    return compact_power_of_five_128(q).high;
+#else
+    return powers::power_of_five_128[2 * (q - powers::smallest_power_of_five)];
+#endif
+  }
+
+  static fastfloat_really_inline FASTFLOAT_CONSTEXPR20 uint64_t
+  low(am_pow_t const q) noexcept {
+#ifdef FASTFLOAT_COMPACT_POWERS_TABLE
+    return compact_power_of_five_128(q).low;
+#else
+    return powers::power_of_five_128[2 * (q - powers::smallest_power_of_five) +
+                                     1];
+#endif
+  }
+};
+
+// The same approximations for the decimal exponents of binary32.
+struct float_powers_of_five {
+  static fastfloat_really_inline FASTFLOAT_CONSTEXPR20 uint64_t
+  high(am_pow_t const q) noexcept {
+    return float_powers::power_of_five_high[q -
+                                            float_powers::smallest_power_of_five];
+  }
+
+  static fastfloat_really_inline FASTFLOAT_CONSTEXPR20 uint64_t
+  low(am_pow_t const q) noexcept {
+    return float_powers::power_of_five_low[q -
+                                           float_powers::smallest_power_of_five];
+  }
+};
+
+// float_powers_of_five when it covers the decimal exponents of binary.
+template <typename binary>
+using powers_of_five_for = typename std::conditional<
+    (binary::smallest_power_of_ten() >= float_powers::smallest_power_of_five &&
+     binary::largest_power_of_ten() <= float_powers::largest_power_of_five),
+    float_powers_of_five, wide_powers_of_five>::type;
+} // namespace detail
+
 // This will compute or rather approximate w * 5**q and return a pair of 64-bit
 // words approximating the result, with the "high" part corresponding to the
 // most significant bits and the low part corresponding to the least significant
-// bits.
+// bits. The powers of five come from the smallest table that covers binary.
 //
-template <am_bits_t bit_precision>
+template <am_bits_t bit_precision, typename binary = binary_format<double>>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 value128
 compute_product_approximation(am_pow_t q, am_mant_t w) noexcept {
-  am_pow_t const index = 2 * (q - powers::smallest_power_of_five);
+  using table = detail::powers_of_five_for<binary>;
   // For small values of q, e.g., q in [0,27], the answer is always exact
   // because The line value128 firstproduct = full_multiplication(w,
-  // power_of_five_128[index]); gives the exact answer.
-  value128 firstproduct =
-      full_multiplication(w, powers::power_of_five_128[index]);
+  // table::high(q)); gives the exact answer.
+  value128 firstproduct = full_multiplication(w, table::high(q));
   static_assert((bit_precision >= 0) && (bit_precision <= 64),
                 " precision should be in [0,64]");
   constexpr uint64_t precision_mask =
@@ -37,8 +116,7 @@ compute_product_approximation(am_pow_t q, am_mant_t w) noexcept {
     // regarding the second product, we only need secondproduct.high, but our
     // expectation is that the compiler will optimize this extra work away if
     // needed.
-    value128 const secondproduct =
-        full_multiplication(w, powers::power_of_five_128[index + 1]);
+    value128 const secondproduct = full_multiplication(w, table::low(q));
     firstproduct.low += secondproduct.high;
 
     if (secondproduct.high > firstproduct.low) {
@@ -91,56 +169,21 @@ compute_error(am_pow_t q, am_mant_t w) noexcept {
   auto const lz = leading_zeroes(w);
   w <<= lz;
   value128 const product =
-      compute_product_approximation<binary::mantissa_explicit_bits() + 3>(q, w);
+      compute_product_approximation<binary::mantissa_explicit_bits() + 3,
+                                    binary>(q, w);
   return compute_error_scaled<binary>(q, product.high, lz);
 }
 
-// Computers w * 10 ** q.
-// The returned value should be a valid number that simply needs to be
-// packed. However, in some very rare cases, the computation will fail. In such
-// cases, we return an adjusted_mantissa with a negative power of 2: the caller
-// should recompute in such cases.
+namespace detail {
+// The rounding half of compute_float: w * 10 ** q, where w had lz leading
+// zeroes, is approximated by `product`. The product may have been computed
+// with more precision than binary needs: the second multiplication only makes
+// it closer to the exact product.
 template <typename binary>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa
-compute_float(am_pow_t q, am_mant_t w) noexcept {
+round_product(am_pow_t const q, limb_t const lz,
+              value128 const product) noexcept {
   adjusted_mantissa answer;
-  if ((w == 0) || (q < binary::smallest_power_of_ten())) {
-    // we want to get zero:
-    answer.power2 = 0;
-    answer.mantissa = 0;
-    return answer;
-  }
-  if (q > binary::largest_power_of_ten()) {
-    // we want to get infinity:
-    answer.power2 = binary::infinite_power();
-    answer.mantissa = 0;
-    return answer;
-  }
-
-  // At this point in time q is in [powers::smallest_power_of_five,
-  // powers::largest_power_of_five].
-
-  // We want the most significant bit of i to be 1. Shift if needed.
-  auto const lz = leading_zeroes(w);
-  w <<= lz;
-
-  // The required precision is binary::mantissa_explicit_bits() + 3 because
-  // 1. We need the implicit bit
-  // 2. We need an extra bit for rounding purposes
-  // 3. We might lose a bit due to the "upperbit" routine (result too small,
-  // requiring a shift)
-
-  value128 const product =
-      compute_product_approximation<binary::mantissa_explicit_bits() + 3>(q, w);
-  // The computed 'product' is always sufficient.
-  // Mathematical proof:
-  // Noble Mushtak and Daniel Lemire, Fast Number Parsing Without Fallback (to
-  // appear) See script/mushtak_lemire.py
-
-  // The "compute_product_approximation" function can be slightly slower than a
-  // branchless approach: value128 product = compute_product(q, w); but in
-  // practice, we can win big with the compute_product_approximation if its
-  // additional branch is easily predicted. Which is best is data specific.
   auto const upperbit = static_cast<am_bits_t>(product.high >> 63);
   auto const shift = static_cast<am_bits_t>(
       upperbit + 64 - binary::mantissa_explicit_bits() - 3);
@@ -164,10 +207,20 @@ compute_float(am_pow_t q, am_mant_t w) noexcept {
     }
     // We have a subnormal number. We need to shift the mantissa to the right
     // next line is safe because -answer.power2 + 1 < 64
-    answer.mantissa >>= -answer.power2 + 1;
+    auto const subnormal_shift = static_cast<am_bits_t>(-answer.power2 + 1);
+    bool const dropped_zeroes =
+        (answer.mantissa & ((am_mant_t(1) << subnormal_shift) - 1)) == 0;
+    answer.mantissa >>= subnormal_shift;
     // Thankfully, we can't have both "round-to-even" and subnormals because
     // "round-to-even" only occurs for powers close to 0 in the 32-bit and
     // and 64-bit case (with no more than 19 digits).
+    // The 16-bit formats are the exception: a binary16 subnormal halfway point
+    // such as 6.5 * 2^-24 has few enough digits that 5^-q fits in 64 bits.
+    if (binary::mantissa_explicit_bits() < 23 && (product.low <= 1) &&
+        (q >= -27) && dropped_zeroes && ((answer.mantissa & 3) == 1) &&
+        ((product.high >> shift) << shift) == product.high) {
+      answer.mantissa &= ~am_mant_t(1); // flip it so that we do not round up
+    }
     answer.mantissa += (answer.mantissa & 1); // round up
     answer.mantissa >>= 1;
     // There is a weird scenario where we don't have a subnormal but just.
@@ -217,6 +270,190 @@ compute_float(am_pow_t q, am_mant_t w) noexcept {
 
   return answer;
 }
+} // namespace detail
+
+// Computers w * 10 ** q.
+// The returned value should be a valid number that simply needs to be
+// packed. However, in some very rare cases, the computation will fail. In such
+// cases, we return an adjusted_mantissa with a negative power of 2: the caller
+// should recompute in such cases.
+template <typename binary>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa
+compute_float(am_pow_t q, am_mant_t w) noexcept {
+  adjusted_mantissa answer;
+  if ((w == 0) || (q < binary::smallest_power_of_ten())) {
+    // we want to get zero:
+    answer.power2 = 0;
+    answer.mantissa = 0;
+    return answer;
+  }
+  if (q > binary::largest_power_of_ten()) {
+    // we want to get infinity:
+    answer.power2 = binary::infinite_power();
+    answer.mantissa = 0;
+    return answer;
+  }
+
+  // At this point in time q is in [powers::smallest_power_of_five,
+  // powers::largest_power_of_five].
+
+  // We want the most significant bit of i to be 1. Shift if needed.
+  auto const lz = leading_zeroes(w);
+  w <<= lz;
+
+  // The required precision is binary::mantissa_explicit_bits() + 3 because
+  // 1. We need the implicit bit
+  // 2. We need an extra bit for rounding purposes
+  // 3. We might lose a bit due to the "upperbit" routine (result too small,
+  // requiring a shift)
+
+  value128 const product =
+      compute_product_approximation<binary::mantissa_explicit_bits() + 3,
+                                    binary>(q, w);
+  // The computed 'product' is always sufficient.
+  // Mathematical proof:
+  // Noble Mushtak and Daniel Lemire, Fast Number Parsing Without Fallback (to
+  // appear) See script/mushtak_lemire.py
+
+  // The "compute_product_approximation" function can be slightly slower than a
+  // branchless approach: value128 product = compute_product(q, w); but in
+  // practice, we can win big with the compute_product_approximation if its
+  // additional branch is easily predicted. Which is best is data specific.
+  return detail::round_product<binary>(q, lz, product);
+}
+
+// Computes w * 10 ** q in two formats at once, e.g., double and float. The
+// product is computed once, with the precision of the wider format, which is
+// also enough to round the narrower one: each result is the one compute_float
+// would give.
+template <typename wide, typename narrow>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
+compute_float_pair(am_pow_t q, am_mant_t w, adjusted_mantissa &wide_answer,
+                   adjusted_mantissa &narrow_answer) noexcept {
+  static_assert(wide::mantissa_explicit_bits() >=
+                        narrow::mantissa_explicit_bits() &&
+                    wide::smallest_power_of_ten() <=
+                        narrow::smallest_power_of_ten() &&
+                    wide::largest_power_of_ten() >=
+                        narrow::largest_power_of_ten(),
+                "the wide format must include the narrow one");
+  if ((w == 0) || (q < wide::smallest_power_of_ten()) ||
+      (q > wide::largest_power_of_ten())) {
+    wide_answer = compute_float<wide>(q, w);
+    narrow_answer = compute_float<narrow>(q, w);
+    return;
+  }
+  auto const lz = leading_zeroes(w);
+  w <<= lz;
+  value128 const product =
+      compute_product_approximation<wide::mantissa_explicit_bits() + 3, wide>(
+          q, w);
+  wide_answer = detail::round_product<wide>(q, lz, product);
+  if (q < narrow::smallest_power_of_ten()) {
+    narrow_answer.power2 = 0;
+    narrow_answer.mantissa = 0;
+  } else if (q > narrow::largest_power_of_ten()) {
+    narrow_answer.power2 = narrow::infinite_power();
+    narrow_answer.mantissa = 0;
+  } else {
+    narrow_answer = detail::round_product<narrow>(q, lz, product);
+  }
+}
+
+namespace detail {
+// w * 10 ** q * 2 ** power2_offset, rounded toward zero. Unless q is in
+// [0,27], where it is exact, the product is off by less than two units of its
+// low word: when it is that close to a representable value, we cannot tell
+// the truncated value and return a negative power of 2. (Without the second
+// product, the error is below one unit of the high word but upward, and the
+// high word cannot end with all ones.)
+template <typename binary>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa
+compute_truncated_product(am_pow_t q, am_mant_t w, am_pow_t power2_offset,
+                          bool &exact) noexcept {
+  adjusted_mantissa answer;
+  auto const lz = leading_zeroes(w);
+  w <<= lz;
+  value128 const product =
+      compute_product_approximation<binary::mantissa_explicit_bits() + 3,
+                                    binary>(q, w);
+  auto const upperbit = static_cast<am_bits_t>(product.high >> 63);
+  // the bits below the significand, including the rounding bit of
+  // compute_float, and the extra bits of a subnormal.
+  am_pow_t dropped_bits = upperbit + 64 - binary::mantissa_explicit_bits() - 2;
+  answer.power2 = detail::power(q) + upperbit - lz -
+                  binary::minimum_exponent() + power2_offset;
+  if (answer.power2 <= 0) {
+    dropped_bits += 1 - answer.power2;
+  }
+  am_mant_t const dropped_mask =
+      (dropped_bits >= 64) ? ~am_mant_t(0)
+                           : (am_mant_t(1) << dropped_bits) - 1;
+  am_mant_t const dropped = product.high & dropped_mask;
+  if (q >= 0 && q <= 27) {
+    exact = (dropped == 0) && (product.low == 0);
+  } else if ((dropped == 0 && product.low <= 1) ||
+             (dropped == dropped_mask && product.low >= ~am_mant_t(2))) {
+    answer.power2 = -1;
+    return answer;
+  } else {
+    exact = false;
+  }
+  answer.mantissa = (dropped_bits >= 64) ? 0 : product.high >> dropped_bits;
+  if (answer.power2 <= 0) {
+    // a subnormal, the truncated mantissa has no hidden bit.
+    answer.power2 = 0;
+    return answer;
+  }
+  answer.mantissa &= ~(am_mant_t(1) << binary::mantissa_explicit_bits());
+  if (answer.power2 >= binary::infinite_power()) {
+    // the largest finite value
+    answer.power2 = binary::infinite_power() - 1;
+    answer.mantissa = (am_mant_t(1) << binary::mantissa_explicit_bits()) - 1;
+    exact = false;
+  }
+  return answer;
+}
+} // namespace detail
+
+// Computes w * 10 ** q rounded toward zero, and sets `exact` when the result
+// is w * 10 ** q itself. A value beyond the largest finite value is truncated
+// to it. As with compute_float, a negative power of 2 tells the caller to
+// compare the digits: this only happens when w * 10 ** q is very close to a
+// representable value.
+template <typename binary>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa
+compute_float_toward_zero(am_pow_t q, am_mant_t w, bool &exact) noexcept {
+  adjusted_mantissa answer;
+  exact = (w == 0);
+  if ((w == 0) || (q < binary::smallest_power_of_ten())) {
+    // we want to get zero:
+    answer.power2 = 0;
+    answer.mantissa = 0;
+    return answer;
+  }
+  if (q > binary::largest_power_of_ten()) {
+    // we want to get the largest finite value:
+    answer.power2 = binary::infinite_power() - 1;
+    answer.mantissa = (am_mant_t(1) << binary::mantissa_explicit_bits()) - 1;
+    return answer;
+  }
+  answer = detail::compute_truncated_product<binary>(q, w, 0, exact);
+  // A short decimal such as 0.25 is a binary number: its dropped bits are all
+  // zeroes, so it always lands here. w * 10 ** q is a binary number exactly
+  // when w is a multiple of 5 ** -q, which requires q >= -27 since w < 2**64.
+  if (answer.power2 < 0 && q < 0 && q >= -27) {
+    am_mant_t power_of_five = 1;
+    for (am_pow_t i = q; i < 0; ++i) {
+      power_of_five *= 5;
+    }
+    if (w % power_of_five == 0) {
+      answer = detail::compute_truncated_product<binary>(0, w / power_of_five,
+                                                         q, exact);
+    }
+  }
+  return answer;
+}
 
 } // namespace fast_float
 
@@ -11,28 +11,6 @@
 
 namespace fast_float {
 
-// 1e0 to 1e19
-constexpr static uint64_t powers_of_ten_uint64[] = {1UL,
-                                                    10UL,
-                                                    100UL,
-                                                    1000UL,
-                                                    10000UL,
-                                                    100000UL,
-                                                    1000000UL,
-                                                    10000000UL,
-                                                    100000000UL,
-                                                    1000000000UL,
-                                                    10000000000UL,
-                                                    100000000000UL,
-                                                    1000000000000UL,
-                                                    10000000000000UL,
-                                                    100000000000000UL,
-                                                    1000000000000000UL,
-                                                    10000000000000000UL,
-                                                    100000000000000000UL,
-                                                    1000000000000000000UL,
-                                                    10000000000000000000UL};
-
 // calculate the exponent, in scientific notation, of the number.
 // this algorithm is not even close to optimized, but it has no practical
 // effect on performance: in order to have a faster algorithm, we'd need
@@ -169,22 +147,7 @@ round_down(adjusted_mantissa &am, am_pow_t shift) noexcept {
 template <typename UC>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
 skip_zeros(UC const *&first, UC const *last) noexcept {
-  if (!is_constant_evaluated()) {
-    while (std::distance(first, last) >= int_cmp_len<UC>()) {
-      uint64_t val;
-      std::memcpy(&val, first, sizeof(uint64_t));
-      if (val != int_cmp_zeros<UC>()) {
-        break;
-      }
-      first += int_cmp_len<UC>();
-    }
-  }
-  while (first != last) {
-    if (*first != UC('0')) {
-      break;
-    }
-    ++first;
-  }
+  first = skip_zero_digits(first, last);
 }
 
 // determine if any non-zero digits were truncated.
@@ -192,24 +155,7 @@ skip_zeros(UC const *&first, UC const *last) noexcept {
 template <typename UC>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
 is_truncated(UC const *first, UC const *last) noexcept {
-  // do 8-bit optimizations, can just compare to 8 literal 0s.
-  if (!is_constant_evaluated()) {
-    while (std::distance(first, last) >= int_cmp_len<UC>()) {
-      uint64_t val;
-      std::memcpy(&val, first, sizeof(uint64_t));
-      if (val != int_cmp_zeros<UC>()) {
-        return true;
-      }
-      first += int_cmp_len<UC>();
-    }
-  }
-  while (first != last) {
-    if (*first != UC('0')) {
-      return true;
-    }
-    ++first;
-  }
-  return false;
+  return skip_zero_digits(first, last) != last;
 }
 
 template <typename UC>
@@ -220,8 +166,10 @@ is_truncated(span<UC const> s) noexcept {
 
 #if defined(FASTFLOAT_64BIT_LIMB) && defined(FASTFLOAT_X86_SIMD) &&            \
     FASTFLOAT_X86_SIMD >= 31
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 void
-parse_sixteen_digits(char const *&p, limb &value, am_digits &counter,
+// Not constexpr: the SIMD kernel isn't, and the callers only use it at runtime.
+template <typename UC>
+fastfloat_really_inline void
+parse_sixteen_digits(UC const *&p, limb &value, am_digits &counter,
                      am_digits &count) noexcept {
   value = parse_16_digits(p);
   p += 16;
@@ -299,7 +247,8 @@ parse_mantissa(bigint &result, const parsed_number_string_t<UC> &num) noexcept {
   while (p != pend) {
 #if defined(FASTFLOAT_64BIT_LIMB) && defined(FASTFLOAT_X86_SIMD) &&            \
     FASTFLOAT_X86_SIMD >= 31
-    if FASTFLOAT_CONSTEXPR17 (sizeof(UC) == 1) {
+    if FASTFLOAT_CONSTEXPR17 (std::is_same<UC, char>::value ||
+                              has_simd_opt<UC>()) {
       if (!is_constant_evaluated() && (std::distance(p, pend) >= 16) &&
           (step - counter >= 16) && (max_digits - digits >= 16)) {
         parse_sixteen_digits(p, value, counter, digits);
@@ -346,6 +295,16 @@ parse_mantissa(bigint &result, const parsed_number_string_t<UC> &num) noexcept {
     }
     // process all digits, in increments of step per loop
     while (p != pend) {
+#if defined(FASTFLOAT_64BIT_LIMB) && defined(FASTFLOAT_X86_SIMD) &&            \
+    FASTFLOAT_X86_SIMD >= 31
+      if FASTFLOAT_CONSTEXPR17 (std::is_same<UC, char>::value ||
+                                has_simd_opt<UC>()) {
+        if (!is_constant_evaluated() && (std::distance(p, pend) >= 16) &&
+            (step - counter >= 16) && (max_digits - digits >= 16)) {
+          parse_sixteen_digits(p, value, counter, digits);
+        }
+      }
+#endif
       while ((std::distance(p, pend) >= 8) && (step - counter >= 8) &&
              (max_digits - digits >= 8)) {
         parse_eight_digits(p, value, counter, digits);
@@ -488,6 +447,71 @@ inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa digit_comp(
   }
 }
 
+// round the significant digits toward zero, given `am`, the float they round
+// to (as returned by digit_comp). we create a big-integer representation of
+// that float, scale it and the actual digits to the same power of 2 and 5,
+// and compare them: the result is `am` unless the digits are below it. if
+// they are equal, `exact` is set. a result that rounds to infinity is
+// truncated to the largest finite value.
+template <typename T, typename UC>
+inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa
+digit_comp_toward_zero(parsed_number_string_t<UC> const &num,
+                       adjusted_mantissa am, bool &exact) noexcept {
+  exact = false;
+  if (am.power2 == binary_format<T>::infinite_power()) {
+    am.power2 = binary_format<T>::infinite_power() - 1;
+    am.mantissa = binary_format<T>::mantissa_mask();
+    return am;
+  }
+  if (am.power2 == 0 && am.mantissa == 0) {
+    // the digits are not zero, they are below the smallest subnormal
+    return am;
+  }
+  T value;
+  to_float(
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      false,
+#endif
+      am, value);
+  adjusted_mantissa const theor = to_extended(value);
+  bigint theor_digits(theor.mantissa);
+
+  am_pow_t const sci_exp = scientific_exponent(num.mantissa, num.exponent);
+  bigint real_digits;
+  // truncated digits are rounded up with an extra digit, which keeps them
+  // strictly between two values with as many digits as the float needs.
+  am_digits const digits = parse_mantissa<T, UC>(real_digits, num);
+  am_pow_t const real_exp = sci_exp + 1 - static_cast<am_pow_t>(digits);
+
+  // `m * 10^e` and `n * 2^f` have the same scale as `m * 5^e` and
+  // `n * 2^(f-e)` for a positive `e`, and as `m` and `n * 5^-e * 2^(f-e)`
+  // for a negative one.
+  if (real_exp > 0) {
+    FASTFLOAT_ASSERT(real_digits.pow5(real_exp));
+  } else if (real_exp < 0) {
+    FASTFLOAT_ASSERT(theor_digits.pow5(-real_exp));
+  }
+  auto const pow2_exp = theor.power2 - real_exp;
+  if (pow2_exp > 0) {
+    FASTFLOAT_ASSERT(theor_digits.pow2(pow2_exp));
+  } else if (pow2_exp < 0) {
+    FASTFLOAT_ASSERT(real_digits.pow2(-pow2_exp));
+  }
+
+  auto const ord = real_digits.compare(theor_digits);
+  exact = (ord == 0);
+  if (ord < 0) {
+    // the float before `am`
+    if (am.mantissa == 0) {
+      --am.power2;
+      am.mantissa = binary_format<T>::mantissa_mask();
+    } else {
+      --am.mantissa;
+    }
+  }
+  return am;
+}
+
 } // namespace fast_float
 
 #endif
@@ -0,0 +1,572 @@
+#ifndef FASTFLOAT_EXTENDED_FLOAT_H
+#define FASTFLOAT_EXTENDED_FLOAT_H
+
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "bigint.h"
+
+namespace fast_float {
+
+// number of bits in the big integers used for the extended formats. the
+// largest is the quotient of `log2(10**11569)`, the significant digits of a
+// binary128 halfway point, by `log2(5**16536)`, aligned on each other, or
+// ~38500 bits, plus a few limbs of headroom for the multiplications.
+constexpr bigint_bits_t extended_bigint_bits = 38912;
+
+typedef basic_bigint<extended_bigint_bits / limb_bits> extended_bigint;
+
+// Number of bits of the significand of an extended floating-point type,
+// including the leading bit.
+template <typename T>
+struct extended_float_digits : std::integral_constant<int32_t, 113> {};
+
+template <>
+struct extended_float_digits<long double>
+    : std::integral_constant<int32_t, LDBL_MANT_DIG> {};
+
+// Parameters of the binary formats wider than double. The exponents are those
+// of the least significant bit of the significand: value = m * 2^exponent.
+template <typename T, int32_t digits = extended_float_digits<T>::value>
+struct extended_binary_format;
+
+// an exactly representable power of ten, up to max_exponent_fast_path().
+template <typename T>
+inline T extended_power_of_ten(am_pow_t power) noexcept {
+  T value = T(1);
+  for (; power > 19; power -= 19) {
+    value *= T(powers_of_ten_uint64[19]);
+  }
+  return value * T(powers_of_ten_uint64[power]);
+}
+
+// The x87 80-bit extended format: 64-bit significand with an explicit
+// integer bit, followed by the 16-bit sign and exponent.
+template <typename T> struct extended_binary_format<T, 64> {
+  static constexpr int32_t mantissa_digits() { return 64; }
+  static constexpr int32_t min_exponent() { return -16445; }
+  static constexpr int32_t smallest_power_of_ten() { return -4951; }
+  static constexpr int32_t largest_power_of_ten() { return 4932; }
+  static constexpr am_digits max_digits() { return 11520; }
+  static constexpr am_pow_t max_exponent_fast_path() { return 27; }
+
+  // the x87 precision control may be set to round to double, as some
+  // operating systems do by default.
+  static bool full_precision() noexcept {
+    volatile T one = T(1);
+    return one + T(LDBL_EPSILON) != T(1);
+  }
+
+  static void store(bool const negative, value128 const mantissa,
+                    uint32_t const biased_exponent, T &value) noexcept {
+    uint16_t const sign_exponent =
+        uint16_t((uint32_t(negative) << 15) | biased_exponent);
+    unsigned char bytes[sizeof(T)] = {};
+    std::memcpy(bytes, &mantissa.low, sizeof(uint64_t));
+    std::memcpy(bytes + sizeof(uint64_t), &sign_exponent, sizeof(uint16_t));
+    std::memcpy(&value, bytes, sizeof(T));
+  }
+
+  static void infinity(bool const negative, T &value) noexcept {
+    store(negative, value128(uint64_t(1) << 63, 0), 0x7fff, value);
+  }
+};
+
+// The IEEE 754 binary128 format: 113-bit significand with a hidden bit.
+template <typename T> struct extended_binary_format<T, 113> {
+  static constexpr int32_t mantissa_digits() { return 113; }
+  static constexpr int32_t min_exponent() { return -16494; }
+  static constexpr int32_t smallest_power_of_ten() { return -4966; }
+  static constexpr int32_t largest_power_of_ten() { return 4932; }
+  static constexpr am_digits max_digits() { return 11568; }
+  static constexpr am_pow_t max_exponent_fast_path() { return 48; }
+
+  static constexpr bool full_precision() noexcept { return true; }
+
+  static void store(bool const negative, value128 const mantissa,
+                    uint32_t const biased_exponent, T &value) noexcept {
+    static_assert(sizeof(T) == 2 * sizeof(uint64_t), "unexpected size");
+    uint64_t const high = (uint64_t(negative) << 63) |
+                          (uint64_t(biased_exponent) << 48) |
+                          (mantissa.high & ((uint64_t(1) << 48) - 1));
+#if FASTFLOAT_IS_BIG_ENDIAN
+    uint64_t const words[2] = {high, mantissa.low};
+#else
+    uint64_t const words[2] = {mantissa.low, high};
+#endif
+    std::memcpy(&value, words, sizeof(T));
+  }
+
+  static void infinity(bool const negative, T &value) noexcept {
+    store(negative, value128(), 0x7fff, value);
+  }
+};
+
+// `count` bits of a big integer starting at bit `start`, and whether any bit
+// below `start` is set.
+inline value128 extract_bits(extended_bigint const &x, bigint_bits_t const start,
+                             int32_t const count, bool &truncated) noexcept {
+  bigint_limbs_t const first = bigint_limbs_t(start / limb_bits);
+  limb_t const offset = limb_t(start % limb_bits);
+  truncated = offset != 0 && first < x.vec.len() &&
+              (x.vec[first] & ((limb(1) << offset) - 1)) != 0;
+  for (bigint_limbs_t index = 0; !truncated && index != first; ++index) {
+    truncated = x.vec[index] != 0;
+  }
+  value128 bits;
+  for (int32_t bit = count; bit != 0; --bit) {
+    bigint_bits_t const position = bigint_bits_t(start + bigint_bits_t(bit - 1));
+    bigint_limbs_t const index = bigint_limbs_t(position / limb_bits);
+    uint64_t const set =
+        index < x.vec.len() ? (x.vec[index] >> (position % limb_bits)) & 1 : 0;
+    bits.high = (bits.high << 1) | (bits.low >> 63);
+    bits.low = (bits.low << 1) | set;
+  }
+  return bits;
+}
+
+// Divides x by y, for a quotient below 2^count, one bit at a time. The
+// remainder is left in x.
+inline value128 divide_bits(extended_bigint &x, extended_bigint &y,
+                            int32_t const count) noexcept {
+  value128 quotient;
+  FASTFLOAT_ASSERT(y.shl(bigint_bits_t(count - 1)));
+  for (int32_t bit = count; bit != 0; --bit) {
+    quotient.high = (quotient.high << 1) | (quotient.low >> 63);
+    quotient.low <<= 1;
+    if (x.compare(y) >= 0) {
+      x.sub(y);
+      quotient.low |= 1;
+    }
+    if (bit != 1) {
+      y.shr_bits(1);
+    }
+  }
+  return quotient;
+}
+
+fastfloat_really_inline bool bit_is_set(value128 const v,
+                                        int32_t const bit) noexcept {
+  return ((bit < 64 ? v.low >> bit : v.high >> (bit - 64)) & 1) != 0;
+}
+
+fastfloat_really_inline void shift_right_one(value128 &v) noexcept {
+  v.low = (v.low >> 1) | (v.high << 63);
+  v.high >>= 1;
+}
+
+// Number of decimal digits of a non-zero 64-bit value.
+fastfloat_really_inline int32_t count_digits(uint64_t const value) noexcept {
+  int32_t const guess = ((64 - int32_t(leading_zeroes(value))) * 1233) >> 12;
+  return guess + int32_t(value >= powers_of_ten_uint64[guess]);
+}
+
+// Adds one unit in the last place to a significand of `digits` bits, carrying
+// into the exponent of its least significant bit.
+fastfloat_really_inline void round_up(value128 &mantissa, int32_t &lsb,
+                                      int32_t const digits) noexcept {
+  ++mantissa.low;
+  mantissa.high += uint64_t(mantissa.low == 0);
+  if (bit_is_set(mantissa, digits)) {
+    shift_right_one(mantissa);
+    ++lsb;
+  }
+}
+
+// A 192-bit significand, most significant word first, with its top bit set:
+// value = word * 2^exponent.
+struct wide_float {
+  uint64_t word[3];
+  int32_t exponent;
+};
+
+// Truncated 192-bit powers of five: 5^(256 * a) for a from -20 to 19 and
+// 5^(16 * b) for b from 0 to 15, which with the exact 5^r for r below 16 cover
+// the decimal exponents of the extended formats in three multiplications.
+template <class unused = void> struct powers_of_five_192_template {
+  static constexpr int32_t smallest_large_power = -20;
+  static constexpr wide_float large[40] = {
+      {{0xd408cb010da5d8e8, 0x00d22e620ec380f5, 0xd5304b26272e0447}, -12080}, // 5^-5120
+      {{0x8d36f6971766349c, 0xac63454249b771c8, 0x2bfb20990dedb270}, -11485}, // 5^-4864
+      {{0xbc1905f3e898cca2, 0x41a8bcd577f7a7d8, 0x4a0ad081b987938a}, -10891}, // 5^-4608
+      {{0xfa8bbf517f29408a, 0x31c0368ccb2c5757, 0x842dc41b89ca32c7}, -10297}, // 5^-4352
+      {{0xa6dd04c8d2ce9fde, 0x2de38123a1c3cffc, 0x20305d0244e091ba}, -9702}, // 5^-4096
+      {{0xde42ff8d37cad87f, 0x1463ef488d5226cb, 0xb171e37a76c65371}, -9108}, // 5^-3840
+      {{0x9406af8f83fd6265, 0x4b4de34e0ebc3e06, 0x45efb05f20cf48b3}, -8513}, // 5^-3584
+      {{0xc52ba8a6aeb15d92, 0x9e98cb984f0d3050, 0xa42303e570b87e7f}, -7919}, // 5^-3328
+      {{0x8350bf3c91575a87, 0xe79e236bf8bf47a8, 0xe8a94db92ca5841f}, -7324}, // 5^-3072
+      {{0xaee973911228abca, 0xe3187c34500d9ab3, 0xb7d1f78b317fae11}, -6730}, // 5^-2816
+      {{0xe8fb7dc2dec0a404, 0x598eec7d41754c09, 0x5ad05b84c7c4be7d}, -6136}, // 5^-2560
+      {{0x9b2a840f28a1638f, 0xe393a9c032fb0c34, 0x660bdfd108ba7989}, -5541}, // 5^-2304
+      {{0xceae534f34362de4, 0x492512d4f2ead2cb, 0x8263ca5cbc774bd9}, -4947}, // 5^-2048
+      {{0x89a63ba4c497b50e, 0x6c83ad1260ff20f4, 0xc098e6ed0bfbd6f6}, -4352}, // 5^-1792
+      {{0xb759449f52a711b2, 0x68e1eb75340122d4, 0x0fd924be26af7592}, -3758}, // 5^-1536
+      {{0xf4385d0975edbabe, 0x1f4bf6653cd3b977, 0xddee7f83569c8b33}, -3164}, // 5^-1280
+      {{0xa2a682a5da57c0bd, 0x87a601586bd3f698, 0xf53e94d1b2357c32}, -2569}, // 5^-1024
+      {{0xd8a66d4a505de96b, 0x5ae1b25946117390, 0x4d0525af79e132c3}, -1975}, // 5^-768
+      {{0x9049ee32db23d21c, 0x7132d332e3f204d4, 0xe7317d62209b6a93}, -1380}, // 5^-512
+      {{0xc0314325637a1939, 0xfa911155fefb5308, 0xa23e2ed27766e8cc}, -786}, // 5^-256
+      {{0x8000000000000000, 0x0000000000000000, 0x0000000000000000}, -191}, // 5^0
+      {{0xaa7eebfb9df9de8d, 0xddbb901b98feeab7, 0x851e4cbf3de2f98a}, 403}, // 5^256
+      {{0xe319a0aea60e91c6, 0xcc655c54bc5058f8, 0x9c6583981d134cba}, 997}, // 5^512
+      {{0x973f9ca8cd00a68c, 0x6c8d3fca02ca6de6, 0xb0d7ba426777344d}, 1592}, // 5^768
+      {{0xc976758681750c17, 0x650d3d28f18b50ce, 0x526b988275249b0f}, 2186}, // 5^1024
+      {{0x862c8c0eeb856ecb, 0x085bccd5c05ee9f9, 0xecff2e2c1eae9db9}, 2781}, // 5^1280
+      {{0xb2b8353b3993a7e4, 0x4257ac3b4c1d7794, 0x7704bd1bb5a5802f}, 3375}, // 5^1536
+      {{0xee0ddd84924ab88c, 0x2d4070f33b21ab7b, 0xc20578fa3851488b}, 3969}, // 5^1792
+      {{0x9e8b3b5dc53d5de4, 0xa74d28ce329ace52, 0x6a3197bbebe3034f}, 4564}, // 5^2048
+      {{0xd32e203241f4806f, 0x3f50c802040f4ccc, 0x03baa2f38e35464f}, 5158}, // 5^2304
+      {{0x8ca554c020a1f0a6, 0x5dfed09922680a06, 0xaef839a8a7f6a14c}, 5753}, // 5^2560
+      {{0xbb570a9a9bd977cc, 0x4c808753bb22fef8, 0x6fc5802cde0b3272}, 6347}, // 5^2816
+      {{0xf9895d25d88b5a8a, 0xfdd08c4da13655ec, 0xf02c90b784b4227a}, 6941}, // 5^3072
+      {{0xa630ef7d5699fe45, 0x50e3660235410f98, 0xfca81f202c5d111a}, 7536}, // 5^3328
+      {{0xdd5dc8a2bf27f3f7, 0x95aa118ec1d08317, 0x8909e424a112a3cd}, 8130}, // 5^3584
+      {{0x936e07737dc64f6d, 0x8c474bb609f40287, 0xd2fea4fd957ea18e}, 8725}, // 5^3840
+      {{0xc46052028a20979a, 0xc94c153f804a4a92, 0x65761fb2444e2267}, 9319}, // 5^4096
+      {{0x82c952e37be11cb4, 0x6e6c12aa02b9a1ec, 0x538567bfbe0b117a}, 9914}, // 5^4352
+      {{0xae3511626ed559f0, 0x7ef5f8c1b3a0771c, 0x5a43d43795f92ea2}, 10508}, // 5^4608
+      {{0xe80b387fb9146d6c, 0xa6a99ee15afede53, 0xe72af3faf80453ce}, 11102}, // 5^4864
+  };
+  static constexpr wide_float medium[16] = {
+      {{0x8000000000000000, 0x0000000000000000, 0x0000000000000000}, -191}, // 5^0
+      {{0x8e1bc9bf04000000, 0x0000000000000000, 0x0000000000000000}, -154}, // 5^16
+      {{0x9dc5ada82b70b59d, 0xf020000000000000, 0x0000000000000000}, -117}, // 5^32
+      {{0xaf298d050e4395d6, 0x9670b12b7f410000, 0x0000000000000000}, -80}, // 5^48
+      {{0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb, 0x50f8080000000000}, -43}, // 5^64
+      {{0xd7e77a8f87daf7fb, 0xdc33745ec97be906, 0x3298e889d933b040}, -6}, // 5^80
+      {{0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e, 0x388da035c8f16477}, 31}, // 5^96
+      {{0x850fadc09923329e, 0x03e2cf6bc604ddb0, 0x74a7ef0198791097}, 69}, // 5^112
+      {{0x93ba47c980e98cdf, 0xc66f336c36b10137, 0x0234f3fd7b08dd39}, 106}, // 5^128
+      {{0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6, 0x39caef6ed62f905b}, 143}, // 5^144
+      {{0xb616a12b7fe617aa, 0x577b986b314d6009, 0x2381cf8591999d63}, 180}, // 5^160
+      {{0xca28a291859bbf93, 0x7d7b8f7503cfdcfe, 0xd11f91ff10629770}, 217}, // 5^176
+      {{0xe070f78d3927556a, 0x85bbe253f47b1417, 0x0f118a2758e233b1}, 254}, // 5^192
+      {{0xf92e0c3537826145, 0xa7709a56ccdf8a82, 0x866caba98a7e2dab}, 291}, // 5^208
+      {{0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f, 0xbc10c5c5cda97c8d}, 329}, // 5^224
+      {{0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29, 0x036ee4519d59a838}, 366}, // 5^240
+  };
+};
+
+#if FASTFLOAT_DETAIL_MUST_DEFINE_CONSTEXPR_VARIABLE
+
+template <class unused>
+constexpr int32_t powers_of_five_192_template<unused>::smallest_large_power;
+
+template <class unused>
+constexpr wide_float powers_of_five_192_template<unused>::large[40];
+
+template <class unused>
+constexpr wide_float powers_of_five_192_template<unused>::medium[16];
+
+#endif
+
+using powers_of_five_192 = powers_of_five_192_template<>;
+
+// a normalized wide_float holding a non-zero 64-bit integer.
+fastfloat_really_inline wide_float to_wide_float(uint64_t const value) noexcept {
+  limb_t const shift = leading_zeroes(value);
+  wide_float const result = {{value << shift, 0, 0}, -128 - int32_t(shift)};
+  return result;
+}
+
+// The product of two wide_float, truncated to 192 bits. The result is below
+// the exact product by less than one unit in the last place.
+fastfloat_really_inline wide_float multiply(wide_float const &a,
+                                            wide_float const &b) noexcept {
+  uint64_t product[6] = {};
+  for (int i = 2; i >= 0; --i) {
+    uint64_t carry = 0;
+    for (int j = 2; j >= 0; --j) {
+      value128 const partial = full_multiplication(a.word[i], b.word[j]);
+      uint64_t sum = product[i + j + 1] + partial.low;
+      uint64_t overflow = uint64_t(sum < partial.low);
+      sum += carry;
+      overflow += uint64_t(sum < carry);
+      product[i + j + 1] = sum;
+      carry = partial.high + overflow;
+    }
+    product[i] = carry;
+  }
+  wide_float result = {{product[0], product[1], product[2]},
+                       a.exponent + b.exponent + 192};
+  if ((product[0] >> 63) == 0) {
+    result.word[0] = (product[0] << 1) | (product[1] >> 63);
+    result.word[1] = (product[1] << 1) | (product[2] >> 63);
+    result.word[2] = (product[2] << 1) | (product[3] >> 63);
+    --result.exponent;
+  }
+  return result;
+}
+
+// 64 bits of a wide_float significand, starting at bit `shift` < 192.
+fastfloat_really_inline uint64_t bits_at(wide_float const &value,
+                                         int32_t const shift) noexcept {
+  int32_t const index = 2 - shift / 64;
+  int32_t const offset = shift % 64;
+  uint64_t const low = value.word[index] >> offset;
+  if (offset == 0 || index == 0) {
+    return low;
+  }
+  return low | (value.word[index - 1] << (64 - offset));
+}
+
+// Rounds x * 10^exponent to the significand of the extended format using
+// 192-bit approximations of the digits and of the power of five, which are
+// below the exact value by less than 2^-184 relatively. Returns false when
+// the value is too close to a halfway point for the approximation to decide.
+template <typename T, typename UC>
+inline bool round_extended_approximate(parsed_number_string_t<UC> const &pns,
+                                       int32_t const count, int32_t exponent,
+                                       value128 &mantissa,
+                                       int32_t &lsb) noexcept {
+  using format = extended_binary_format<T>;
+  wide_float value;
+  if (!pns.too_many_digits) {
+    value = to_wide_float(pns.mantissa);
+  } else {
+    // the first 57 significant digits, three chunks of 19 digits
+    significant_digits<UC> digits(pns);
+    int32_t const kept = count < 57 ? count : 57;
+    uint64_t word[3] = {};
+    for (int32_t index = 0; index != kept;) {
+      int32_t const length = kept - index < 19 ? kept - index : 19;
+      uint64_t chunk = 0;
+      for (int32_t i = 0; i != length; ++i) {
+        chunk = chunk * 10 + digits.next();
+      }
+      index += length;
+      uint64_t const power = powers_of_ten_uint64[length];
+      for (int w = 2; w >= 0; --w) {
+        value128 const partial = full_multiplication(word[w], power);
+        word[w] = partial.low + chunk;
+        chunk = partial.high + uint64_t(word[w] < chunk);
+      }
+    }
+    exponent += count - kept;
+    limb_t shift;
+    if (word[0] != 0) {
+      shift = leading_zeroes(word[0]);
+    } else if (word[1] != 0) {
+      shift = limb_t(64 + leading_zeroes(word[1]));
+    } else {
+      shift = limb_t(128 + leading_zeroes(word[2]));
+    }
+    value = {{word[0], word[1], word[2]}, -int32_t(shift)};
+    for (; shift >= 64; shift = limb_t(shift - 64)) {
+      value.word[0] = value.word[1];
+      value.word[1] = value.word[2];
+      value.word[2] = 0;
+    }
+    if (shift != 0) {
+      value.word[0] = (value.word[0] << shift) | (value.word[1] >> (64 - shift));
+      value.word[1] = (value.word[1] << shift) | (value.word[2] >> (64 - shift));
+      value.word[2] <<= shift;
+    }
+  }
+
+  // 10^exponent = 5^exponent * 2^exponent, with 5^exponent decomposed as
+  // 5^(256 * a) * 5^(16 * b) * 5^r.
+  int32_t const large = exponent >= 0 ? exponent / 256 : -((255 - exponent) / 256);
+  int32_t const rest = exponent - 256 * large;
+  if (large != 0) {
+    value = multiply(
+        value,
+        powers_of_five_192::large[large - powers_of_five_192::smallest_large_power]);
+  }
+  if (rest / 16 != 0) {
+    value = multiply(value, powers_of_five_192::medium[rest / 16]);
+  }
+  if (rest % 16 != 0) {
+    value = multiply(value, to_wide_float(pow5_tables<>::small_power_of_5[rest % 16]));
+  }
+  value.exponent += exponent;
+
+  // the bits below the significand, at least 192 - 113 = 79 of them
+  int32_t const digits = format::mantissa_digits();
+  lsb = value.exponent + 192 - digits;
+  if (lsb < format::min_exponent()) {
+    lsb = format::min_exponent();
+  }
+  int32_t const cut = lsb - value.exponent;
+  if (cut > 176) {
+    // far below the smallest normal value, let the exact path decide
+    return false;
+  }
+  // the approximation is below the value by less than 2^8 units of the last
+  // bit, while the 64 bits below the cut are in units of at least 2^15: only
+  // 0x7fff... and 0x8000... (a possible tie) are undecided.
+  uint64_t const below = bits_at(value, cut - 64);
+  if (below == 0x7fffffffffffffff || below == 0x8000000000000000) {
+    return false;
+  }
+  mantissa.low = bits_at(value, cut);
+  mantissa.high = cut + 64 < 192 ? bits_at(value, cut + 64) : 0;
+  if (digits < 128) {
+    mantissa.high &= (uint64_t(1) << (digits - 64)) - 1;
+  }
+  if (below > 0x8000000000000000) {
+    round_up(mantissa, lsb, digits);
+  }
+  return true;
+}
+
+// Rounds x * 10^exponent to the significand of the extended format exactly
+// with big integers: the quotient of the significant digits by the power of
+// ten, scaled to keep the bits of the significand and the rounding bit.
+template <typename T, typename UC>
+inline void round_extended_exact(parsed_number_string_t<UC> const &pns,
+                                 int32_t const count, int32_t exponent,
+                                 value128 &quotient, int32_t &lsb) noexcept {
+  using format = extended_binary_format<T>;
+  extended_bigint x;
+  if (!pns.too_many_digits) {
+#ifdef FASTFLOAT_64BIT_LIMB
+    x.add(limb(pns.mantissa));
+#else
+    x.add(limb(pns.mantissa >> 32));
+    x.shl(32);
+    x.add(limb(pns.mantissa));
+#endif
+  } else {
+    significant_digits<UC> digits(pns);
+    int32_t const kept = count < int32_t(format::max_digits())
+                             ? count
+                             : int32_t(format::max_digits());
+    limb_t const step = limb_bits == 64 ? 19 : 9;
+    limb chunk = 0;
+    limb_t length = 0;
+    for (int32_t index = 0; index != kept; ++index) {
+      chunk = chunk * 10 + digits.next();
+      if (++length == step) {
+        x.mul(limb(powers_of_ten_uint64[length]));
+        x.add(chunk);
+        chunk = 0;
+        length = 0;
+      }
+    }
+    if (length != 0) {
+      x.mul(limb(powers_of_ten_uint64[length]));
+      x.add(chunk);
+    }
+    exponent += count - kept;
+    if (kept != count && digits.nonzero_tail()) {
+      // the halfway points have at most max_digits significant digits, so
+      // any non-zero digit stands for the dropped ones.
+      x.mul(10);
+      x.add(1);
+      --exponent;
+    }
+  }
+
+  // value = x / y * 2^scale
+  extended_bigint y(1);
+  int32_t scale = 0;
+  if (exponent >= 0) {
+    FASTFLOAT_ASSERT(x.pow10(am_pow_t(exponent)));
+  } else {
+    FASTFLOAT_ASSERT(y.pow5(am_pow_t(-exponent)));
+    scale = exponent;
+  }
+
+  // the quotient gets p + 1 or p + 2 bits: the significand, the rounding bit
+  // and maybe one more, but no bits below the subnormal significand.
+  int32_t const digits = format::mantissa_digits();
+  int32_t shift =
+      digits + 1 - (int32_t(x.bit_length()) - int32_t(y.bit_length()));
+  if (scale - shift < format::min_exponent() - 1) {
+    shift = scale - format::min_exponent() + 1;
+  }
+  bool truncated;
+  if (exponent >= 0 && shift < 0) {
+    quotient = extract_bits(x, bigint_bits_t(-shift), digits + 2, truncated);
+  } else {
+    if (shift > 0) {
+      FASTFLOAT_ASSERT(x.shl(bigint_bits_t(shift)));
+    } else if (shift < 0) {
+      FASTFLOAT_ASSERT(y.shl(bigint_bits_t(-shift)));
+    }
+    quotient = divide_bits(x, y, digits + 2);
+    truncated = !x.vec.is_empty();
+  }
+  lsb = scale - shift;
+  if (bit_is_set(quotient, digits + 1)) {
+    truncated |= (quotient.low & 1) != 0;
+    shift_right_one(quotient);
+    ++lsb;
+  }
+
+  // round to nearest, ties to even
+  bool const round = (quotient.low & 1) != 0;
+  shift_right_one(quotient);
+  ++lsb;
+  if (round && (truncated || (quotient.low & 1) != 0)) {
+    round_up(quotient, lsb, digits);
+  }
+}
+
+// Converts a parsed number to the binary formats wider than double, rounding
+// to nearest with ties to even. A 192-bit approximation settles nearly all
+// inputs, big integers settle those close to a halfway point. Out of range
+// values become infinity or zero and std::errc::result_out_of_range is
+// returned.
+template <typename T, typename UC>
+inline std::errc to_extended_float(parsed_number_string_t<UC> const &pns,
+                                   T &value) noexcept {
+  using format = extended_binary_format<T>;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  bool const negative = pns.negative;
+#else
+  bool const negative = false;
+#endif
+  // the value has `count` significant digits, the last one is at `exponent`
+  int32_t count;
+  int32_t exponent;
+  if (!pns.too_many_digits) {
+    if (pns.mantissa == 0) {
+      format::store(negative, value128(), 0, value);
+      return std::errc();
+    }
+    count = count_digits(pns.mantissa);
+    exponent = int32_t(pns.exponent);
+  } else {
+    // the truncated mantissa holds exactly the first 19 significant digits
+    count = int32_t(significant_digits<UC>(pns).remaining());
+    exponent = int32_t(pns.exponent) + 19 - count;
+  }
+  if (count + exponent - 1 > format::largest_power_of_ten()) {
+    format::infinity(negative, value);
+    return std::errc::result_out_of_range;
+  }
+  if (count + exponent <= format::smallest_power_of_ten()) {
+    format::store(negative, value128(), 0, value);
+    return std::errc::result_out_of_range;
+  }
+
+  value128 mantissa;
+  int32_t lsb;
+  if (!round_extended_approximate<T>(pns, count, exponent, mantissa, lsb)) {
+    round_extended_exact<T>(pns, count, exponent, mantissa, lsb);
+  }
+
+  if (mantissa.low == 0 && mantissa.high == 0) {
+    format::store(negative, mantissa, 0, value);
+    return std::errc::result_out_of_range;
+  }
+  uint32_t biased_exponent = 0;
+  if (bit_is_set(mantissa, format::mantissa_digits() - 1)) {
+    biased_exponent = uint32_t(lsb - format::min_exponent() + 1);
+  }
+  if (biased_exponent >= 0x7fff) {
+    format::infinity(negative, value);
+    return std::errc::result_out_of_range;
+  }
+  format::store(negative, mantissa, biased_exponent, value);
+  return std::errc();
+}
+
+} // namespace fast_float
+
+#endif
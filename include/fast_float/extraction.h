@@ -0,0 +1,199 @@
+#ifndef FASTFLOAT_EXTRACTION_H
+#define FASTFLOAT_EXTRACTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <type_traits>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "parse_number.h"
+
+namespace fast_float {
+
+namespace detail {
+
+// The chars which make a word with a number they touch: ASCII letters and
+// digits, '_', and any char beyond ASCII, such as the bytes of UTF-8.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 bool
+is_word_char(UC const c) noexcept {
+  typedef typename std::make_unsigned<UC>::type unsigned_char;
+  uint32_t const u = static_cast<unsigned_char>(c);
+  return u - '0' < 10 || (u | 0x20) - 'a' < 26 || u == '_' || u > 0x7f;
+}
+
+// Tells if the number which starts at p is glued to the chars before it: they
+// end with a word char, or with a decimal point after a digit ("1.2.3").
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 bool
+glued_before(UC const *const first, UC const *const p,
+             UC const decimal_point) noexcept {
+  return p != first &&
+         (is_word_char(p[-1]) ||
+          (p[-1] == decimal_point && p - 1 != first && is_integer(p[-2])));
+}
+
+// Tells if the number which ends at p is glued to the chars after it.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 bool
+glued_after(UC const *const p, UC const *const last,
+            UC const decimal_point) noexcept {
+  return p != last &&
+         (is_word_char(*p) ||
+          (*p == decimal_point && p + 1 != last && is_integer(p[1])));
+}
+
+// Skips the word chars and decimal points at p, the rest of a word whose
+// number was refused.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 UC const *
+skip_word(UC const *p, UC const *const last, UC const decimal_point) noexcept {
+  while (p != last && (is_word_char(*p) || *p == decimal_point)) {
+    ++p;
+  }
+  return p;
+}
+
+// Reads the digits at p, 19 at most: returns the end of the run, or of the
+// first 19 digits, and their value.
+template <typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 UC const *
+read_digits(UC const *const p, UC const *const last, uint64_t &value) noexcept {
+  UC const *q = p;
+  value = 0;
+  while (q != last && is_integer(*q) && q - p != 19) {
+    value = 10 * value + uint64_t(*q - UC('0'));
+    ++q;
+  }
+  return q;
+}
+
+} // namespace detail
+
+template <typename UC>
+from_chars_array_result_t<UC>
+extract_numbers(UC const *first, UC const *last, extracted_number *numbers,
+                size_t const capacity,
+                extract_options_t<UC> const options) noexcept {
+  from_chars_array_result_t<UC> answer;
+  answer.ptr = last;
+  answer.ec = std::errc();
+  answer.count = 0;
+  UC const decimal_point = options.number.decimal_point;
+  // the formats in which a digit run may be read as an integer at once
+  bool const plain =
+      chars_format_t(options.number.format & chars_format::fixed) &&
+      !chars_format_t(options.number.format & chars_format::hex)
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      && !chars_format_t(options.number.format & detail::basic_fortran_fmt)
+#endif
+      ;
+  UC const *p = first;
+  while (true) {
+    // Every number has a digit: the text between them is only scanned for
+    // one, 16 chars at a time.
+    UC const *const digit = find_digit(p, last);
+    if (digit == last) {
+      return answer;
+    }
+    // The number may start with a decimal point and a sign before its first
+    // digit, among the chars which no number took.
+    UC const *const point =
+        (digit != p && digit[-1] == decimal_point) ? digit - 1 : digit;
+    UC const *start = point;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (start != p &&
+        (start[-1] == UC('-') ||
+         (start[-1] == UC('+') &&
+          chars_format_t(options.number.format &
+                         chars_format::allow_leading_plus)))) {
+      --start;
+    }
+#endif
+    if (options.boundary != number_boundary::none &&
+        detail::glued_before(first, start, decimal_point)) {
+      // the '-' of "a-1" or "2024-10" is a hyphen
+      start = point;
+      if (detail::glued_before(first, start, decimal_point)) {
+        p = detail::skip_word(digit, last, decimal_point);
+        continue;
+      }
+    }
+    // Most numbers of a log are a short digit run, or a digit run with a
+    // fraction: they are told apart without the full grammar of lex_number,
+    // which reads the rest.
+    lex_result_t<UC> number;
+    number.ptr = nullptr;
+    if (plain) {
+      uint64_t digits;
+      UC const *const end = detail::read_digits(digit, last, digits);
+      bool const fraction =
+          end != last && (*end == decimal_point || (*end | 0x20) == UC('e'));
+      if (point == digit && !fraction && end - digit != 19 &&
+          (*digit != UC('0') || end == digit + 1)) {
+        number.ptr = end;
+        number.ec = std::errc();
+        number.kind = number_kind::integer;
+        number.integer = int64_t(digits);
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+        if (*start == UC('-')) {
+          number.integer = -number.integer;
+        }
+#endif
+      } else if (point != digit || (fraction && end - digit != 19)) {
+        number.kind = number_kind::decimal;
+        number.decimal = 0;
+        from_chars_result_t<UC> const r = from_chars_advanced(
+            start, last, number.decimal, options.number);
+        // without a fraction or an exponent ("12e", "01" in JSON), lex_number
+        // has the last word
+        number.ptr =
+            (r.ptr > end || (r.ptr == end && point != digit)) ? r.ptr : nullptr;
+        number.ec = r.ec;
+      }
+    }
+    if (number.ptr == nullptr) {
+      number = lex_number_advanced(start, last, options.number);
+    }
+    if (number.ec == std::errc::invalid_argument) {
+      // e.g., "01" or ".5" in JSON
+      p = detail::skip_word(digit, last, decimal_point);
+      continue;
+    }
+    if (options.boundary == number_boundary::word &&
+        detail::glued_after(number.ptr, last, decimal_point)) {
+      p = detail::skip_word(number.ptr, last, decimal_point);
+      continue;
+    }
+    if (answer.count == capacity) {
+      answer.ptr = start;
+      return answer;
+    }
+    extracted_number &stored = numbers[answer.count];
+    stored.offset = size_t(start - first);
+    stored.length = size_t(number.ptr - start);
+    if (number.kind == number_kind::integer) {
+      if (options.prefer_integers) {
+        stored.kind = number_kind::integer;
+        stored.integer = number.integer;
+      } else {
+        stored.kind = number_kind::decimal;
+        stored.decimal = double(number.integer);
+      }
+    } else {
+      stored.kind = number_kind::decimal;
+      stored.decimal = number.decimal;
+    }
+    if (number.ec != std::errc()) {
+      answer.ec = number.ec;
+    }
+    ++answer.count;
+    p = number.ptr;
+  }
+}
+
+} // namespace fast_float
+
+#endif
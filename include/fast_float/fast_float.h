@@ -29,9 +29,20 @@ namespace fast_float {
  * the fixed point and scientific notation respectively. The default is
  * `fast_float::chars_format::general` which allows both `fixed` and
  * `scientific`.
+ *
+ * The value may also be a `fast_float::decimal64` or `fast_float::decimal128`:
+ * the number is then stored in the IEEE 754 decimal BID encoding, rounded to
+ * 16 or 34 significant digits to nearest with ties to even, without any binary
+ * conversion. The exponent of exact results is kept ("1.50" is 150e-2).
+ *
+ * The value may also be a `long double` (x87 80-bit extended or binary128),
+ * a `__float128` or a `std::float128_t`, with the same correct rounding.
  */
 template <typename T, typename UC = char,
-          typename = FASTFLOAT_ENABLE_IF(is_supported_float_type<T>::value)>
+          typename = FASTFLOAT_ENABLE_IF(
+              is_supported_float_type<T>::value ||
+              is_supported_decimal_type<T>::value ||
+              is_supported_extended_float_type<T>::value)>
 FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
 from_chars(UC const *first, UC const *last, T &value,
            chars_format const fmt = chars_format::general) noexcept;
@@ -92,7 +103,252 @@ FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
 from_chars(UC const *first, UC const *last, T &value,
            int const base = 10) noexcept;
 
+/**
+ * This function scans the character sequence [first,last) for a number once
+ * and reports both what kind of number it is and its value. A plain run of
+ * digits (with an optional sign) is an integer and is stored exactly in
+ * `integer` when it fits in int64_t. A number with a fraction or an exponent,
+ * or an integer too large for int64_t, is a decimal and is stored in `decimal`
+ * with the same correctly rounded result as from_chars for double. inf and nan
+ * are reported as special and are also stored in `decimal`.
+ *
+ * The `ptr` and `ec` members have the same meaning as for from_chars.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 lex_result_t<UC>
+lex_number(UC const *first, UC const *last,
+           chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * Like lex_number, but accepts an `options` argument to govern number parsing.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 lex_result_t<UC>
+lex_number_advanced(UC const *first, UC const *last,
+                    parse_options_t<UC> const options) noexcept;
+
+/**
+ * This function parses up to `count` numbers separated by `separator` in
+ * [first,last) and stores them in `values` as IEEE 754 binary16 bit patterns,
+ * rounded like from_chars. It stops after `count` values, at `last`, or after
+ * a number that is not followed by the separator (e.g., at the end of a line):
+ * `ptr` is left there and `count` holds the number of values stored.
+ *
+ * A field that is not a number stops the parsing with
+ * `std::errc::invalid_argument` and `ptr` pointing at it. A value out of range
+ * is stored as an infinity or a zero, the parsing goes on, and `ec` is set to
+ * `std::errc::result_out_of_range`.
+ *
+ * Single values may be parsed with from_chars into a `fast_float::float16_bits`
+ * or a `fast_float::bfloat16_bits`. Unlike `std::float16_t`, neither requires
+ * C++23.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_array_result_t<UC>
+from_chars_float16(UC const *first, UC const *last, uint16_t *values,
+                   size_t const count, UC const separator = UC(','),
+                   chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * Like from_chars_float16, but stores bfloat16 bit patterns.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_array_result_t<UC>
+from_chars_bfloat16(UC const *first, UC const *last, uint16_t *values,
+                    size_t const count, UC const separator = UC(','),
+                    chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * This function parses only some columns of the rows of [first,last), for
+ * queries which need a few columns of many: `columns` holds `column_count`
+ * column numbers (from 0) in increasing order, and the field of the column
+ * `columns[k]` of each row is stored in `values[k]`, which has room for
+ * `rows` values. Fields are separated by `separator`, rows by a newline
+ * ("\r\n" too). The fields which are not projected are only scanned for
+ * the next separator, 16 chars at a time. It stops after `rows` rows or at
+ * `last`: `ptr` is left at the start of the next row, so that the parsing
+ * may go on from there, and `count` holds the number of rows stored.
+ *
+ * A missing field, or one which is not a number of its own, stops the parsing
+ * with `std::errc::invalid_argument` and `ptr` pointing at it; so do columns
+ * which are not in increasing order. A value out of range is stored as
+ * from_chars_advanced leaves it, the parsing goes on, and `ec` is set to
+ * `std::errc::result_out_of_range`. With FASTFLOAT_ISNOT_CHECKED_BOUNDS, every
+ * field parsed must be a number. See projection.h.
+ */
+template <typename T, typename UC = char>
+from_chars_array_result_t<UC>
+from_chars_columns(UC const *first, UC const *last, size_t const *columns,
+                   size_t const column_count, T *const *values,
+                   size_t const rows, UC const separator = UC(','),
+                   parse_options_t<UC> const options =
+                       parse_options_t<UC>()) noexcept;
+
+/**
+ * This function finds the numbers of a free text, such as the log line
+ * "took 12.5ms, 3 retries, size=4096", and stores their offset, length and
+ * value in `numbers`, which has room for `capacity` of them. The text between
+ * numbers is scanned 16 chars at a time for a digit; a decimal point and a
+ * sign just before the digit are part of the number, which is then parsed
+ * with lex_number_advanced, so that a plain digit run which fits in int64_t
+ * is an integer unless `options.prefer_integers` is false. The numbers glued
+ * to a word are skipped as `options.boundary` says; inf and nan are never
+ * extracted.
+ *
+ * It stops at `last`, or at the start of the first number beyond
+ * `capacity`: `ptr` is left there, so that the extraction may go on from
+ * there, and `count` holds the number of numbers stored. A value out of range
+ * is stored as lex_number leaves it, and `ec` is set to
+ * `std::errc::result_out_of_range`. A free text is not made of well-formed
+ * numbers: FASTFLOAT_ISNOT_CHECKED_BOUNDS and FASTFLOAT_TRUSTED_INPUT do not
+ * apply to it. See extraction.h.
+ */
+template <typename UC = char>
+from_chars_array_result_t<UC>
+extract_numbers(UC const *first, UC const *last, extracted_number *numbers,
+                size_t const capacity,
+                extract_options_t<UC> const options =
+                    extract_options_t<UC>()) noexcept;
+
+/**
+ * This function parses the character sequence [first,last) like from_chars
+ * and stores the two consecutive values of type `T` that enclose the number:
+ * `lo` is the number rounded down and `hi` the number rounded up, whatever the
+ * rounding mode of the thread. When the number is representable, `lo` and
+ * `hi` are equal and `exact` is set.
+ *
+ * A number beyond the largest finite value is enclosed by that value and
+ * infinity, and a non-zero number below the smallest subnormal by zero and
+ * that subnormal: `ec` is then set to `std::errc::result_out_of_range`. inf
+ * and nan are stored in both `lo` and `hi`.
+ */
+template <typename T, typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_interval_result_t<UC>
+from_chars_interval(UC const *first, UC const *last, T &lo, T &hi,
+                    chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * Like from_chars_interval, but accepts an `options` argument to govern number
+ * parsing.
+ */
+template <typename T, typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_interval_result_t<UC>
+from_chars_interval_advanced(UC const *first, UC const *last, T &lo, T &hi,
+                             parse_options_t<UC> const options) noexcept;
+
+/**
+ * This function parses the character sequence [first,last) like from_chars
+ * and stores the number both as a double and as a float. Each value is
+ * rounded directly from the decimal input, as from_chars would round it (the
+ * float is not the double rounded again), but the characters are scanned only
+ * once and the product by a power of five is computed once.
+ *
+ * `ec` reports on the double value, and `float_ec` on the float value, which
+ * may be out of range on its own, e.g., for 1e-50.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_dual_result_t<UC>
+from_chars_dual(UC const *first, UC const *last, double &d, float &f,
+                chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * Like from_chars_dual, but accepts an `options` argument to govern number
+ * parsing.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_dual_result_t<UC>
+from_chars_dual_advanced(UC const *first, UC const *last, double &d, float &f,
+                         parse_options_t<UC> const options) noexcept;
+
+/**
+ * This function parses the character sequence [first,last) like from_chars,
+ * but trades exactness for speed on long inputs: the significant digits after
+ * the 19th are ignored, and the value is never refined by comparing digits.
+ * The result is at most 1 ULP away from the correctly rounded one, and equal
+ * to it for numbers with no more than 19 significant digits. The rounding
+ * mode of the thread is not checked either: with another mode than
+ * FE_TONEAREST, the results of Clinger's fast path stay within 1 ULP.
+ *
+ * The decimal and extended precision types are not supported. `ptr` and
+ * `ec` have the same meaning as for from_chars.
+ */
+template <typename T, typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_approximate(UC const *first, UC const *last, T &value,
+                       chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * Like from_chars_approximate, but accepts an `options` argument to govern
+ * number parsing. The rounding field is ignored.
+ */
+template <typename T, typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_approximate_advanced(UC const *first, UC const *last, T &value,
+                                parse_options_t<UC> const options) noexcept;
+
+template <typename UC> struct lazy_number_t;
+using lazy_number = lazy_number_t<char>;
+
+/**
+ * This function tokenizes the character sequence [first,last) into a
+ * `lazy_number` without converting it. The number is converted later, and as
+ * many times as needed, with `value.as<T>()` for any supported floating-point
+ * or integer type `T`. inf and nan are not tokenized, they are rejected with
+ * `std::errc::invalid_argument`.
+ *
+ * The returned `ptr` and `ec` have the same meaning as for from_chars.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+tokenize_number(UC const *first, UC const *last, lazy_number_t<UC> &value,
+                chars_format const fmt = chars_format::general) noexcept;
+
+/**
+ * Like tokenize_number, but accepts an `options` argument to govern number
+ * parsing.
+ */
+template <typename UC = char>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+tokenize_number_advanced(UC const *first, UC const *last,
+                         lazy_number_t<UC> &value,
+                         parse_options_t<UC> const options) noexcept;
+
+/**
+ * A parser for a column of numbers that are nearly all written the same way,
+ * like prices or coordinates, see column_parser.h. It learns the most common
+ * shape from the first values and then parses the values of that shape with a
+ * kernel specialized for it, with the results of from_chars.
+ */
+template <typename T, typename UC = char> struct column_parser_t;
+
+/**
+ * A direct-mapped cache of parsed numbers, for inputs which repeat the same
+ * values, see parse_cache.h. A token already parsed is returned with the
+ * results of from_chars_advanced without being parsed again.
+ */
+template <typename T, typename UC = char, size_t Slots = 1024>
+struct parse_cache_t;
+
+/**
+ * The offsets and values of the fields of a text, which are parsed again
+ * after an edit only where the text changed, see field_index.h.
+ */
+template <typename T, typename UC = char> struct field_index_t;
+
+/**
+ * A sampled index of the line starts of a text, to parse any range of rows
+ * and a column of them without scanning the text from the start, see
+ * line_index.h.
+ */
+template <typename UC = char> struct line_index_t;
+
 } // namespace fast_float
 
 #include "parse_number.h"
+#include "column_parser.h"
+#include "parse_cache.h"
+#include "field_index.h"
+#include "line_index.h"
+#include "projection.h"
+#include "extraction.h"
 #endif // FASTFLOAT_FAST_FLOAT_H
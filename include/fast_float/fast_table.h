@@ -700,6 +700,229 @@ constexpr am_mant_t
 
 using powers = powers_template<>;
 
+/**
+ * The entries of power_of_five_128 for 5^-64 to 5^38, the decimal exponents
+ * of binary32, with the high and the low words in two arrays. Parsing a float
+ * almost always needs only the high word, so that the hot part of the table
+ * is about 800 bytes; the low word is read when the first product is too
+ * close to call (see compute_product_approximation). A program that only
+ * parses float, or narrower formats, never refers to power_of_five_128.
+ */
+template <class unused = void> struct float_powers_template {
+  constexpr static am_pow_t smallest_power_of_five =
+      binary_format<float>::smallest_power_of_ten();
+  constexpr static am_pow_t largest_power_of_five =
+      binary_format<float>::largest_power_of_ten();
+  constexpr static am_pow_t number_of_entries =
+      largest_power_of_five - smallest_power_of_five + 1;
+  constexpr static am_mant_t power_of_five_high[number_of_entries] = {
+      0xa87fea27a539e9a5, 0xd29fe4b18e88640e, 0x83a3eeeef9153e89,
+      0xa48ceaaab75a8e2b, 0xcdb02555653131b6, 0x808e17555f3ebf11,
+      0xa0b19d2ab70e6ed6, 0xc8de047564d20a8b, 0xfb158592be068d2e,
+      0x9ced737bb6c4183d, 0xc428d05aa4751e4c, 0xf53304714d9265df,
+      0x993fe2c6d07b7fab, 0xbf8fdb78849a5f96, 0xef73d256a5c0f77c,
+      0x95a8637627989aad, 0xbb127c53b17ec159, 0xe9d71b689dde71af,
+      0x9226712162ab070d, 0xb6b00d69bb55c8d1, 0xe45c10c42a2b3b05,
+      0x8eb98a7a9a5b04e3, 0xb267ed1940f1c61c, 0xdf01e85f912e37a3,
+      0x8b61313bbabce2c6, 0xae397d8aa96c1b77, 0xd9c7dced53c72255,
+      0x881cea14545c7575, 0xaa242499697392d2, 0xd4ad2dbfc3d07787,
+      0x84ec3c97da624ab4, 0xa6274bbdd0fadd61, 0xcfb11ead453994ba,
+      0x81ceb32c4b43fcf4, 0xa2425ff75e14fc31, 0xcad2f7f5359a3b3e,
+      0xfd87b5f28300ca0d, 0x9e74d1b791e07e48, 0xc612062576589dda,
+      0xf79687aed3eec551, 0x9abe14cd44753b52, 0xc16d9a0095928a27,
+      0xf1c90080baf72cb1, 0x971da05074da7bee, 0xbce5086492111aea,
+      0xec1e4a7db69561a5, 0x9392ee8e921d5d07, 0xb877aa3236a4b449,
+      0xe69594bec44de15b, 0x901d7cf73ab0acd9, 0xb424dc35095cd80f,
+      0xe12e13424bb40e13, 0x8cbccc096f5088cb, 0xafebff0bcb24aafe,
+      0xdbe6fecebdedd5be, 0x89705f4136b4a597, 0xabcc77118461cefc,
+      0xd6bf94d5e57a42bc, 0x8637bd05af6c69b5, 0xa7c5ac471b478423,
+      0xd1b71758e219652b, 0x83126e978d4fdf3b, 0xa3d70a3d70a3d70a,
+      0xcccccccccccccccc, 0x8000000000000000, 0xa000000000000000,
+      0xc800000000000000, 0xfa00000000000000, 0x9c40000000000000,
+      0xc350000000000000, 0xf424000000000000, 0x9896800000000000,
+      0xbebc200000000000, 0xee6b280000000000, 0x9502f90000000000,
+      0xba43b74000000000, 0xe8d4a51000000000, 0x9184e72a00000000,
+      0xb5e620f480000000, 0xe35fa931a0000000, 0x8e1bc9bf04000000,
+      0xb1a2bc2ec5000000, 0xde0b6b3a76400000, 0x8ac7230489e80000,
+      0xad78ebc5ac620000, 0xd8d726b7177a8000, 0x878678326eac9000,
+      0xa968163f0a57b400, 0xd3c21bcecceda100, 0x84595161401484a0,
+      0xa56fa5b99019a5c8, 0xcecb8f27f4200f3a, 0x813f3978f8940984,
+      0xa18f07d736b90be5, 0xc9f2c9cd04674ede, 0xfc6f7c4045812296,
+      0x9dc5ada82b70b59d, 0xc5371912364ce305, 0xf684df56c3e01bc6,
+      0x9a130b963a6c115c, 0xc097ce7bc90715b3, 0xf0bdc21abb48db20,
+      0x96769950b50d88f4,
+  };
+  constexpr static am_mant_t power_of_five_low[number_of_entries] = {
+      0x3f2398d747b36224, 0x8eec7f0d19a03aad, 0x1953cf68300424ac,
+      0x5fa8c3423c052dd7, 0x3792f412cb06794d, 0xe2bbd88bbee40bd0,
+      0x5b6aceaeae9d0ec4, 0xf245825a5a445275, 0xeed6e2f0f0d56712,
+      0x55464dd69685606b, 0xaa97e14c3c26b886, 0xd53dd99f4b3066a8,
+      0xe546a8038efe4029, 0xde98520472bdd033, 0x963e66858f6d4440,
+      0xdde7001379a44aa8, 0x5560c018580d5d52, 0xaab8f01e6e10b4a6,
+      0xcab3961304ca70e8, 0x3d607b97c5fd0d22, 0x8cb89a7db77c506a,
+      0x77f3608e92adb242, 0x55f038b237591ed3, 0x6b6c46dec52f6688,
+      0x2323ac4b3b3da015, 0xabec975e0a0d081a, 0x96e7bd358c904a21,
+      0x7e50d64177da2e54, 0xdde50bd1d5d0b9e9, 0x955e4ec64b44e864,
+      0xbd5af13bef0b113e, 0xecb1ad8aeacdd58e, 0x67de18eda5814af2,
+      0x80eacf948770ced7, 0xa1258379a94d028d, 0x96ee45813a04330,
+      0x8bca9d6e188853fc, 0x775ea264cf55347e, 0x95364afe032a819e,
+      0x3a83ddbd83f52205, 0xc4926a9672793543, 0x75b7053c0f178294,
+      0x5324c68b12dd6339, 0xd3f6fc16ebca5e04, 0x88f4bb1ca6bcf585,
+      0x2b31e9e3d06c32e6, 0x3aff322e62439fd0, 0x9befeb9fad487c3,
+      0x4c2ebe687989a9b4, 0xf9d37014bf60a11, 0x538484c19ef38c95,
+      0x2865a5f206b06fba, 0xf93f87b7442e45d4, 0xf78f69a51539d749,
+      0xb573440e5a884d1c, 0x31680a88f8953031, 0xfdc20d2b36ba7c3e,
+      0x3d32907604691b4d, 0xa63f9a49c2c1b110, 0xfcf80dc33721d54,
+      0xd3c36113404ea4a9, 0x645a1cac083126ea, 0x3d70a3d70a3d70a4,
+      0xcccccccccccccccd, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x0,
+      0x0, 0x0, 0x4000000000000000,
+      0x5000000000000000, 0xa400000000000000, 0x4d00000000000000,
+      0xf020000000000000, 0x6c28000000000000, 0xc732000000000000,
+      0x3c7f400000000000, 0x4b9f100000000000, 0x1e86d40000000000,
+      0x1314448000000000,
+  };
+};
+
+#if FASTFLOAT_DETAIL_MUST_DEFINE_CONSTEXPR_VARIABLE
+
+template <class unused>
+constexpr am_mant_t
+    float_powers_template<unused>::power_of_five_high[number_of_entries];
+
+template <class unused>
+constexpr am_mant_t
+    float_powers_template<unused>::power_of_five_low[number_of_entries];
+
+#endif
+
+using float_powers = float_powers_template<>;
+
+#ifdef FASTFLOAT_COMPACT_POWERS_TABLE
+/**
+ * The same powers of five, in about 800 bytes instead of 10 KB: we keep
+ * every 27th power, and the others are obtained with one multiplication by
+ * a power of five that fits in 64 bits, 5^0 to 5^26. The top 128 bits of
+ * that product are within -1 and +2 of the entry of power_of_five_128: the
+ * difference is stored in 2 bits per power, so that the values match
+ * exactly. See compact_power_of_five_128 in decimal_to_binary.h.
+ */
+template <class unused = void> struct compact_powers_template {
+  constexpr static am_pow_t step = 27;
+  constexpr static am_pow_t number_of_powers =
+      powers::largest_power_of_five - powers::smallest_power_of_five + 1;
+  constexpr static am_pow_t number_of_entries =
+      2 * ((number_of_powers + step - 1) / step);
+  // 5^-342, 5^-315, ..., 5^306 as in power_of_five_128.
+  constexpr static am_mant_t power_of_five_128[number_of_entries] = {
+      0xeef453d6923bd65a, 0x113faa2906a13b3f,
+      0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+      0x9becce62836ac577, 0x4ee367f9430aec32,
+      0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+      0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09,
+      0xa46116538d0deb78, 0x52d9be85f074e608,
+      0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073,
+      0xd686619ba27255a2, 0xc80a537b0efefebd,
+      0xad4ab7112eb3929d, 0x86c16c98d2c953c6,
+      0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+      0xe2280b6c20dd5232, 0x25c6da63c38de1b0,
+      0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+      0x9392ee8e921d5d07, 0x3aff322e62439fd0,
+      0xee6b280000000000, 0x0,
+      0xc097ce7bc90715b3, 0x4b9f100000000000,
+      0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+      0xfb5878494ace3a5f, 0x4ab48a04065c723,
+      0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+      0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6,
+      0x847c9b5d7c2e09b7, 0x69956135febada11,
+      0xd60b3bd56a5586f1, 0x8a71e223d8d3b074,
+      0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+      0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e,
+      0xe1a63853bbd26451, 0x5e7873f8a0396973,
+      0xb6472e511c81471d, 0xe0133fe4adf8e952,
+  };
+  // 5^0 to 5^26, shifted left so that the most significant bit is set.
+  constexpr static uint64_t small_power_of_five[step] = {
+      0x8000000000000000,
+      0xa000000000000000,
+      0xc800000000000000,
+      0xfa00000000000000,
+      0x9c40000000000000,
+      0xc350000000000000,
+      0xf424000000000000,
+      0x9896800000000000,
+      0xbebc200000000000,
+      0xee6b280000000000,
+      0x9502f90000000000,
+      0xba43b74000000000,
+      0xe8d4a51000000000,
+      0x9184e72a00000000,
+      0xb5e620f480000000,
+      0xe35fa931a0000000,
+      0x8e1bc9bf04000000,
+      0xb1a2bc2ec5000000,
+      0xde0b6b3a76400000,
+      0x8ac7230489e80000,
+      0xad78ebc5ac620000,
+      0xd8d726b7177a8000,
+      0x878678326eac9000,
+      0xa968163f0a57b400,
+      0xd3c21bcecceda100,
+      0x84595161401484a0,
+      0xa56fa5b99019a5c8,
+  };
+  // For each power from 5^-342, the correction plus one, 2 bits each, from
+  // the least significant bits.
+  constexpr static uint64_t correction[(number_of_powers + 31) / 32] = {
+      0x6a5a65656a6aa995,
+      0xa69a95559a9a5a56,
+      0x9565555699a9aa9a,
+      0x565aa95a99a59656,
+      0xaaaaaa6aeba655a5,
+      0x9569a69a9a6a969a,
+      0x595599a5a56956aa,
+      0xa595aa5955555555,
+      0x55555555599aa9aa,
+      0xab96655655555555,
+      0x44105555555541fa,
+      0x5555555555555555,
+      0x99aaa55555555555,
+      0xaaaa69a9a9696656,
+      0x55556aa5595aaa5a,
+      0x5666655555955955,
+      0xa96aa96669a69a95,
+      0x9aaa5a5aaaa9a9aa,
+      0x5565565aa56aaa6a,
+      0xa969aaaaa5955696,
+      0x0000000000156aab,
+  };
+};
+
+#if FASTFLOAT_DETAIL_MUST_DEFINE_CONSTEXPR_VARIABLE
+
+template <class unused>
+constexpr am_mant_t
+    compact_powers_template<unused>::power_of_five_128[number_of_entries];
+
+template <class unused>
+constexpr uint64_t compact_powers_template<unused>::small_power_of_five[step];
+
+template <class unused>
+constexpr uint64_t compact_powers_template<
+    unused>::correction[(number_of_powers + 31) / 32];
+
+#endif
+
+using compact_powers = compact_powers_template<>;
+#endif
+
 } // namespace fast_float
 
 #endif
@@ -0,0 +1,244 @@
+#ifndef FASTFLOAT_FIELD_INDEX_H
+#define FASTFLOAT_FIELD_INDEX_H
+
+#include <cstddef>
+#include <algorithm>
+#include <system_error>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "parse_number.h"
+
+namespace fast_float {
+
+/** A field of an indexed text: where it starts and what it holds. */
+template <typename T> struct indexed_field_t {
+  /** The offset of the field in the text */
+  size_t start;
+  /** The value of the field, T() if it is not a number */
+  T value;
+  /**
+   * As for from_chars_advanced, and std::errc::invalid_argument if the number
+   * does not span the whole field
+   */
+  std::errc ec;
+};
+
+/**
+ * The fields of a text, with their offsets and values, kept up to date as
+ * the text is edited. Fields are separated by `separator` or by a newline,
+ * a "\r\n" being one newline. A separator or a newline at the end of the text
+ * is not followed by a field. Each field is parsed with from_chars_advanced,
+ * and is only valid if the number spans all of it. With
+ * FASTFLOAT_ISNOT_CHECKED_BOUNDS, every field must be a number.
+ *
+ * After an edit, only the fields which the edit touched are parsed again, and
+ * the fields after it keep their values. When the length of the text changes,
+ * their offsets are not updated at once: the shift is recorded, and applied to
+ * the fields between an edit and the next one, so that edits close together,
+ * as typing or appending, cost about the size of the change. Only an edit
+ * which changes the number of fields moves all the fields after it.
+ *
+ * The fields are stored in the array given to the constructor, which the
+ * caller owns: the index does not allocate. An update that would need more
+ * than `capacity` fields fails with `std::errc::value_too_large` and leaves
+ * the index as it was, for the text before the update.
+ */
+template <typename T, typename UC> struct field_index_t {
+  field_index_t(indexed_field_t<T> *const fields, size_t const capacity,
+                UC const separator = UC(','),
+                parse_options_t<UC> const options =
+                    parse_options_t<UC>()) noexcept
+      : fields_(fields), capacity_(capacity), separator_(separator),
+        options_(options) {}
+
+  /** Indexes all the fields of the text [first, last). */
+  std::errc build(UC const *first, UC const *last) noexcept {
+    size_t const count = count_fields(first, last);
+    if (count > capacity_) {
+      return std::errc::value_too_large;
+    }
+    parse_fields(first, first, last, fields_);
+    size_ = count;
+    shifted_ = count;
+    shift_ = 0;
+    text_size_ = size_t(last - first);
+    return std::errc();
+  }
+
+  /**
+   * Updates the index after an edit: the `removed` characters at `offset`
+   * were replaced by `inserted` characters, and [first, last) is the text
+   * after the edit. Fails with std::errc::invalid_argument if the edit does
+   * not match the sizes of the texts.
+   */
+  std::errc replace(UC const *first, UC const *last, size_t const offset,
+                    size_t const removed, size_t const inserted) noexcept {
+    size_t const new_size = size_t(last - first);
+    if (offset > text_size_ || removed > text_size_ - offset ||
+        new_size != text_size_ - removed + inserted) {
+      return std::errc::invalid_argument;
+    }
+    // The fields from the one holding the first edited character to the one
+    // holding the character after the edit are parsed again, from the text
+    // between the start of the first and the start of the next one, which
+    // have not moved in the text before and after the edit respectively.
+    size_t begin = 0;
+    size_t end = 0;
+    size_t from = 0;
+    size_t to = new_size;
+    if (size_ != 0) {
+      begin = field_at(offset);
+      end = field_at(offset + removed) + 1;
+      from = start(begin);
+      if (end != size_) {
+        to = start(end) - removed + inserted;
+      }
+    }
+    size_t const count = count_fields(first + from, first + to);
+    if (size_ - (end - begin) + count > capacity_) {
+      return std::errc::value_too_large;
+    }
+    // The pending shift is moved to the fields after the edit, to which the
+    // shift of the edit is added, and they are moved in place if the number
+    // of fields changes.
+    if (shifted_ < end) {
+      add_to_starts(shifted_, end, shift_);
+    } else {
+      add_to_starts(end, shifted_, size_t(0) - shift_);
+    }
+    if (begin + count < end) {
+      std::copy(fields_ + end, fields_ + size_, fields_ + begin + count);
+    } else if (begin + count > end) {
+      std::copy_backward(fields_ + end, fields_ + size_,
+                         fields_ + size_ - end + begin + count);
+    }
+    size_ = size_ - (end - begin) + count;
+    shifted_ = begin + count;
+    shift_ = shift_ - removed + inserted;
+    parse_fields(first, first + from, first + to, fields_ + begin);
+    text_size_ = new_size;
+    return std::errc();
+  }
+
+  /**
+   * Updates the index after characters were appended to the text, which is
+   * now [first, last).
+   */
+  std::errc append(UC const *first, UC const *last) noexcept {
+    if (size_t(last - first) < text_size_) {
+      return std::errc::invalid_argument;
+    }
+    return replace(first, last, text_size_, 0,
+                   size_t(last - first) - text_size_);
+  }
+
+  /** The number of fields. */
+  size_t size() const noexcept { return size_; }
+
+  /** The field i, in the order of the text. */
+  indexed_field_t<T> operator[](size_t const i) const noexcept {
+    indexed_field_t<T> field = fields_[i];
+    field.start = start(i);
+    return field;
+  }
+
+  /**
+   * The fields, in the order of the text, once the pending shift is applied
+   * to all of them.
+   */
+  indexed_field_t<T> const *fields() noexcept {
+    add_to_starts(shifted_, size_, shift_);
+    shifted_ = size_;
+    shift_ = 0;
+    return fields_;
+  }
+
+  /** The number of fields parsed so far, by all the updates. */
+  size_t parsed() const noexcept { return parsed_; }
+
+private:
+  // The offset of the field i: the fields from shifted_ on are yet to be
+  // shifted by shift_, modulo 2^N.
+  size_t start(size_t const i) const noexcept {
+    return i < shifted_ ? fields_[i].start : fields_[i].start + shift_;
+  }
+
+  void add_to_starts(size_t i, size_t const end, size_t const shift) noexcept {
+    if (shift == 0) {
+      return;
+    }
+    for (; i < end; ++i) {
+      fields_[i].start += shift;
+    }
+  }
+
+  // The last field which starts at or before offset, of at least one.
+  size_t field_at(size_t const offset) const noexcept {
+    size_t low = 0;
+    size_t high = size_;
+    while (high - low > 1) {
+      size_t const middle = low + (high - low) / 2;
+      if (start(middle) <= offset) {
+        low = middle;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  // The fields of [p, pend), which ends at the end of the text or after a
+  // separator or a newline.
+  size_t count_fields(UC const *p, UC const *const pend) const noexcept {
+    size_t count = 0;
+    while (p != pend) {
+      UC const *const end = find_delimiter(p, pend, separator_);
+      ++count;
+      if (end == pend) {
+        break;
+      }
+      p = end + 1;
+    }
+    return count;
+  }
+
+  void parse_fields(UC const *const text, UC const *p, UC const *const pend,
+                    indexed_field_t<T> *field) noexcept {
+    while (p != pend) {
+      UC const *const end = find_delimiter(p, pend, separator_);
+      UC const *last = end;
+      if (end != pend && *end == UC('\n') && last != p &&
+          last[-1] == UC('\r')) {
+        --last;
+      }
+      field->start = size_t(p - text);
+      field->value = T();
+      from_chars_result_t<UC> const answer =
+          from_chars_advanced(p, last, field->value, options_);
+      field->ec = (answer.ec == std::errc() && answer.ptr != last)
+                      ? std::errc::invalid_argument
+                      : answer.ec;
+      ++field;
+      ++parsed_;
+      if (end == pend) {
+        break;
+      }
+      p = end + 1;
+    }
+  }
+
+  indexed_field_t<T> *fields_;
+  size_t capacity_;
+  UC separator_;
+  parse_options_t<UC> options_;
+  size_t size_ = 0;
+  size_t shifted_ = 0;
+  size_t shift_ = 0;
+  size_t text_size_ = 0;
+  size_t parsed_ = 0;
+};
+
+} // namespace fast_float
+
+#endif
@@ -2,6 +2,7 @@
 #define FASTFLOAT_FLOAT_COMMON_H
 
 #include <cfloat>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cassert>
@@ -57,7 +58,7 @@ constexpr static am_pow_t am_bias_limit =
     (std::numeric_limits<int16_t>::max() / 16) - 1;
 
 // Type for enum chars_format.
-typedef uint_fast8_t chars_format_t;
+typedef uint_fast16_t chars_format_t;
 
 // Type for base, only allowed from 2 to 36.
 typedef uint_fast8_t base_t;
@@ -85,6 +86,9 @@ enum class chars_format : chars_format_t {
   // Extension of RFC 8259 where, e.g., "inf" and "nan" are allowed.
   json_or_infnan = chars_format_t(detail::basic_json_fmt) | general,
   fortran = chars_format_t(detail::basic_fortran_fmt) | general,
+  // Integer types also accept a fraction and an exponent ("1e6", "2.50E3")
+  // as long as the value is integral. Only used with base 10.
+  allow_integral_float = 1 << 8,
 #endif
 };
 
@@ -100,11 +104,94 @@ template <typename UC> struct from_chars_result_t {
 
 using from_chars_result = from_chars_result_t<char>;
 
+/** The kind of token recognized by lex_number */
+enum class number_kind : uint8_t {
+  /** A plain run of digits whose value fits in int64_t */
+  integer,
+  /** A number with a fraction or an exponent, or an integer beyond int64_t */
+  decimal,
+  /** inf, infinity or nan */
+  special
+};
+
+template <typename UC> struct lex_result_t {
+  UC const *ptr;
+  std::errc ec;
+  number_kind kind;
+  union {
+    /** Set when kind is number_kind::integer */
+    int64_t integer;
+    /** Set when kind is number_kind::decimal or number_kind::special */
+    double decimal;
+  };
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == std::errc();
+  }
+};
+
+using lex_result = lex_result_t<char>;
+
+template <typename UC> struct from_chars_array_result_t {
+  UC const *ptr;
+  std::errc ec;
+  /** The number of values stored */
+  size_t count;
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == std::errc();
+  }
+};
+
+using from_chars_array_result = from_chars_array_result_t<char>;
+
+template <typename UC> struct from_chars_interval_result_t {
+  UC const *ptr;
+  std::errc ec;
+  /** Set when the number is representable: the two bounds are then equal */
+  bool exact;
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == std::errc();
+  }
+};
+
+using from_chars_interval_result = from_chars_interval_result_t<char>;
+
+template <typename UC> struct from_chars_dual_result_t {
+  UC const *ptr;
+  /** The error for the double value */
+  std::errc ec;
+  /** The error for the float value, which may overflow or underflow alone */
+  std::errc float_ec;
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == std::errc();
+  }
+};
+
+using from_chars_dual_result = from_chars_dual_result_t<char>;
+
+/** How a number that is not representable is rounded */
+enum class rounding_mode : uint8_t {
+  /** To nearest, ties to even, whatever the floating-point environment */
+  nearest_even,
+  /** Toward zero: the magnitude is truncated */
+  toward_zero,
+  /** Toward positive infinity */
+  upward,
+  /** Toward negative infinity */
+  downward,
+  /** Like strtod: as the floating-point environment (fesetround) rounds */
+  follow_fpu
+};
+
 template <typename UC> struct parse_options_t {
   constexpr explicit parse_options_t(
       chars_format const fmt = chars_format::general, UC const dot = UC('.'),
-      base_t const b = 10) noexcept
-      : format(fmt), base(b), decimal_point(dot) {}
+      base_t const b = 10,
+      rounding_mode const r = rounding_mode::nearest_even) noexcept
+      : format(fmt), base(b), decimal_point(dot), rounding(r) {}
 
   /** Which number formats are accepted */
   chars_format format;
@@ -112,10 +199,58 @@ template <typename UC> struct parse_options_t {
   base_t base;
   /** The character used as decimal point for floats */
   UC decimal_point;
+  /** How float, double and the half-precision bit patterns are rounded */
+  rounding_mode rounding;
 };
 
 using parse_options = parse_options_t<char>;
 
+/** Which numbers of a free text extract_numbers keeps */
+enum class number_boundary : uint8_t {
+  /** Every number, even within a word: "x86" gives 86 */
+  none,
+  /** The numbers which do not follow a letter, a digit or '_': "x86" and
+   * "v1.2" are skipped, "12ms" gives 12 and "2024-10-19" gives 2024, 10, 19 */
+  start,
+  /** The numbers which neither follow nor precede a letter, a digit or '_':
+   * "12ms" is skipped too */
+  word
+};
+
+template <typename UC> struct extract_options_t {
+  constexpr explicit extract_options_t(
+      number_boundary const b = number_boundary::start,
+      bool const integers = true,
+      parse_options_t<UC> const n = parse_options_t<UC>()) noexcept
+      : boundary(b), prefer_integers(integers), number(n) {}
+
+  /** Which numbers are kept */
+  number_boundary boundary;
+  /** Whether the plain digit runs which fit in int64_t are reported as
+   * integers, or every number as a decimal */
+  bool prefer_integers;
+  /** The format and the decimal point of the numbers */
+  parse_options_t<UC> number;
+};
+
+using extract_options = extract_options_t<char>;
+
+/** A number found in a text by extract_numbers */
+struct extracted_number {
+  /** The offset of its first char, its sign if any, in the text */
+  size_t offset;
+  /** The number of its chars */
+  size_t length;
+  /** number_kind::integer or number_kind::decimal, as for lex_number */
+  number_kind kind;
+  union {
+    /** Set when kind is number_kind::integer */
+    int64_t integer;
+    /** Set when kind is number_kind::decimal */
+    double decimal;
+  };
+};
+
 } // namespace fast_float
 
 #if (defined(__x86_64) || defined(__x86_64__) || defined(_M_X64) ||            \
@@ -146,6 +281,18 @@ using parse_options = parse_options_t<char>;
 #endif
 #endif
 
+// from_chars supports __int128_t and __uint128_t where the compiler has them.
+#ifdef __SIZEOF_INT128__
+#define FASTFLOAT_HAS_INT128 1
+#endif
+
+// The extended fast path checks a rounded product with a fused
+// multiply-add: only where the hardware has one, and where double
+// expressions are evaluated in double precision.
+#if defined(FP_FAST_FMA) && defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+#define FASTFLOAT_HAS_FAST_FMA 1
+#endif
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #define FASTFLOAT_VISUAL_STUDIO 1
 #endif
@@ -262,6 +409,14 @@ static_assert(FASTFLOAT_X86_SIMD == 20 || FASTFLOAT_X86_SIMD == 42 ||
 #define fastfloat_unlikely(x) (x)
 #endif
 
+// FASTFLOAT_TRUSTED_INPUT: every input is a well-formed number of the
+// requested format, as printed by a serializer, so the grammar is not
+// checked. A malformed input is undefined behavior; the skipped checks are
+// FASTFLOAT_DEBUG_ASSERT, so a debug build can verify the contract.
+#if defined(FASTFLOAT_TRUSTED_INPUT) && !defined(FASTFLOAT_ISNOT_CHECKED_BOUNDS)
+#define FASTFLOAT_ISNOT_CHECKED_BOUNDS
+#endif
+
 // clang-format off
 #ifndef FASTFLOAT_ASSERT
 #define FASTFLOAT_ASSERT(x)                                                    \
@@ -311,10 +466,29 @@ fastfloat_really_inline constexpr bool is_constant_evaluated() noexcept {
 }
 #endif
 
+// IEEE 754 binary16 and bfloat16 values as their bit patterns. Unlike
+// std::float16_t and std::bfloat16_t, they need neither C++23 nor compiler
+// support for half-precision arithmetic.
+struct float16_bits {
+  uint16_t bits;
+};
+
+struct bfloat16_bits {
+  uint16_t bits;
+};
+
+template <typename T>
+struct is_half_bits_type
+    : std::integral_constant<bool, std::is_same<T, float16_bits>::value ||
+                                       std::is_same<T, bfloat16_bits>::value> {
+};
+
 template <typename T>
 struct is_supported_float_type
     : std::integral_constant<
-          bool, std::is_same<T, double>::value || std::is_same<T, float>::value
+          bool, std::is_same<T, double>::value ||
+                    std::is_same<T, float>::value ||
+                    is_half_bits_type<T>::value
 #ifdef __STDCPP_FLOAT64_T__
                     || std::is_same<T, std::float64_t>::value
 #endif
@@ -338,7 +512,68 @@ using equiv_uint_t = typename std::conditional<
         typename std::conditional<sizeof(T) == 4, uint32_t,
                                   uint64_t>::type>::type>::type;
 
-template <typename T> struct is_supported_integer_type : std::is_integral<T> {};
+// Under strict ISO modes std::is_integral and std::is_signed report false for
+// the 128-bit integer extension, so they are recognized explicitly.
+template <typename T> struct is_int128 : std::false_type {};
+
+#ifdef FASTFLOAT_HAS_INT128
+template <> struct is_int128<__int128_t> : std::true_type {};
+
+template <> struct is_int128<__uint128_t> : std::true_type {};
+#endif
+
+template <typename T>
+struct is_supported_integer_type
+    : std::integral_constant<bool, std::is_integral<T>::value ||
+                                       is_int128<T>::value> {};
+
+template <typename T>
+struct is_signed_integer
+    : std::integral_constant<bool, std::is_signed<T>::value
+#ifdef FASTFLOAT_HAS_INT128
+                                       || std::is_same<T, __int128_t>::value
+#endif
+                             > {
+};
+
+// IEEE 754 decimal floating-point values in the binary integer decimal (BID)
+// encoding, as used by the Intel Decimal Floating-Point Math Library and the
+// GCC _Decimal64/_Decimal128 types on x86.
+struct decimal64 {
+  uint64_t bits;
+};
+
+struct decimal128 {
+  uint64_t low;
+  uint64_t high;
+};
+
+template <typename T>
+struct is_supported_decimal_type
+    : std::integral_constant<bool, std::is_same<T, decimal64>::value ||
+                                       std::is_same<T, decimal128>::value> {};
+
+// The binary floating-point types wider than double: long double when it is
+// the x87 80-bit extended format or IEEE 754 binary128 (or merely double), and
+// the binary128 types __float128 and std::float128_t.
+template <typename T>
+struct is_supported_extended_float_type
+    : std::integral_constant<
+          bool,
+#if LDBL_MANT_DIG == 53 || LDBL_MANT_DIG == 113 ||                             \
+    (LDBL_MANT_DIG == 64 && !FASTFLOAT_IS_BIG_ENDIAN)
+          std::is_same<T, long double>::value
+#else
+          false
+#endif
+#ifdef __SIZEOF_FLOAT128__
+              || std::is_same<T, __float128>::value
+#endif
+#ifdef __STDCPP_FLOAT128_T__
+              || std::is_same<T, std::float128_t>::value
+#endif
+          > {
+};
 
 template <typename UC>
 struct is_supported_char_type
@@ -558,7 +793,7 @@ leading_zeroes(uint64_t input_num) noexcept {
     return leading_zeroes_generic(input_num);
   }
 #ifdef FASTFLOAT_VISUAL_STUDIO
-#if FASTFLOAT_X86_SIMD >= 52
+#if FASTFLOAT_X86_SIMD >= 52 && defined(_M_X64)
   // use lzcnt on MSVC only on AVX2 capable CPU's that all have this BMI
   // instruction
   return __lzcnt64(input_num);
@@ -569,7 +804,14 @@ leading_zeroes(uint64_t input_num) noexcept {
   _BitScanReverse64(&leading_zero, input_num);
   return static_cast<limb_t>(63 - leading_zero);
 #else
-  return static_cast<limb_t>(leading_zeroes_generic(input_num));
+  // _BitScanReverse64 needs a 64-bit target: scan each half.
+  unsigned long leading_zero;
+  if (_BitScanReverse(&leading_zero,
+                      static_cast<unsigned long>(input_num >> 32))) {
+    return static_cast<limb_t>(31 - leading_zero);
+  }
+  _BitScanReverse(&leading_zero, static_cast<unsigned long>(input_num));
+  return static_cast<limb_t>(63 - leading_zero);
 #endif
 #elif FASTFLOAT_HAS_BUILTIN(__builtin_clzll)
   return static_cast<limb_t>(__builtin_clzll(input_num));
@@ -629,27 +871,48 @@ countr_zero_32(uint32_t input_num) noexcept {
 #endif
 }
 
+/* count the bits set in a 64-bit integer */
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 limb_t
+popcount_64(uint64_t input_num) noexcept {
+#if (defined(__POPCNT__) || defined(__aarch64__)) &&                         \
+    FASTFLOAT_HAS_BUILTIN(__builtin_popcountll)
+  return static_cast<limb_t>(__builtin_popcountll(input_num));
+#else
+  // Without the instruction, the builtin is a library call: add the bits in
+  // pairs, nibbles, then bytes.
+  input_num -= (input_num >> 1) & 0x5555555555555555;
+  input_num = (input_num & 0x3333333333333333) +
+              ((input_num >> 2) & 0x3333333333333333);
+  input_num = (input_num + (input_num >> 4)) & 0x0F0F0F0F0F0F0F0F;
+  return static_cast<limb_t>((input_num * 0x0101010101010101) >> 56);
+#endif
+}
+
 fastfloat_really_inline constexpr uint64_t emulu_generic(uint32_t x,
                                                          uint32_t y) noexcept {
   return x * static_cast<uint64_t>(y);
 }
 
+// The four partial products are independent, and the middle column is summed
+// without comparisons since it cannot overflow: on 32-bit targets, where each
+// 64-bit comparison and carry takes several instructions, this is the shortest
+// dependency chain.
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 uint64_t
 umul128_generic(uint64_t ab, uint64_t cd, uint64_t &hi) noexcept {
-  auto ab_shifted = static_cast<uint32_t>(ab >> 32);
-  auto cd_shifted = static_cast<uint32_t>(cd >> 32);
-
-  auto ad = emulu_generic(ab_shifted, static_cast<uint32_t>(cd));
-  auto bd = emulu_generic(static_cast<uint32_t>(ab), static_cast<uint32_t>(cd));
-  auto adbc = ad + emulu_generic(static_cast<uint32_t>(ab), cd_shifted);
-  auto adbc_carry = static_cast<uint64_t>(adbc < ad) << 32;
-  auto lo = bd + (adbc << 32);
+  auto const a = static_cast<uint32_t>(ab >> 32);
+  auto const b = static_cast<uint32_t>(ab);
+  auto const c = static_cast<uint32_t>(cd >> 32);
+  auto const d = static_cast<uint32_t>(cd);
 
-  hi = emulu_generic(ab_shifted, cd_shifted) +
-       static_cast<uint32_t>(adbc >> 32) + adbc_carry +
-       static_cast<uint64_t>(lo < bd);
+  uint64_t const ac = emulu_generic(a, c);
+  uint64_t const ad = emulu_generic(a, d);
+  uint64_t const bc = emulu_generic(b, c);
+  uint64_t const bd = emulu_generic(b, d);
+  uint64_t const middle = (bd >> 32) + static_cast<uint32_t>(ad) +
+                          static_cast<uint32_t>(bc);
 
-  return lo;
+  hi = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+  return (middle << 32) | static_cast<uint32_t>(bd);
 }
 
 // Compute hi and low parts of 128-bit.
@@ -685,6 +948,20 @@ full_multiplication(uint64_t a, uint64_t b) noexcept {
   return answer;
 }
 
+// Compute v = v * mul + add. Returns false if the exact result does not fit
+// in 128 bits, in which case v is left truncated.
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
+multiply_add(value128 &v, uint64_t const mul, uint64_t const add) noexcept {
+  value128 const lo = full_multiplication(v.low, mul);
+  value128 const hi = full_multiplication(v.high, mul);
+  v.low = lo.low + add;
+  uint64_t const carry = uint64_t(v.low < add);
+  v.high = hi.low + lo.high;
+  bool const fits = hi.high == 0 && v.high >= lo.high;
+  v.high += carry;
+  return fits && v.high >= carry;
+}
+
 /* alignas(16) - better data cache usage without align */
 struct adjusted_mantissa {
   am_mant_t mantissa;
@@ -704,6 +981,28 @@ struct adjusted_mantissa {
 // used by parse_digits_until_19
 constexpr am_mant_t minimal_nineteen_digit_integer{1000000000000000000ULL};
 
+// 1e0 to 1e19
+constexpr static uint64_t powers_of_ten_uint64[] = {1UL,
+                                                    10UL,
+                                                    100UL,
+                                                    1000UL,
+                                                    10000UL,
+                                                    100000UL,
+                                                    1000000UL,
+                                                    10000000UL,
+                                                    100000000UL,
+                                                    1000000000UL,
+                                                    10000000000UL,
+                                                    100000000000UL,
+                                                    1000000000000UL,
+                                                    10000000000000UL,
+                                                    100000000000000UL,
+                                                    1000000000000000UL,
+                                                    10000000000000000UL,
+                                                    100000000000000000UL,
+                                                    1000000000000000000UL,
+                                                    10000000000000000000UL};
+
 // used for binary_format_lookup_tables<T>::max_mantissa
 constexpr am_mant_t constant_55555 = 5 * 5 * 5 * 5 * 5;
 
@@ -785,6 +1084,35 @@ constexpr uint64_t binary_format_lookup_tables<double, U>::max_mantissa[];
 
 #endif
 
+#ifdef FASTFLOAT_HAS_FAST_FMA
+// 1e-23 to 1e-44 as unevaluated sums high + low: high is the nearest double
+// and low the nearest double to what remains. Used by the extended fast path.
+template <typename U = void> struct split_negative_powers_of_ten {
+  static constexpr double high[] = {
+      1e-23, 1e-24, 1e-25, 1e-26, 1e-27, 1e-28, 1e-29, 1e-30,
+      1e-31, 1e-32, 1e-33, 1e-34, 1e-35, 1e-36, 1e-37, 1e-38,
+      1e-39, 1e-40, 1e-41, 1e-42, 1e-43, 1e-44};
+  static constexpr double low[] = {
+      3.956530198510069e-40,   7.629950044829718e-41,  -3.849486974919184e-42,
+      -3.849486974919184e-43,  -3.849486974919184e-44, 2.876745653839938e-45,
+      5.679342582489572e-46,   -8.333642060758599e-47, -8.333642060758598e-48,
+      -5.59673099762419e-49,   -5.596730997624191e-50, 7.232539610818348e-51,
+      -7.8575451945823805e-53, 5.8961572557722515e-53, -6.632427322784916e-54,
+      3.8080598260127236e-55,  7.070712060011985e-56,  7.070712060011986e-57,
+      -5.761291134237854e-59,  -3.76231293568869e-59,  -7.745042713519821e-60,
+      4.700987842202463e-61};
+};
+
+#if FASTFLOAT_DETAIL_MUST_DEFINE_CONSTEXPR_VARIABLE
+
+template <typename U>
+constexpr double split_negative_powers_of_ten<U>::high[];
+
+template <typename U> constexpr double split_negative_powers_of_ten<U>::low[];
+
+#endif
+#endif
+
 template <typename U> struct binary_format_lookup_tables<float, U> {
   static constexpr float powers_of_ten[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
                                             1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
@@ -1182,6 +1510,54 @@ inline constexpr am_digits binary_format<std::bfloat16_t>::max_digits() {
 }
 #endif // __STDCPP_BFLOAT16_T__
 
+// The half-precision bit patterns share the parameters of std::float16_t and
+// std::bfloat16_t, except for the fast path: it has no arithmetic of its own
+// and rounds 64-bit integers instead (see clinger_fast_path_impl), hence the
+// wider exponent bound.
+template <> struct binary_format<float16_bits> {
+  using equiv_uint = uint16_t;
+
+  static constexpr am_bits_t mantissa_explicit_bits() { return 10; }
+  static constexpr am_pow_t minimum_exponent() { return -15; }
+  static constexpr am_pow_t infinite_power() { return 0x1F; }
+  static constexpr am_bits_t sign_index() { return 15; }
+  static constexpr am_bits_t min_exponent_fast_path() { return 0; }
+  static constexpr am_bits_t max_exponent_fast_path() { return 19; }
+  static constexpr am_pow_t max_exponent_round_to_even() { return 5; }
+  static constexpr am_pow_t min_exponent_round_to_even() { return -22; }
+  static constexpr am_mant_t max_mantissa_fast_path() {
+    return am_mant_t(2) << mantissa_explicit_bits();
+  }
+  static constexpr am_pow_t largest_power_of_ten() { return 4; }
+  static constexpr am_pow_t smallest_power_of_ten() { return -27; }
+  static constexpr am_digits max_digits() { return 22; }
+  static constexpr equiv_uint exponent_mask() { return 0x7C00; }
+  static constexpr equiv_uint mantissa_mask() { return 0x03FF; }
+  static constexpr equiv_uint hidden_bit_mask() { return 0x0400; }
+};
+
+template <> struct binary_format<bfloat16_bits> {
+  using equiv_uint = uint16_t;
+
+  static constexpr am_bits_t mantissa_explicit_bits() { return 7; }
+  static constexpr am_pow_t minimum_exponent() { return -127; }
+  static constexpr am_pow_t infinite_power() { return 0xFF; }
+  static constexpr am_bits_t sign_index() { return 15; }
+  static constexpr am_bits_t min_exponent_fast_path() { return 0; }
+  static constexpr am_bits_t max_exponent_fast_path() { return 19; }
+  static constexpr am_pow_t max_exponent_round_to_even() { return 3; }
+  static constexpr am_pow_t min_exponent_round_to_even() { return -24; }
+  static constexpr am_mant_t max_mantissa_fast_path() {
+    return am_mant_t(2) << mantissa_explicit_bits();
+  }
+  static constexpr am_pow_t largest_power_of_ten() { return 38; }
+  static constexpr am_pow_t smallest_power_of_ten() { return -60; }
+  static constexpr am_digits max_digits() { return 98; }
+  static constexpr equiv_uint exponent_mask() { return 0x7F80; }
+  static constexpr equiv_uint mantissa_mask() { return 0x007F; }
+  static constexpr equiv_uint hidden_bit_mask() { return 0x0080; }
+};
+
 template <>
 inline constexpr am_mant_t
 binary_format<double>::max_mantissa_fast_path(am_pow_t power) {
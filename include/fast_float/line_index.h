@@ -0,0 +1,231 @@
+#ifndef FASTFLOAT_LINE_INDEX_H
+#define FASTFLOAT_LINE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "parse_number.h"
+
+namespace fast_float {
+
+/**
+ * A sampled index of the lines of a text, to parse any range of rows of a
+ * huge file without scanning it from the start: the offset of every
+ * `stride`-th line is stored in a caller-owned array of uint64_t. A line is
+ * found from the sample before it by skipping at most `stride - 1` newlines,
+ * 16 chars at a time, and a field of a line by skipping separators the same
+ * way.
+ *
+ * The index is the stride, the number of lines and the `samples()` offsets,
+ * which may be written to a file as they are and used again, e.g. on a memory
+ * map of the text, with the second constructor. A line ends with a newline,
+ * or with the text; a newline at the end of the text is not followed by a
+ * line. The index does not allocate, and does not start threads: a parallel
+ * build is given a function which runs jobs, see build().
+ */
+template <typename UC> struct line_index_t {
+  /** An empty index, which keeps the offset of every `stride`-th line. */
+  line_index_t(uint64_t *const starts, size_t const capacity,
+               uint64_t const stride = 1024) noexcept
+      : starts_(starts), capacity_(capacity), stride_(stride == 0 ? 1 : stride),
+        lines_(0) {}
+
+  /**
+   * An index built before: `starts` holds the offsets of the lines 0,
+   * `stride`, 2 `stride`... of the `lines` lines of the text.
+   */
+  line_index_t(uint64_t *const starts, size_t const capacity,
+               uint64_t const stride, uint64_t const lines) noexcept
+      : starts_(starts), capacity_(capacity), stride_(stride == 0 ? 1 : stride),
+        lines_(lines) {}
+
+  /**
+   * Indexes the lines of the text [first, last), in one pass. Fails with
+   * `std::errc::value_too_large`, and an empty index, if there are more than
+   * `capacity * stride` lines.
+   */
+  std::errc build(UC const *const first, UC const *const last) noexcept {
+    uint64_t newlines = 0;
+    if (!sample_lines(first, last, first, last, 0, newlines)) {
+      lines_ = 0;
+      return std::errc::value_too_large;
+    }
+    lines_ = count_lines(first, last, newlines);
+    return std::errc();
+  }
+
+  /**
+   * Indexes the lines of the text [first, last) in `chunks` parts (at most
+   * 256), which may be scanned by as many threads: `for_each(count, job)`
+   * must call `job(i)` once for each i in [0, count), in any order and at the
+   * same time or not, and return when all are done. The text is read twice,
+   * first to count the newlines of each part, then to store the offsets.
+   */
+  template <typename ForEach>
+  std::errc build(UC const *const first, UC const *const last, size_t chunks,
+                  ForEach &&for_each) {
+    chunks = chunks == 0 ? 1 : (chunks > 256 ? 256 : chunks);
+    size_t const size = size_t(last - first);
+    size_t const chunk_size = (size + chunks - 1) / chunks;
+    uint64_t newlines[256];
+    auto const chunk_first = [=](size_t const i) {
+      return first + (i * chunk_size < size ? i * chunk_size : size);
+    };
+    for_each(chunks, [&](size_t const i) {
+      newlines[i] = count_newlines(chunk_first(i), chunk_first(i + 1));
+    });
+    uint64_t total = 0;
+    for (size_t i = 0; i < chunks; ++i) {
+      uint64_t const count = newlines[i];
+      newlines[i] = total;
+      total += count;
+    }
+    uint64_t const lines = count_lines(first, last, total);
+    if ((lines + stride_ - 1) / stride_ > capacity_) {
+      lines_ = 0;
+      return std::errc::value_too_large;
+    }
+    for_each(chunks, [&](size_t const i) {
+      uint64_t count = 0;
+      sample_lines(first, last, chunk_first(i), chunk_first(i + 1),
+                   newlines[i], count);
+    });
+    lines_ = lines;
+    return std::errc();
+  }
+
+  /** The number of lines of the text. */
+  uint64_t lines() const noexcept { return lines_; }
+
+  uint64_t stride() const noexcept { return stride_; }
+
+  /** The number of offsets stored. */
+  size_t samples() const noexcept {
+    return size_t((lines_ + stride_ - 1) / stride_);
+  }
+
+  uint64_t const *starts() const noexcept { return starts_; }
+
+  /**
+   * The start of the line `row` of the text [first, last) which was indexed,
+   * or last if there is no such line.
+   */
+  UC const *line(UC const *const first, UC const *const last,
+                 uint64_t const row) const noexcept {
+    if (row >= lines_) {
+      return last;
+    }
+    uint64_t skipped = row % stride_;
+    return skip_lines(first + size_t(starts_[row / stride_]), last, skipped);
+  }
+
+  /**
+   * Parses the field `column` (from 0) of the rows [row, row + count) of the
+   * text [first, last) which was indexed into `values`, with
+   * from_chars_advanced, as far as the text goes: the result tells how many
+   * values were stored. Fields are separated by `separator`, and a "\r\n" is
+   * one newline.
+   *
+   * A missing field, or one which is not a number of its own, stops the
+   * parsing with `std::errc::invalid_argument` and `ptr` pointing at it. A
+   * value out of range is stored, as from_chars_advanced leaves it, the
+   * parsing goes on, and `ec` is set to `std::errc::result_out_of_range`.
+   * With FASTFLOAT_ISNOT_CHECKED_BOUNDS, every field must be a number.
+   */
+  template <typename T>
+  from_chars_array_result_t<UC>
+  parse_column(UC const *const first, UC const *const last, uint64_t const row,
+               size_t const count, size_t const column, T *const values,
+               UC const separator = UC(','),
+               parse_options_t<UC> const options =
+                   parse_options_t<UC>()) const noexcept {
+    from_chars_array_result_t<UC> answer;
+    answer.ptr = line(first, last, row);
+    answer.ec = std::errc();
+    answer.count = 0;
+    size_t rows = 0;
+    if (row < lines_) {
+      rows = lines_ - row < count ? size_t(lines_ - row) : count;
+    }
+    for (; answer.count < rows; ++answer.count) {
+      UC const *field = answer.ptr;
+      for (size_t i = 0; i < column; ++i) {
+        field = find_delimiter(field, last, separator);
+        if (field == last || *field == UC('\n')) {
+          answer.ptr = field;
+          answer.ec = std::errc::invalid_argument;
+          return answer;
+        }
+        ++field;
+      }
+      T value = T();
+      from_chars_result_t<UC> const number =
+          from_chars_advanced(field, last, value, options);
+      if (number.ec == std::errc::invalid_argument ||
+          !is_field_end(number.ptr, last, separator)) {
+        answer.ptr = field;
+        answer.ec = std::errc::invalid_argument;
+        return answer;
+      }
+      if (number.ec != std::errc()) {
+        answer.ec = number.ec;
+      }
+      values[answer.count] = value;
+      uint64_t one = 1;
+      answer.ptr = skip_lines(number.ptr, last, one);
+    }
+    return answer;
+  }
+
+private:
+  // The lines of a text with that many newlines: the last one may not end
+  // with a newline.
+  static uint64_t count_lines(UC const *const first, UC const *const last,
+                              uint64_t const newlines) noexcept {
+    return newlines + uint64_t(first != last && last[-1] != UC('\n'));
+  }
+
+  // Stores the offsets of the sampled lines which start in [chunk_first,
+  // chunk_last), after `before` newlines, and counts the newlines of the
+  // part. Returns false if an offset does not fit.
+  bool sample_lines(UC const *const first, UC const *const last,
+                    UC const *const chunk_first, UC const *const chunk_last,
+                    uint64_t const before, uint64_t &newlines) noexcept {
+    if (chunk_first == first && first != last) {
+      if (capacity_ == 0) {
+        return false;
+      }
+      starts_[0] = 0;
+    }
+    // the next sampled line starts after the newline of the same number
+    uint64_t next = (before / stride_ + 1) * stride_;
+    uint64_t missing = next - before;
+    UC const *p = chunk_first;
+    for (;;) {
+      p = skip_lines(p, chunk_last, missing);
+      if (missing != 0 || p == last) {
+        break;
+      }
+      if (next / stride_ >= capacity_) {
+        return false;
+      }
+      starts_[next / stride_] = uint64_t(p - first);
+      next += stride_;
+      missing = stride_;
+    }
+    newlines = next - missing - before;
+    return true;
+  }
+
+  uint64_t *starts_;
+  size_t capacity_;
+  uint64_t stride_;
+  uint64_t lines_;
+};
+
+} // namespace fast_float
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef FASTFLOAT_PARSE_CACHE_H
+#define FASTFLOAT_PARSE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "parse_number.h"
+
+namespace fast_float {
+
+namespace detail {
+
+constexpr int cache_index_bits(size_t const slots) noexcept {
+  return slots <= 1 ? 0 : 1 + cache_index_bits(slots / 2);
+}
+
+// A token of at most 15 chars, as the run of number characters it starts:
+// its chars, the 16 - length past the run cleared, and its length. The run
+// never contains a zero, so the chars alone tell the tokens apart.
+struct cache_key {
+  uint64_t low;
+  uint64_t high;
+  size_t length;
+};
+
+// The key of the run at the start of 16 readable chars, with a length of 16
+// if the run may go on.
+fastfloat_really_inline cache_key make_cache_key(char const *chars,
+                                                 char const decimal_point) {
+  cache_key key;
+  key.length = number_run16(chars, decimal_point);
+  key.low = read_chars_to_unsigned<uint64_t>(chars);
+  key.high = read_chars_to_unsigned<uint64_t>(chars + 8);
+  if (key.length < 8) {
+    key.low &= (uint64_t(1) << (8 * key.length)) - 1;
+    key.high = 0;
+  } else if (key.length < 16) {
+    key.high &= (uint64_t(1) << (8 * (key.length - 8))) - 1;
+  }
+  return key;
+}
+
+// Wide code units are not cached.
+template <typename UC>
+fastfloat_really_inline cache_key make_cache_key(UC const *, UC) {
+  return cache_key{0, 0, 0};
+}
+
+} // namespace detail
+
+/**
+ * A direct-mapped cache of parsed numbers, for inputs which repeat the same
+ * few thousand values over and over, like the price levels of tick data or
+ * the status codes of logs. A token of at most 15 chars is recognized with a
+ * single 16-byte load: its run of number characters is hashed into one of
+ * `Slots` entries, which holds the last token of that hash with its value.
+ * On a hit the value is returned without parsing; on a miss the token is
+ * parsed with from_chars_advanced and, if it is valid, stored.
+ *
+ * `T` is a floating-point or an integer type, and the results, `ptr` and
+ * `ec` included, are those of from_chars_advanced with the same options.
+ * Longer tokens, inputs other than char, Fortran and hexadecimal formats,
+ * integers in another base than 10 and rounding_mode::follow_fpu always go to
+ * from_chars_advanced. The cache is owned by the caller, so that one thread
+ * uses it at a time: it may be declared thread_local. It takes about
+ * `Slots * (16 + sizeof(T))` bytes.
+ */
+template <typename T, typename UC, size_t Slots> struct parse_cache_t {
+  static_assert(Slots >= 2 && (Slots & (Slots - 1)) == 0,
+                "the number of slots must be a power of 2");
+
+  explicit parse_cache_t(
+      parse_options_t<UC> const options = parse_options_t<UC>()) noexcept
+      : options_(options), cacheable_(is_cacheable(options)) {
+    clear();
+  }
+
+  /**
+   * Parses the number at the start of [first, last), as from_chars_advanced
+   * would, from the cache when the same token was parsed before.
+   */
+  from_chars_result_t<UC> parse(UC const *first, UC const *last,
+                                T &value) noexcept {
+    if (!cacheable_) {
+      return parse_miss(first, last, value, nullptr, 0);
+    }
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (chars_format_t(options_.format & chars_format::skip_white_space)) {
+      first = skip_spaces(first, last);
+    }
+#endif
+    detail::cache_key const key =
+        (last - first >= 16)
+            ? detail::make_cache_key(first, options_.decimal_point)
+            : make_padded_key(first, last);
+    if (key.length == 0 || key.length == 16) {
+      return parse_miss(first, last, value, nullptr, 0);
+    }
+    entry &slot = entries_[index(key)];
+    // An empty slot has a zero key, which no run has.
+    if (slot.low == key.low && slot.high == key.high) {
+      ++hits_;
+      value = slot.value;
+      return from_chars_result_t<UC>{first + key.length, std::errc()};
+    }
+    slot.low = key.low;
+    slot.high = key.high;
+    return parse_miss(first, last, value, &slot, key.length);
+  }
+
+  /** Empties the cache, the counters are kept. */
+  void clear() noexcept {
+    for (entry &slot : entries_) {
+      slot.low = 0;
+      slot.high = 0;
+      slot.value = T();
+    }
+  }
+
+  /** The numbers returned from the cache. */
+  size_t hits() const noexcept { return hits_; }
+
+  /** The numbers parsed with from_chars_advanced. */
+  size_t misses() const noexcept { return misses_; }
+
+private:
+  struct entry {
+    uint64_t low;
+    uint64_t high;
+    T value;
+  };
+
+  static bool is_cacheable(parse_options_t<UC> const options) noexcept {
+    chars_format_t const format = chars_format_t(options.format);
+    return std::is_same<UC, char>::value &&
+           options.rounding != rounding_mode::follow_fpu &&
+           (!is_supported_integer_type<T>::value || options.base == 10) &&
+           (format & chars_format_t(chars_format::hex)) == 0
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+           && (format & chars_format_t(detail::basic_fortran_fmt)) == 0
+#endif
+        ;
+  }
+
+  // The key near the end of the input, from a copy padded with zeros, which
+  // end the run.
+  detail::cache_key make_padded_key(UC const *first,
+                                    UC const *last) const noexcept {
+    UC buffer[16] = {};
+    std::copy(first, last, buffer);
+    return detail::make_cache_key(buffer, options_.decimal_point);
+  }
+
+  // Parses a token which is not in the cache. The slot, if any, already
+  // holds its key and gets its value.
+  from_chars_result_t<UC> parse_miss(UC const *first, UC const *last,
+                                     T &value, entry *const slot,
+                                     size_t const length) noexcept {
+    ++misses_;
+    from_chars_result_t<UC> const answer =
+        from_chars_advanced(first, last, value, options_);
+    if (slot != nullptr) {
+      // A token cut short of its run, as "1e" in "1e+", depends on the
+      // characters after it: it is not stored, and neither is an error.
+      if (answer.ec == std::errc() && answer.ptr == first + length) {
+        slot->value = value;
+      } else {
+        slot->low = 0;
+        slot->high = 0;
+      }
+    }
+    return answer;
+  }
+
+  // Multiplicative hashing: the top bits of the product depend on all the
+  // chars of the token.
+  static size_t index(detail::cache_key const &key) noexcept {
+    uint64_t const h =
+        (key.low ^ (key.high * 0x9E3779B97F4A7C15)) * 0xBF58476D1CE4E5B9;
+    return size_t(h >> (64 - detail::cache_index_bits(Slots)));
+  }
+
+  parse_options_t<UC> options_;
+  bool cacheable_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  entry entries_[Slots];
+};
+
+} // namespace fast_float
+
+#endif
@@ -2,8 +2,10 @@
 #define FASTFLOAT_PARSE_NUMBER_H
 
 #include "ascii_number.h"
+#include "decimal_bid.h"
 #include "decimal_to_binary.h"
 #include "digit_comparison.h"
+#include "extended_float.h"
 #include "float_common.h"
 
 #include <cmath>
@@ -21,7 +23,8 @@ namespace detail {
  * strings a null-free and fixed.
  **/
 template <typename T, typename UC>
-from_chars_result_t<UC>
+typename std::enable_if<!is_half_bits_type<T>::value,
+                        from_chars_result_t<UC>>::type
     FASTFLOAT_CONSTEXPR14 parse_infnan(UC const *first, UC const *last,
                                        T &value,
                                        const chars_format fmt) noexcept {
@@ -74,6 +77,31 @@ from_chars_result_t<UC>
   answer.ec = std::errc::invalid_argument;
   return answer;
 }
+
+// The half-precision bit patterns get the infinity or the quiet nan of their
+// format, with the sign of the input.
+template <typename T, typename UC>
+typename std::enable_if<is_half_bits_type<T>::value,
+                        from_chars_result_t<UC>>::type
+    FASTFLOAT_CONSTEXPR20 parse_infnan(UC const *first, UC const *last,
+                                       T &value,
+                                       const chars_format fmt) noexcept {
+  float special = 0;
+  from_chars_result_t<UC> const answer =
+      parse_infnan(first, last, special, fmt);
+  if (answer.ec == std::errc()) {
+    using equiv_uint = typename binary_format<T>::equiv_uint;
+    equiv_uint bits = binary_format<T>::exponent_mask();
+    if (special != special) {
+      bits = equiv_uint(bits | binary_format<T>::hidden_bit_mask() >> 1);
+    }
+    if (bit_cast<uint32_t>(special) >> 31) {
+      bits = equiv_uint(bits | 1u << binary_format<T>::sign_index());
+    }
+    value.bits = bits;
+  }
+  return answer;
+}
 #endif
 
 #ifndef FASTFLOAT_ONLY_ROUNDS_TO_NEAREST_SUPPORTED
@@ -141,7 +169,178 @@ fastfloat_really_inline bool rounds_to_nearest() noexcept {
 #pragma GCC diagnostic pop
 #endif
 }
+
+/**
+ * Returns the rounding mode of the floating-point environment, as fegetround()
+ * would, with the same kind of probe as rounds_to_nearest(). The sums are
+ * stored in volatile floats so that any excess precision is rounded away.
+ */
+inline rounding_mode fpu_rounding_mode() noexcept {
+  static float volatile fmin = std::numeric_limits<float>::min();
+  float const fmini = fmin;
+  float volatile const above_one = 1.0f + fmini;
+  float volatile const below_one = 1.0f - fmini;
+  float volatile const below_minus_one = -1.0f - fmini;
+  // FE_UPWARD: 1 + fmin > 1
+  // FE_DOWNWARD: 1 - fmin < 1 and -1 - fmin < -1
+  // FE_TOWARDZERO: 1 - fmin < 1 and -1 - fmin == -1
+  // FE_TONEAREST: all three sums round back to 1 or -1
+  if (above_one > 1.0f) {
+    return rounding_mode::upward;
+  }
+  if (below_one < 1.0f) {
+    return (below_minus_one < -1.0f) ? rounding_mode::downward
+                                     : rounding_mode::toward_zero;
+  }
+  return rounding_mode::nearest_even;
+}
+#endif
+
+// The rounding of a call, or of a whole batch, decided before parsing: the
+// environment is probed at most once, and the parsing loop never looks at it.
+struct rounding_context {
+  // The requested mode, with follow_fpu resolved.
+  rounding_mode mode;
+  // Clinger's fast path may divide with the hardware: we round to nearest and
+  // so does the environment.
+  bool hardware_nearest;
+};
+
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 rounding_context
+make_rounding_context(rounding_mode const rounding) noexcept {
+  rounding_context context{rounding, false};
+  if (rounding == rounding_mode::follow_fpu) {
+    context.mode = rounding_mode::nearest_even;
+  }
+  // Compile-time evaluation rounds to nearest, but we cannot tell whether the
+  // hardware will.
+  if (is_constant_evaluated()) {
+    return context;
+  }
+#ifdef FASTFLOAT_ONLY_ROUNDS_TO_NEAREST_SUPPORTED
+  context.hardware_nearest = (context.mode == rounding_mode::nearest_even);
+#else
+  if (rounding == rounding_mode::follow_fpu) {
+    context.mode = fpu_rounding_mode();
+    context.hardware_nearest = (context.mode == rounding_mode::nearest_even);
+  } else if (rounding == rounding_mode::nearest_even) {
+    context.hardware_nearest = rounds_to_nearest();
+  }
+#endif
+  return context;
+}
+
+// Whether a value that is not representable is rounded away from zero, i.e.,
+// to the larger magnitude. Only meaningful for the directed modes.
+fastfloat_really_inline constexpr bool
+rounds_away_from_zero(rounding_mode const rounding,
+                      bool const negative) noexcept {
+  return negative ? (rounding == rounding_mode::downward)
+                  : (rounding == rounding_mode::upward);
+}
+
+// The next float away from zero: the mantissa carries into the exponent, and
+// the largest finite value is followed by infinity.
+template <typename T>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR14 adjusted_mantissa
+next_away_from_zero(adjusted_mantissa am) noexcept {
+  if (am.mantissa == binary_format<T>::mantissa_mask()) {
+    am.mantissa = 0;
+    ++am.power2;
+  } else {
+    ++am.mantissa;
+  }
+  return am;
+}
+
+// w * 10 ** q rounded in a direction, `away` tells whether the magnitude goes
+// up. As with compute_float, a negative power of 2 asks for the digits.
+template <typename T>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 adjusted_mantissa
+compute_float_directed(am_pow_t const q, am_mant_t const w,
+                       bool const away) noexcept {
+  bool exact;
+  adjusted_mantissa am =
+      compute_float_toward_zero<binary_format<T>>(q, w, exact);
+  if (am.power2 >= 0 && !exact && away) {
+    am = next_away_from_zero<T>(am);
+  }
+  return am;
+}
+
+#ifdef FASTFLOAT_HAS_FAST_FMA
+// mantissa * 10^exponent for -44 <= exponent <= -23, rounded to nearest.
+// With 10^exponent split in two doubles, fused multiply-adds give the product
+// as a rounded double plus a residual, to far better than an ULP. Their sum
+// is the answer unless what is left is too close to half an ULP to tell, or
+// the sum is a power of 2 and the spacing below it is halved: we give up.
+fastfloat_really_inline bool
+negative_power_fast_path(am_mant_t const mantissa, am_pow_t const exponent,
+                         double &value) noexcept {
+  if (exponent < -44 || exponent > -23) {
+    return false;
+  }
+  auto const index = static_cast<size_t>(-23 - exponent);
+  double const high = split_negative_powers_of_ten<>::high[index];
+  double const m = static_cast<double>(mantissa); // exact, at most 2^53
+  double const product = m * high;
+  double const residual = std::fma(
+      m, split_negative_powers_of_ten<>::low[index], std::fma(m, high, -product));
+  double const sum = product + residual;
+  // exactly product + residual - sum, since |residual| <= |product|
+  double const rest = (product - sum) + residual;
+  uint64_t const bits = bit_cast<uint64_t>(sum);
+  // half an ULP of the normal sum, less a margin for the approximations
+  double const half_ulp = bit_cast<double>(
+      (bits & binary_format<double>::exponent_mask()) -
+      (uint64_t(binary_format<double>::mantissa_explicit_bits() + 1)
+       << binary_format<double>::mantissa_explicit_bits()));
+  if ((bits & binary_format<double>::mantissa_mask()) == 0 ||
+      std::fabs(rest) >= half_ulp - half_ulp / 1024) {
+    return false;
+  }
+  value = sum;
+  return true;
+}
+
+template <typename T>
+fastfloat_really_inline bool negative_power_fast_path(am_mant_t, am_pow_t,
+                                                      T &) noexcept {
+  return false;
+}
+#endif
+
+// mantissa * 10^exponent rounded to nearest, for a nonzero mantissa that
+// converts exactly and an exponent out of the range of the exact powers of
+// ten. A larger exponent is moved into the mantissa while the product stays
+// exact, as in 123e25 = 1230000e21; a smaller one is checked with fused
+// multiply-adds where the hardware has them. Kept out of line: most numbers
+// that reach it end up in compute_float anyway.
+template <typename T>
+FASTFLOAT_CONSTEXPR20 bool extended_fast_path(am_mant_t const mantissa,
+                                              am_pow_t const exponent,
+                                              T &value) noexcept {
+  if (exponent > binary_format<T>::max_exponent_fast_path()) {
+    auto const shift = static_cast<am_pow_t>(
+        exponent - binary_format<T>::max_exponent_fast_path());
+    // floor(floor(2^53 / 5^shift) / 2^shift) == floor(2^53 / 10^shift),
+    // which is 0 past 10^15
+    if (shift <= binary_format<T>::max_exponent_fast_path() &&
+        mantissa <=
+            (binary_format<T>::max_mantissa_fast_path(shift) >> shift)) {
+      value = static_cast<T>(mantissa * powers_of_ten_uint64[shift]) *
+              binary_format<T>::exact_power_of_ten(
+                  binary_format<T>::max_exponent_fast_path());
+      return true;
+    }
+    return false;
+  }
+#ifdef FASTFLOAT_HAS_FAST_FMA
+  return negative_power_fast_path(mantissa, exponent, value);
+#else
+  return false;
 #endif
+}
 
 } // namespace detail
 
@@ -191,38 +390,30 @@ from_chars(UC const *first, UC const *last, T &value,
 }
 
 template <typename T>
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 bool
-clinger_fast_path_impl(am_mant_t const mantissa, am_pow_t const exponent,
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20
+    typename std::enable_if<!is_half_bits_type<T>::value, bool>::type
+    clinger_fast_path_impl(am_mant_t const mantissa, am_pow_t const exponent,
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
-                       bool const is_negative,
+                           bool const is_negative,
 #endif
-                       T &value) noexcept {
+                           T &value,
+                           detail::rounding_context const rounding) noexcept {
   // The implementation of the Clinger's fast path is convoluted because
-  // we want round-to-nearest in all cases, irrespective of the rounding mode
-  // selected on the thread.
-  // We proceed optimistically, assuming that detail::rounds_to_nearest()
-  // returns true.
+  // we want the requested rounding in all cases, irrespective of the rounding
+  // mode selected on the thread. The environment was probed once, before
+  // parsing, and its outcome is in rounding.hardware_nearest.
   if (binary_format<T>::min_exponent_fast_path() <= exponent &&
       exponent <= binary_format<T>::max_exponent_fast_path() &&
       mantissa <= binary_format<T>::max_mantissa_fast_path()) {
     // The mantissa bound above is a necessary condition for BOTH branches
     // below: the rounding-mode-dependent branch checks the tighter
-    // max_mantissa_fast_path(exponent) <= max_mantissa_fast_path(). Testing
-    // it before detail::rounds_to_nearest() spares long-mantissa inputs
-    // (which can never take the fast path) the volatile-float probe.
+    // max_mantissa_fast_path(exponent) <= max_mantissa_fast_path().
     //
     // Unfortunately, the conventional Clinger's fast path is only possible
-    // when the system rounds to the nearest float.
+    // when we round to nearest and so does the system.
     //
     // We expect the next branch to almost always be selected.
-    // We could check it first (before the previous branch), but
-    // there might be performance advantages at having the check
-    // be last.
-    if (!is_constant_evaluated()
-#ifndef FASTFLOAT_ONLY_ROUNDS_TO_NEAREST_SUPPORTED
-        && detail::rounds_to_nearest()
-#endif
-    ) {
+    if (rounding.hardware_nearest) {
       // We have that fegetround() == FE_TONEAREST.
       // Next is Clinger's fast path.
       if (mantissa <= binary_format<T>::max_mantissa_fast_path()) {
@@ -240,9 +431,9 @@ clinger_fast_path_impl(am_mant_t const mantissa, am_pow_t const exponent,
         return true;
       }
     } else {
-      // We do not have that fegetround() == FE_TONEAREST.
-      // Next is a modified Clinger's fast path, inspired by Jakub Jelínek's
-      // proposal
+      // We do not have that fegetround() == FE_TONEAREST, or we round in a
+      // direction. Next is a modified Clinger's fast path, inspired by Jakub
+      // Jelínek's proposal: the product is exact, so every mode agrees.
       if (exponent >= 0 &&
           mantissa <= binary_format<T>::max_mantissa_fast_path(exponent)) {
 #if defined(__clang__) || defined(FASTFLOAT_32BIT)
@@ -267,22 +458,136 @@ clinger_fast_path_impl(am_mant_t const mantissa, am_pow_t const exponent,
       }
     }
   }
+  // Beyond the exact powers of ten, the product can still be rounded once
+  // when rounding to nearest.
+  if (rounding.hardware_nearest && mantissa != 0 &&
+      mantissa <= binary_format<T>::max_mantissa_fast_path() &&
+      detail::extended_fast_path(mantissa, exponent, value)) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (is_negative) {
+      value = -value;
+    }
+#endif
+    return true;
+  }
   return false;
 }
 
-/**
- * This function overload takes parsed_number_string_t structure that is created
- * and populated either by from_chars_advanced function taking chars range and
- * parsing options or other parsing custom function implemented by user.
- */
+// The half-precision bit patterns have no arithmetic to run Clinger's fast
+// path with, but their significands are so short that any integer
+// mantissa * 10^exponent that fits in 64 bits is rounded directly, whatever
+// the rounding mode. Overflows are left to compute_float, which reports them,
+// and so are negative exponents: compute_float is faster than a division for
+// these formats.
+template <typename T>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20
+    typename std::enable_if<is_half_bits_type<T>::value, bool>::type
+    clinger_fast_path_impl(am_mant_t const mantissa, am_pow_t const exponent,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                           bool const is_negative,
+#endif
+                           T &value,
+                           detail::rounding_context const rounding) noexcept {
+  if (exponent < binary_format<T>::min_exponent_fast_path() ||
+      exponent > binary_format<T>::max_exponent_fast_path()) {
+    return false;
+  }
+  value128 product(mantissa, 0);
+  if (exponent != 0) {
+    product = full_multiplication(mantissa, powers_of_ten_uint64[exponent]);
+    if (product.high != 0) {
+      return false;
+    }
+  }
+  adjusted_mantissa am;
+  if (product.low != 0) {
+    constexpr am_bits_t significand_bits =
+        binary_format<T>::mantissa_explicit_bits() + 1;
+    auto const msb = static_cast<am_bits_t>(63 - leading_zeroes(product.low));
+    am.power2 = am_pow_t(msb - binary_format<T>::minimum_exponent());
+    if (msb < significand_bits) {
+      am.mantissa = product.low << (significand_bits - 1 - msb);
+    } else {
+      auto const shift = static_cast<am_bits_t>(msb - (significand_bits - 1));
+      am.mantissa = product.low >> shift;
+      am_mant_t const rest = product.low & ((am_mant_t(1) << shift) - 1);
+      am_mant_t const halfway = am_mant_t(1) << (shift - 1);
+      bool const round_up =
+          (rounding.mode == rounding_mode::nearest_even)
+              // round to nearest, ties to even
+              ? (rest > halfway || (rest == halfway && (am.mantissa & 1)))
+              : (rest != 0 && detail::rounds_away_from_zero(rounding.mode,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                                            is_negative
+#else
+                                                            false
+#endif
+                                                            ));
+      if (round_up) {
+        ++am.mantissa;
+        if (am.mantissa >> significand_bits) {
+          am.mantissa >>= 1;
+          ++am.power2;
+        }
+      }
+    }
+    if (am.power2 >= binary_format<T>::infinite_power()) {
+      return false;
+    }
+    am.mantissa &= binary_format<T>::mantissa_mask();
+  }
+  to_float(
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      is_negative,
+#endif
+      am, value);
+  return true;
+}
+
+namespace detail {
+// The magnitude of the parsed number rounded toward zero, `exact` is set when
+// it is the number itself. The spans must be stored: the digits are compared
+// when the truncation is ambiguous.
 template <typename T, typename UC>
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
-from_chars_advanced(parsed_number_string_t<UC> const &pns, T &value) noexcept {
-  static_assert(is_supported_float_type<T>::value,
-                "this type of floating-point type isn't supported");
-  static_assert(is_supported_char_type<UC>::value,
-                "only char, wchar_t, char16_t and char32_t are supported");
+FASTFLOAT_CONSTEXPR20 adjusted_mantissa
+compute_toward_zero(parsed_number_string_t<UC> const &pns,
+                    bool &exact) noexcept {
+  // With more than 19 digits, the number is between mantissa * 10^exponent
+  // and (mantissa + 1) * 10^exponent: it is truncated like them if they
+  // truncate to the same value.
+  adjusted_mantissa am = compute_float_toward_zero<binary_format<T>>(
+      pns.exponent, pns.mantissa, exact);
+  if (pns.too_many_digits && am.power2 >= 0) {
+    bool upper_exact;
+    if (exact || am != compute_float_toward_zero<binary_format<T>>(
+                           pns.exponent, pns.mantissa + 1, upper_exact)) {
+      am.power2 = -1;
+    }
+    exact = false;
+  }
+  // Otherwise, we round to nearest like from_chars_advanced and compare the
+  // digits to the result. This is very uncommon.
+  if fastfloat_unlikely (am.power2 < 0) {
+    adjusted_mantissa nearest =
+        compute_float<binary_format<T>>(pns.exponent, pns.mantissa);
+    if (pns.too_many_digits && nearest.power2 >= 0) {
+      if (nearest !=
+          compute_float<binary_format<T>>(pns.exponent, pns.mantissa + 1)) {
+        nearest = compute_error<binary_format<T>>(pns.exponent, pns.mantissa);
+      }
+    }
+    if (nearest.power2 < 0) {
+      nearest = digit_comp<T>(pns, nearest);
+    }
+    am = digit_comp_toward_zero<T>(pns, nearest, exact);
+  }
+  return am;
+}
 
+template <typename T, typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_parsed(parsed_number_string_t<UC> const &pns, T &value,
+                  rounding_context const rounding) noexcept {
   from_chars_result_t<UC> answer;
 
   answer.ec = std::errc(); // be optimistic
@@ -292,21 +597,36 @@ from_chars_advanced(parsed_number_string_t<UC> const &pns, T &value) noexcept {
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                                                      pns.negative,
 #endif
-                                                     value))
+                                                     value, rounding))
     return answer;
 
-  adjusted_mantissa am =
-      compute_float<binary_format<T>>(pns.exponent, pns.mantissa);
-  if (pns.too_many_digits && am.power2 >= 0) {
-    if (am != compute_float<binary_format<T>>(pns.exponent, pns.mantissa + 1)) {
-      am = compute_error<binary_format<T>>(pns.exponent, pns.mantissa);
+  adjusted_mantissa am;
+  if (rounding.mode == rounding_mode::nearest_even) {
+    am = compute_float<binary_format<T>>(pns.exponent, pns.mantissa);
+    if (pns.too_many_digits && am.power2 >= 0) {
+      if (am !=
+          compute_float<binary_format<T>>(pns.exponent, pns.mantissa + 1)) {
+        am = compute_error<binary_format<T>>(pns.exponent, pns.mantissa);
+      }
+    }
+    // If we called compute_float<binary_format<T>>(pns.exponent,
+    // pns.mantissa) and we have an invalid power (am.power2 < 0), then we need
+    // to go the long way around again. This is very uncommon.
+    if fastfloat_unlikely (am.power2 < 0) {
+      am = digit_comp<T>(pns, am);
+    }
+  } else {
+    bool exact;
+    am = compute_toward_zero<T>(pns, exact);
+    if (!exact && rounds_away_from_zero(rounding.mode,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                        pns.negative
+#else
+                                        false
+#endif
+                                        )) {
+      am = next_away_from_zero<T>(am);
     }
-  }
-  // If we called compute_float<binary_format<T>>(pns.exponent, pns.mantissa)
-  // and we have an invalid power (am.power2 < 0), then we need to go the long
-  // way around again. This is very uncommon.
-  if fastfloat_unlikely (am.power2 < 0) {
-    am = digit_comp<T>(pns, am);
   }
   to_float(
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
@@ -320,35 +640,61 @@ from_chars_advanced(parsed_number_string_t<UC> const &pns, T &value) noexcept {
   }
   return answer;
 }
+} // namespace detail
+
+/**
+ * This function overload takes parsed_number_string_t structure that is created
+ * and populated either by from_chars_advanced function taking chars range and
+ * parsing options or other parsing custom function implemented by user.
+ * For directed rounding, the integer and fraction spans must be set.
+ */
+template <typename T, typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_advanced(
+    parsed_number_string_t<UC> const &pns, T &value,
+    rounding_mode const rounding = rounding_mode::nearest_even) noexcept {
+  static_assert(is_supported_float_type<T>::value,
+                "this type of floating-point type isn't supported");
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  return detail::from_chars_parsed(pns, value,
+                                   detail::make_rounding_context(rounding));
+}
 
-// Slow path: re-parse materializing the integer/fraction spans the hot no-span
-// parse skipped, then run the full algorithm. The two callers reach it only
-// through a fastfloat_unlikely branch, so the optimizer keeps this re-parse off
-// the hot path on its own (no function-level noinline needed).
+// Slow path: run the full algorithm on the integer/fraction spans. The hot
+// parse stored them for more than 19 digits; otherwise it skipped them, and we
+// re-parse to materialize them. The two callers reach it only through a
+// fastfloat_unlikely branch, so the optimizer keeps this re-parse off the hot
+// path on its own (no function-level noinline needed).
 // from_chars_advanced already handles both the too_many_digits disambiguation
 // and the am.power2<0 digit_comp recompute, so both slow branches collapse to
 // one helper call.
 template <typename T, typename UC>
 FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
-parse_number_slow_path(UC const *first, UC const *last, T &value,
-                       parse_options_t<UC> const options
+parse_number_slow_path(parsed_number_string_t<UC> const hot, UC const *first,
+                       UC const *last, T &value,
+                       parse_options_t<UC> const options,
+                       detail::rounding_context const rounding
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                        ,
                        bool const bjf
 #endif
                        ) noexcept {
   parsed_number_string_t<UC> const pns =
+      hot.too_many_digits ? hot :
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
       bjf ? parse_number_string<true, UC>(first, last, options, true) :
 #endif
           parse_number_string<false, UC>(first, last, options, true);
-  return from_chars_advanced(pns, value);
+  return detail::from_chars_parsed(pns, value, rounding);
 }
 
 template <typename T, typename UC>
 fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
 from_chars_float_advanced(UC const *first, UC const *last, T &value,
-                          parse_options_t<UC> const options) noexcept {
+                          parse_options_t<UC> const options,
+                          detail::rounding_context const rounding) noexcept {
   static_assert(is_supported_float_type<T>::value,
                 "this type of floating-point type isn't supported");
   static_assert(is_supported_char_type<UC>::value,
@@ -357,9 +703,7 @@ from_chars_float_advanced(UC const *first, UC const *last, T &value,
   from_chars_result_t<UC> answer;
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
   if (chars_format_t(options.format & chars_format::skip_white_space)) {
-    while ((first != last) && fast_float::is_space(*first)) {
-      ++first;
-    }
+    first = skip_spaces(first, last);
   }
 #else
 #ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
@@ -400,9 +744,9 @@ from_chars_float_advanced(UC const *first, UC const *last, T &value,
 #endif
   }
 
-  // Slow path A (rare): > 19 significant digits. The no-span parse left the
-  // mantissa un-truncated and skipped the span-based recompute; the cold helper
-  // re-parses with spans and runs the full algorithm.
+  // Slow path A (rare): > 19 significant digits. The parse already truncated
+  // the mantissa and stored the spans, so the full algorithm runs on it
+  // without reading the digits again.
   //
 // We have to disable -Wc++20-extensions for the [[unlikely]] attribute
 // See comment for @jwakely at
@@ -415,7 +759,8 @@ from_chars_float_advanced(UC const *first, UC const *last, T &value,
 #endif
 #endif
   if fastfloat_unlikely (pns.too_many_digits) {
-    return parse_number_slow_path<T, UC>(first, last, value, options
+    return parse_number_slow_path<T, UC>(pns, first, last, value, options,
+                                         rounding
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                                          ,
                                          bjf
@@ -429,18 +774,29 @@ from_chars_float_advanced(UC const *first, UC const *last, T &value,
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                              pns.negative,
 #endif
-                             value)) {
+                             value, rounding)) {
     return answer;
   }
 
   adjusted_mantissa am =
-      compute_float<binary_format<T>>(pns.exponent, pns.mantissa);
+      (rounding.mode == rounding_mode::nearest_even)
+          ? compute_float<binary_format<T>>(pns.exponent, pns.mantissa)
+          : detail::compute_float_directed<T>(
+                pns.exponent, pns.mantissa,
+                detail::rounds_away_from_zero(rounding.mode,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                              pns.negative
+#else
+                                              false
+#endif
+                                              ));
   // Slow path B (rare): Eisel-Lemire could not resolve; digit_comp needs the
   // integer/fraction spans. Route to the cold helper (clinger there is a
   // dead-effect since it already failed here; the cold re-parse + digit_comp
   // via from_chars_advanced reproduces this branch).
   if fastfloat_unlikely (am.power2 < 0) {
-    return parse_number_slow_path<T, UC>(first, last, value, options
+    return parse_number_slow_path<T, UC>(pns, first, last, value, options,
+                                         rounding
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                                          ,
                                          bjf
@@ -463,6 +819,15 @@ from_chars_float_advanced(UC const *first, UC const *last, T &value,
   return answer;
 }
 
+template <typename T, typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_float_advanced(UC const *first, UC const *last, T &value,
+                          parse_options_t<UC> const options) noexcept {
+  return from_chars_float_advanced(
+      first, last, value, options,
+      detail::make_rounding_context(options.rounding));
+}
+
 template <typename T, typename UC, typename>
 FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
 from_chars(UC const *first, UC const *last, T &value, int const base) noexcept {
@@ -487,7 +852,9 @@ FASTFLOAT_CONSTEXPR20
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                              false,
 #endif
-                             value))
+                             value,
+                             detail::make_rounding_context(
+                                 rounding_mode::nearest_even)))
     return value;
 
   adjusted_mantissa am = compute_float<binary_format<T>>(exponent, mantissa);
@@ -517,7 +884,9 @@ FASTFLOAT_CONSTEXPR20
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
                              is_negative,
 #endif
-                             value))
+                             value,
+                             detail::make_rounding_context(
+                                 rounding_mode::nearest_even)))
     return value;
 
   adjusted_mantissa const am = compute_float<binary_format<T>>(exponent, m);
@@ -582,6 +951,40 @@ integer_times_pow10(Int const mantissa, int const decimal_exponent) noexcept {
   return integer_times_pow10(static_cast<int64_t>(mantissa), decimal_exponent);
 }
 
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+// Integer parsing with chars_format::allow_integral_float: the number is
+// tokenized by parse_number_string, so a fraction and an exponent are
+// accepted, and the mantissa/exponent pair is checked to be integral and in
+// range with exact integer arithmetic. The floating-point engine is never used.
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_integral_float(UC const *first, UC const *last, T &value,
+                          parse_options_t<UC> const options) noexcept {
+  from_chars_result_t<UC> answer;
+  bool const bjf = chars_format_t(options.format & detail::basic_json_fmt) != 0;
+  parsed_number_string_t<UC> const pns =
+      bjf ? parse_number_string<true, UC>(first, last, options, false)
+          : parse_number_string<false, UC>(first, last, options, false);
+  if (pns.invalid || (!is_signed_integer<T>::value && pns.negative)) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+  value128 v;
+  answer.ec = integral_magnitude(pns, v);
+  if (answer.ec == std::errc::invalid_argument) {
+    answer.ptr = first;
+    return answer;
+  }
+  answer.ptr = pns.lastmatch;
+  if (answer.ec == std::errc() &&
+      !integer_from_magnitude(v, pns.negative, value)) {
+    answer.ec = std::errc::result_out_of_range;
+  }
+  return answer;
+}
+#endif
+
 template <typename T, typename UC>
 FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
 from_chars_int_advanced(UC const *first, UC const *last, T &value,
@@ -597,9 +1000,7 @@ from_chars_int_advanced(UC const *first, UC const *last, T &value,
 #endif
 #ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
   if (chars_format_t(options.format & chars_format::skip_white_space)) {
-    while ((first != last) && fast_float::is_space(*first)) {
-      ++first;
-    }
+    first = skip_spaces(first, last);
   }
 #else
 #endif
@@ -614,39 +1015,804 @@ from_chars_int_advanced(UC const *first, UC const *last, T &value,
     return answer;
   }
 
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::allow_integral_float) &&
+      options.base == 10) {
+    return from_chars_integral_float(first, last, value, options);
+  }
+#endif
   return parse_int_string(first, last, value, options);
 }
 
-template <size_t TypeIx> struct from_chars_advanced_caller {
-  static_assert(TypeIx > 0, "unsupported type");
-};
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_decimal_advanced(UC const *first, UC const *last, T &value,
+                            parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_decimal_type<T>::value,
+                "only decimal64 and decimal128 are supported");
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
 
-template <> struct from_chars_advanced_caller<1> {
-  template <typename T, typename UC>
-  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 static from_chars_result_t<UC>
-  call(UC const *first, UC const *last, T &value,
-       parse_options_t<UC> const options) noexcept {
-    return from_chars_float_advanced(first, last, value, options);
+  from_chars_result_t<UC> answer;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
   }
-};
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  bool const bjf = chars_format_t(options.format & detail::basic_json_fmt) != 0;
+#endif
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      bjf ? parse_number_string<true, UC>(first, last, options, false) :
+#endif
+          parse_number_string<false, UC>(first, last, options, false);
+  if (pns.invalid) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (!chars_format_t(options.format & chars_format::no_infnan)) {
+      double special;
+      answer = detail::parse_infnan(first, last, special, options.format);
+      if (answer.ec == std::errc()) {
+        bool const negative = *first == UC('-');
+        UC const c = first[negative || *first == UC('+')];
+        decimal_bid_format<T>::special(negative, c == UC('n') || c == UC('N'),
+                                       value);
+      }
+      return answer;
+    }
+#endif
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+  answer.ec = to_decimal_bid(pns, value);
+  answer.ptr = pns.lastmatch;
+  return answer;
+}
 
-template <> struct from_chars_advanced_caller<2> {
-  template <typename T, typename UC>
-  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 static from_chars_result_t<UC>
-  call(UC const *first, UC const *last, T &value,
-       parse_options_t<UC> const options) noexcept {
-    return from_chars_int_advanced(first, last, value, options);
+// Clinger's fast path for the formats wider than double: the mantissa and
+// the power of ten are both exact, so that a single correctly rounded
+// operation gives the result.
+template <typename T>
+fastfloat_really_inline bool
+extended_fast_path(am_mant_t const mantissa, am_pow_t const exponent,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                   bool const is_negative,
+#endif
+                   T &value) noexcept {
+  using format = extended_binary_format<T>;
+  if (exponent < -format::max_exponent_fast_path() ||
+      exponent > format::max_exponent_fast_path()) {
+    return false;
   }
-};
+#ifndef FASTFLOAT_ONLY_ROUNDS_TO_NEAREST_SUPPORTED
+  if (!detail::rounds_to_nearest()) {
+    return false;
+  }
+#endif
+  if (!format::full_precision()) {
+    return false;
+  }
+  value = static_cast<T>(mantissa);
+  if (exponent < 0) {
+    value = value / extended_power_of_ten<T>(am_pow_t(-exponent));
+  } else {
+    value = value * extended_power_of_ten<T>(exponent);
+  }
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (is_negative) {
+    value = -value;
+  }
+#endif
+  return true;
+}
 
 template <typename T, typename UC>
-fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
-from_chars_advanced(UC const *first, UC const *last, T &value,
-                    parse_options_t<UC> const options) noexcept {
-  return from_chars_advanced_caller<
-      size_t(is_supported_float_type<T>::value) +
-      2 * size_t(is_supported_integer_type<T>::value)>::call(first, last, value,
-                                                             options);
+from_chars_result_t<UC>
+from_chars_extended_advanced(UC const *first, UC const *last, T &value,
+                             parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_extended_float_type<T>::value,
+                "only long double, __float128 and std::float128_t are "
+                "supported");
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  from_chars_result_t<UC> answer;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
+  }
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  bool const bjf = chars_format_t(options.format & detail::basic_json_fmt) != 0;
+#endif
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      bjf ? parse_number_string<true, UC>(first, last, options, false) :
+#endif
+          parse_number_string<false, UC>(first, last, options, false);
+  if (pns.invalid) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (!chars_format_t(options.format & chars_format::no_infnan)) {
+      double special;
+      answer = detail::parse_infnan(first, last, special, options.format);
+      if (answer.ec == std::errc()) {
+        value = static_cast<T>(special);
+      }
+      return answer;
+    }
+#endif
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+  answer.ec = std::errc();
+  answer.ptr = pns.lastmatch;
+  if (!pns.too_many_digits && extended_fast_path(pns.mantissa, pns.exponent,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                                 pns.negative,
+#endif
+                                                 value)) {
+    return answer;
+  }
+  answer.ec = to_extended_float(pns, value);
+  return answer;
+}
+
+#if LDBL_MANT_DIG == 53
+// long double has the same format as double.
+template <typename UC>
+from_chars_result_t<UC>
+from_chars_extended_advanced(UC const *first, UC const *last, long double &value,
+                             parse_options_t<UC> const options) noexcept {
+  double d = 0;
+  from_chars_result_t<UC> const answer =
+      from_chars_float_advanced(first, last, d, options);
+  if (answer.ptr != first || answer.ec == std::errc()) {
+    value = d;
+  }
+  return answer;
+}
+#endif
+
+template <size_t TypeIx> struct from_chars_advanced_caller {
+  static_assert(TypeIx > 0, "unsupported type");
+};
+
+template <> struct from_chars_advanced_caller<1> {
+  template <typename T, typename UC>
+  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 static from_chars_result_t<UC>
+  call(UC const *first, UC const *last, T &value,
+       parse_options_t<UC> const options) noexcept {
+    return from_chars_float_advanced(first, last, value, options);
+  }
+};
+
+template <> struct from_chars_advanced_caller<2> {
+  template <typename T, typename UC>
+  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 static from_chars_result_t<UC>
+  call(UC const *first, UC const *last, T &value,
+       parse_options_t<UC> const options) noexcept {
+    return from_chars_int_advanced(first, last, value, options);
+  }
+};
+
+template <> struct from_chars_advanced_caller<3> {
+  template <typename T, typename UC>
+  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 static from_chars_result_t<UC>
+  call(UC const *first, UC const *last, T &value,
+       parse_options_t<UC> const options) noexcept {
+    return from_chars_decimal_advanced(first, last, value, options);
+  }
+};
+
+template <> struct from_chars_advanced_caller<4> {
+  template <typename T, typename UC>
+  fastfloat_really_inline FASTFLOAT_CONSTEXPR20 static from_chars_result_t<UC>
+  call(UC const *first, UC const *last, T &value,
+       parse_options_t<UC> const options) noexcept {
+    return from_chars_extended_advanced(first, last, value, options);
+  }
+};
+
+template <typename T, typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_advanced(UC const *first, UC const *last, T &value,
+                    parse_options_t<UC> const options) noexcept {
+  return from_chars_advanced_caller<
+      size_t(is_supported_float_type<T>::value) +
+      2 * size_t(is_supported_integer_type<T>::value) +
+      3 * size_t(is_supported_decimal_type<T>::value) +
+      4 * size_t(is_supported_extended_float_type<T>::value)>::call(first, last,
+                                                                     value,
+                                                                     options);
+}
+
+namespace detail {
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_array_result_t<UC>
+from_chars_half_array(UC const *first, UC const *last, uint16_t *values,
+                      size_t const count, UC const separator,
+                      parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  from_chars_array_result_t<UC> answer;
+  answer.ec = std::errc();
+  // the rounding is decided once for the whole row
+  rounding_context const rounding = make_rounding_context(options.rounding);
+  size_t stored = 0;
+  while (stored < count) {
+    T value{};
+    from_chars_result_t<UC> const r =
+        from_chars_float_advanced(first, last, value, options, rounding);
+    if fastfloat_unlikely (r.ec != std::errc()) {
+      answer.ec = r.ec;
+      if (r.ec == std::errc::invalid_argument) {
+        break;
+      }
+      // out of range: the infinity or the zero is stored anyway
+    }
+    values[stored++] = value.bits;
+    first = r.ptr;
+    if (stored == count || first == last || *first != separator) {
+      break;
+    }
+    ++first;
+  }
+  answer.ptr = first;
+  answer.count = stored;
+  return answer;
+}
+} // namespace detail
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_array_result_t<UC>
+from_chars_float16(UC const *first, UC const *last, uint16_t *values,
+                   size_t const count, UC const separator,
+                   chars_format const fmt) noexcept {
+  return detail::from_chars_half_array<float16_bits>(
+      first, last, values, count, separator, parse_options_t<UC>(fmt));
+}
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_array_result_t<UC>
+from_chars_bfloat16(UC const *first, UC const *last, uint16_t *values,
+                    size_t const count, UC const separator,
+                    chars_format const fmt) noexcept {
+  return detail::from_chars_half_array<bfloat16_bits>(
+      first, last, values, count, separator, parse_options_t<UC>(fmt));
+}
+
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_interval_result_t<UC>
+from_chars_interval_advanced(UC const *first, UC const *last, T &lo, T &hi,
+                             parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_float_type<T>::value,
+                "this type of floating-point type isn't supported");
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  from_chars_interval_result_t<UC> answer;
+  answer.exact = true;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
+  }
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+  // The spans are stored: the digits are compared when the truncation is
+  // ambiguous.
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      chars_format_t(options.format & detail::basic_json_fmt)
+          ? parse_number_string<true, UC>(first, last, options, true)
+          :
+#endif
+          parse_number_string<false, UC>(first, last, options, true);
+  if (pns.invalid) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (!chars_format_t(options.format & chars_format::no_infnan)) {
+      from_chars_result_t<UC> const r =
+          detail::parse_infnan(first, last, lo, options.format);
+      if (r.ec == std::errc()) {
+        hi = lo;
+      }
+      answer.ptr = r.ptr;
+      answer.ec = r.ec;
+      return answer;
+    }
+#endif
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+  answer.ec = std::errc();
+  answer.ptr = pns.lastmatch;
+
+  // The magnitude rounded toward zero.
+  bool exact;
+  adjusted_mantissa const am = detail::compute_toward_zero<T>(pns, exact);
+  answer.exact = exact;
+  adjusted_mantissa const away =
+      exact ? am : detail::next_away_from_zero<T>(am);
+  if ((away.power2 == binary_format<T>::infinite_power()) ||
+      (!exact && am.power2 == 0 && am.mantissa == 0)) {
+    answer.ec = std::errc::result_out_of_range;
+  }
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (pns.negative) {
+    to_float(true, away, lo);
+    to_float(true, am, hi);
+  } else {
+    to_float(false, am, lo);
+    to_float(false, away, hi);
+  }
+#else
+  to_float(am, lo);
+  to_float(away, hi);
+#endif
+  return answer;
+}
+
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_interval_result_t<UC>
+from_chars_interval(UC const *first, UC const *last, T &lo, T &hi,
+                    chars_format const fmt /*= chars_format::general*/) noexcept {
+  return from_chars_interval_advanced(first, last, lo, hi,
+                                      parse_options_t<UC>(fmt));
+}
+
+namespace detail {
+// Packs a rounded value and reports an overflow or an underflow, like
+// from_chars_advanced.
+template <typename T, typename UC>
+fastfloat_really_inline FASTFLOAT_CONSTEXPR20 std::errc
+store_rounded(parsed_number_string_t<UC> const &pns, adjusted_mantissa const am,
+              T &value) noexcept {
+  to_float(
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      pns.negative,
+#endif
+      am, value);
+  if ((pns.mantissa != 0 && am.mantissa == 0 && am.power2 == 0) ||
+      am.power2 == binary_format<T>::infinite_power()) {
+    return std::errc::result_out_of_range;
+  }
+  return std::errc();
+}
+
+// Slow path of from_chars_dual_advanced: re-parse with the spans and convert
+// to each type on its own, so that the digits are compared only for the
+// precision that needs it.
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_dual_result_t<UC>
+dual_slow_path(UC const *first, UC const *last, double &d, float &f,
+               parse_options_t<UC> const options,
+               rounding_context const rounding) noexcept {
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      chars_format_t(options.format & basic_json_fmt)
+          ? parse_number_string<true, UC>(first, last, options, true)
+          :
+#endif
+          parse_number_string<false, UC>(first, last, options, true);
+  from_chars_dual_result_t<UC> answer;
+  answer.ptr = pns.lastmatch;
+  answer.ec = from_chars_parsed(pns, d, rounding).ec;
+  answer.float_ec = from_chars_parsed(pns, f, rounding).ec;
+  return answer;
+}
+} // namespace detail
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_dual_result_t<UC>
+from_chars_dual_advanced(UC const *first, UC const *last, double &d, float &f,
+                         parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  from_chars_dual_result_t<UC> answer;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
+  }
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = answer.float_ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      chars_format_t(options.format & detail::basic_json_fmt)
+          ? parse_number_string<true, UC>(first, last, options, false)
+          :
+#endif
+          parse_number_string<false, UC>(first, last, options, false);
+  if (pns.invalid) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (!chars_format_t(options.format & chars_format::no_infnan)) {
+      from_chars_result_t<UC> const r =
+          detail::parse_infnan(first, last, d, options.format);
+      if (r.ec == std::errc()) {
+        f = static_cast<float>(d);
+      }
+      answer.ptr = r.ptr;
+      answer.ec = answer.float_ec = r.ec;
+      return answer;
+    }
+#endif
+    answer.ec = answer.float_ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+
+  detail::rounding_context const rounding =
+      detail::make_rounding_context(options.rounding);
+  if fastfloat_unlikely (pns.too_many_digits ||
+                         rounding.mode != rounding_mode::nearest_even) {
+    return detail::dual_slow_path(first, last, d, f, options, rounding);
+  }
+  answer.ptr = pns.lastmatch;
+  answer.ec = answer.float_ec = std::errc();
+
+  // Clinger's fast path applies to the float only if it applies to the double.
+  if (clinger_fast_path_impl(pns.mantissa, pns.exponent,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                             pns.negative,
+#endif
+                             d, rounding)) {
+    if (clinger_fast_path_impl(pns.mantissa, pns.exponent,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                               pns.negative,
+#endif
+                               f, rounding)) {
+      return answer;
+    }
+    adjusted_mantissa const fam =
+        compute_float<binary_format<float>>(pns.exponent, pns.mantissa);
+    answer.float_ec = detail::store_rounded(pns, fam, f);
+    return answer;
+  }
+
+  adjusted_mantissa dam;
+  adjusted_mantissa fam;
+  compute_float_pair<binary_format<double>, binary_format<float>>(
+      pns.exponent, pns.mantissa, dam, fam);
+  if fastfloat_unlikely (dam.power2 < 0 || fam.power2 < 0) {
+    return detail::dual_slow_path(first, last, d, f, options, rounding);
+  }
+  answer.ec = detail::store_rounded(pns, dam, d);
+  answer.float_ec = detail::store_rounded(pns, fam, f);
+  return answer;
+}
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_dual_result_t<UC>
+from_chars_dual(UC const *first, UC const *last, double &d, float &f,
+                chars_format const fmt /*= chars_format::general*/) noexcept {
+  return from_chars_dual_advanced(first, last, d, f, parse_options_t<UC>(fmt));
+}
+
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_approximate_advanced(UC const *first, UC const *last, T &value,
+                                parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_float_type<T>::value,
+                "this type of floating-point type isn't supported");
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  from_chars_result_t<UC> answer;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
+  }
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  bool const bjf = chars_format_t(options.format & detail::basic_json_fmt) != 0;
+#endif
+  // The spans are kept: with more than 19 digits they are needed to truncate
+  // the mantissa, and parsing again would cost more than storing them.
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      bjf ? parse_number_string<true, UC>(first, last, options, true) :
+#endif
+          parse_number_string<false, UC>(first, last, options, true);
+  if (pns.invalid) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (chars_format_t(options.format & chars_format::no_infnan)) {
+#endif
+      answer.ec = std::errc::invalid_argument;
+      answer.ptr = first;
+      return answer;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    } else {
+      return detail::parse_infnan(first, last, value, options.format);
+    }
+#endif
+  }
+  answer.ec = std::errc();
+  answer.ptr = pns.lastmatch;
+
+  if (!pns.too_many_digits &&
+      clinger_fast_path_impl(pns.mantissa, pns.exponent,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                             pns.negative,
+#endif
+                             value,
+                             // the environment is not probed
+                             detail::rounding_context{
+                                 rounding_mode::nearest_even,
+                                 !is_constant_evaluated()})) {
+    return answer;
+  }
+  // Rounding to nearest the first 19 significant digits: the ignored ones
+  // move the number by less than 10^-18 of its value, far less than half an
+  // ULP, so that the result is at most 1 ULP away.
+  adjusted_mantissa const am =
+      compute_float<binary_format<T>>(pns.exponent, pns.mantissa);
+  answer.ec = detail::store_rounded(pns, am, value);
+  return answer;
+}
+
+template <typename T, typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+from_chars_approximate(UC const *first, UC const *last, T &value,
+                       chars_format const fmt /*= chars_format::general*/) noexcept {
+  return from_chars_approximate_advanced(first, last, value,
+                                         parse_options_t<UC>(fmt));
+}
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 lex_result_t<UC>
+lex_number_advanced(UC const *first, UC const *last,
+                    parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  lex_result_t<UC> answer;
+  answer.kind = number_kind::integer;
+  answer.integer = 0;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
+  }
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+  // The spans are needed to tell a plain digit run from a number with a
+  // fraction or an exponent, so they are stored from the start.
+  parsed_number_string_t<UC> const pns =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      chars_format_t(options.format & detail::basic_json_fmt)
+          ? parse_number_string<true, UC>(first, last, options, true)
+          :
+#endif
+          parse_number_string<false, UC>(first, last, options, true);
+  if (pns.invalid) {
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (!chars_format_t(options.format & chars_format::no_infnan)) {
+      answer.kind = number_kind::special;
+      answer.decimal = 0;
+      from_chars_result_t<UC> const r =
+          detail::parse_infnan(first, last, answer.decimal, options.format);
+      answer.ptr = r.ptr;
+      answer.ec = r.ec;
+      return answer;
+    }
+#endif
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+
+  answer.ec = std::errc();
+  answer.ptr = pns.lastmatch;
+  // A plain digit run has neither a fraction nor an exponent, and with at
+  // most 19 significant digits its mantissa is exact.
+  if (pns.fraction.ptr == nullptr &&
+      pns.integer.ptr + pns.integer.len() == pns.lastmatch &&
+      !pns.too_many_digits &&
+      integer_from_magnitude(value128(pns.mantissa, 0),
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                             pns.negative,
+#endif
+                             answer.integer)) {
+    return answer;
+  }
+  answer.kind = number_kind::decimal;
+  answer.decimal = 0;
+  answer.ec = from_chars_advanced(pns, answer.decimal, options.rounding).ec;
+  return answer;
+}
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 lex_result_t<UC>
+lex_number(UC const *first, UC const *last,
+           chars_format const fmt /*= chars_format::general*/) noexcept {
+  return lex_number_advanced(first, last, parse_options_t<UC>(fmt));
+}
+
+/**
+ * A number that has been tokenized but not converted yet. It holds the
+ * mantissa, exponent, sign and digit spans produced by parse_number_string, so
+ * the same token can be converted to several types without scanning the
+ * characters again. The spans point into the parsed input, which must outlive
+ * the conversions.
+ */
+template <typename UC> struct lazy_number_t {
+  /**
+   * Converts to a floating-point type with the same result as from_chars, or
+   * to an integer type with the semantics of
+   * chars_format::allow_integral_float: "1e3" is 1000, "1.5" is rejected with
+   * std::errc::invalid_argument.
+   */
+  template <typename T>
+  FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC> as(T &value) const noexcept {
+    return as_impl(value, std::integral_constant<bool,
+                                                 is_supported_float_type<T>::value>());
+  }
+
+  /**
+   * Like as(T &value) but returns the value directly, errors are dropped.
+   */
+  template <typename T> FASTFLOAT_CONSTEXPR20 T as() const noexcept {
+    T value{};
+    as(value);
+    return value;
+  }
+
+  parsed_number_string_t<UC> number;
+
+private:
+  template <typename T>
+  FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+  as_impl(T &value, std::true_type /* floating-point */) const noexcept {
+    return from_chars_advanced(number, value);
+  }
+
+  template <typename T>
+  FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+  as_impl(T &value, std::false_type /* integer */) const noexcept {
+    static_assert(is_supported_integer_type<T>::value,
+                  "only floating-point and integer types are supported");
+    from_chars_result_t<UC> answer;
+    answer.ptr = number.lastmatch;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+    if (!is_signed_integer<T>::value && number.negative) {
+      answer.ec = std::errc::invalid_argument;
+      return answer;
+    }
+#endif
+    value128 v;
+    answer.ec = integral_magnitude(number, v);
+    if (answer.ec == std::errc() && !integer_from_magnitude(v,
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+                                                            number.negative,
+#endif
+                                                            value)) {
+      answer.ec = std::errc::result_out_of_range;
+    }
+    return answer;
+  }
+};
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+tokenize_number_advanced(UC const *first, UC const *last,
+                         lazy_number_t<UC> &value,
+                         parse_options_t<UC> const options) noexcept {
+  static_assert(is_supported_char_type<UC>::value,
+                "only char, wchar_t, char16_t and char32_t are supported");
+
+  from_chars_result_t<UC> answer;
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+  if (chars_format_t(options.format & chars_format::skip_white_space)) {
+    first = skip_spaces(first, last);
+  }
+#else
+#ifdef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  // We are in parser code with external loop that checks bounds.
+  FASTFLOAT_ASSUME(first < last);
+#endif
+#endif
+#ifndef FASTFLOAT_ISNOT_CHECKED_BOUNDS
+  if (first == last) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+#endif
+  // The spans are stored: a later conversion may need the truncated mantissa
+  // or the digits themselves.
+  value.number =
+#ifndef FASTFLOAT_ONLY_POSITIVE_C_NUMBER_WO_INF_NAN
+      chars_format_t(options.format & detail::basic_json_fmt)
+          ? parse_number_string<true, UC>(first, last, options, true)
+          :
+#endif
+          parse_number_string<false, UC>(first, last, options, true);
+  if (value.number.invalid) {
+    answer.ec = std::errc::invalid_argument;
+    answer.ptr = first;
+    return answer;
+  }
+  answer.ec = std::errc();
+  answer.ptr = value.number.lastmatch;
+  return answer;
+}
+
+template <typename UC>
+FASTFLOAT_CONSTEXPR20 from_chars_result_t<UC>
+tokenize_number(UC const *first, UC const *last, lazy_number_t<UC> &value,
+                chars_format const fmt /*= chars_format::general*/) noexcept {
+  return tokenize_number_advanced(first, last, value, parse_options_t<UC>(fmt));
 }
 
 } // namespace fast_float
@@ -0,0 +1,68 @@
+#ifndef FASTFLOAT_PROJECTION_H
+#define FASTFLOAT_PROJECTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include "float_common.h"
+#include "ascii_number.h"
+#include "parse_number.h"
+
+namespace fast_float {
+
+template <typename T, typename UC>
+from_chars_array_result_t<UC>
+from_chars_columns(UC const *first, UC const *last, size_t const *columns,
+                   size_t const column_count, T *const *values,
+                   size_t const rows, UC const separator,
+                   parse_options_t<UC> const options) noexcept {
+  from_chars_array_result_t<UC> answer;
+  answer.ptr = first;
+  answer.ec = std::errc();
+  answer.count = 0;
+  for (size_t k = 1; k < column_count; ++k) {
+    if (columns[k] <= columns[k - 1]) {
+      answer.ec = std::errc::invalid_argument;
+      return answer;
+    }
+  }
+  while (answer.count != rows && answer.ptr != last) {
+    UC const *p = answer.ptr;
+    size_t column = 0;
+    for (size_t k = 0; k < column_count; ++k) {
+      // the fields before the projected one are only scanned, from the
+      // separator after the previous one
+      size_t missing = columns[k] - column;
+      p = skip_fields(p, last, separator, missing);
+      if (missing != 0) {
+        answer.ptr = p;
+        answer.ec = std::errc::invalid_argument;
+        return answer;
+      }
+      T value = T();
+      from_chars_result_t<UC> const number =
+          from_chars_advanced(p, last, value, options);
+      if (number.ec == std::errc::invalid_argument ||
+          !is_field_end(number.ptr, last, separator)) {
+        answer.ptr = p;
+        answer.ec = std::errc::invalid_argument;
+        return answer;
+      }
+      if (number.ec != std::errc()) {
+        answer.ec = number.ec;
+      }
+      values[k][answer.count] = value;
+      p = number.ptr;
+      column = columns[k];
+    }
+    uint64_t one = 1;
+    answer.ptr = skip_lines(p, last, one);
+    ++answer.count;
+  }
+  return answer;
+}
+
+} // namespace fast_float
+
+#endif
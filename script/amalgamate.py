@@ -40,7 +40,15 @@ for filename in [
     "decimal_to_binary.h",
     "bigint.h",
     "digit_comparison.h",
+    "decimal_bid.h",
+    "extended_float.h",
     "parse_number.h",
+    "column_parser.h",
+    "parse_cache.h",
+    "field_index.h",
+    "line_index.h",
+    "projection.h",
+    "extraction.h",
 ]:
     with open("include/fast_float/" + filename, encoding="utf8") as f:
         text = ""
@@ -111,7 +119,15 @@ text = "".join(
         processed_files["decimal_to_binary.h"],
         processed_files["bigint.h"],
         processed_files["digit_comparison.h"],
+        processed_files["decimal_bid.h"],
+        processed_files["extended_float.h"],
         processed_files["parse_number.h"],
+        processed_files["column_parser.h"],
+        processed_files["parse_cache.h"],
+        processed_files["field_index.h"],
+        processed_files["line_index.h"],
+        processed_files["projection.h"],
+        processed_files["extraction.h"],
     ]
 )
 
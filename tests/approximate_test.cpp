@@ -0,0 +1,119 @@
+/*
+ * Exercise from_chars_approximate: at most 1 ULP away from from_chars.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+template <typename T>
+bool same(T a, T b) {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// With no more than 19 significant digits, the result is exact.
+template <typename T> bool check(std::string const &input, bool exact) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  T expected = 0;
+  auto const reference = fast_float::from_chars(first, last, expected);
+  T value = 0;
+  auto const answer = fast_float::from_chars_approximate(first, last, value);
+  bool ok = answer.ptr == reference.ptr;
+  if (ok && reference.ec == std::errc()) {
+    ok = answer.ec == std::errc() &&
+         (same(value, expected) ||
+          (!exact && (same(value, std::nextafter(expected, T(0))) ||
+                      same(value, std::nextafter(expected, 2 * expected)))));
+  } else if (ok) {
+    ok = answer.ec == reference.ec;
+  }
+  if (!ok) {
+    std::cerr << "mismatch for " << input << " (" << sizeof(T)
+              << " bytes): " << std::hexfloat << value << " " << expected
+              << std::defaultfloat << "\n";
+  }
+  return ok;
+}
+
+bool check_both(std::string const &input, bool exact) {
+  return check<double>(input, exact) && check<float>(input, exact);
+}
+
+int main() {
+  std::vector<std::string> const exact_inputs{
+      "0",      "-0",    "1",         "-2.5",     "0.1",   "3.14159",
+      "1e23",   "1e400", "-1e-400",   "inf",      "-nan",  "x",
+      "7e-46",  "1e39",  "9007199254740993",      "4.9406564584124654e-324",
+  };
+  for (auto const &input : exact_inputs) {
+    if (!check_both(input, true)) {
+      return EXIT_FAILURE;
+    }
+  }
+  std::vector<std::string> const long_inputs{
+      "0.1000000000000000055511151231257827021181583404541015625",
+      "0.10000000000000000555111512312578270211815834045410156250000000001",
+      "0.10000000000000000555111512312578270211815834045410156249999999999",
+      "9007199254740993.0000000000000000000000000001",
+      "123456789012345678901234567890",
+      "1.7976931348623157081452742373170435679807056752584499659891747680315e308",
+      "2.4703282292062327208828439643411068618252990130716238221279284125033775"
+      "3635104375932649918180817996189898282347722858865463328355177969898199387"
+      "3e-324",
+      "0.000000000000000000000000000000000000011754943508222875079687365372222",
+  };
+  for (auto const &input : long_inputs) {
+    if (!check_both(input, false)) {
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::u16string const input = u" 0.333333333333333333333333333;";
+    double value = 0;
+    fast_float::parse_options_t<char16_t> const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::skip_white_space);
+    auto const answer = fast_float::from_chars_approximate_advanced(
+        input.data(), input.data() + input.size(), value, options);
+    if (!answer || answer.ptr != input.data() + input.size() - 1 ||
+        std::fabs(value - 1.0 / 3) > 1e-16) {
+      std::cerr << "mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Random doubles with up to 19 digits, and with 20 to 40 digits, e.g.,
+  // close to the halfway points.
+  std::mt19937_64 rng(5);
+  for (size_t i = 0; i < 30000; ++i) {
+    char buffer[128];
+    uint64_t const bits = rng();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    snprintf(buffer, sizeof(buffer), "%.*e", int(rng() % 19), value);
+    if (!check_both(buffer, true)) {
+      return EXIT_FAILURE;
+    }
+    double const halfway =
+        value / 2 +
+        std::nextafter(value, std::numeric_limits<double>::infinity()) / 2;
+    snprintf(buffer, sizeof(buffer), "%.*e", int(rng() % 21) + 19, halfway);
+    if (!check_both(buffer, false)) {
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
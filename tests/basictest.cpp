@@ -2448,4 +2448,172 @@ TEST_CASE("integer_times_pow10") {
     all::verify_integer_times_pow10(std::numeric_limits<uint64_t>::max(), 42);
     all::verify_integer_times_pow10(std::numeric_limits<uint64_t>::max(), -42);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("lex_number") {
+  auto lex = [](std::string const &input) {
+    auto answer =
+        fast_float::lex_number(input.data(), input.data() + input.size());
+    CHECK_MESSAGE(answer.ec == std::errc(), "expected parse success");
+    CHECK_MESSAGE(answer.ptr == input.data() + input.size(),
+                  "Parsing should have stopped at end");
+    return answer;
+  };
+  auto check_integer = [&](std::string const &input, int64_t expected) {
+    INFO("input: " << input);
+    auto const answer = lex(input);
+    CHECK(answer.kind == fast_float::number_kind::integer);
+    CHECK_EQ(answer.integer, expected);
+  };
+  auto check_decimal = [&](std::string const &input) {
+    INFO("input: " << input);
+    auto const answer = lex(input);
+    CHECK(answer.kind == fast_float::number_kind::decimal);
+    double expected;
+    fast_float::from_chars(input.data(), input.data() + input.size(),
+                           expected);
+    CHECK_EQ(answer.decimal, expected);
+  };
+
+  check_integer("0", 0);
+  check_integer("-0", 0);
+  check_integer("42", 42);
+  check_integer("-42", -42);
+  check_integer("007", 7);
+  check_integer("9223372036854775807", std::numeric_limits<int64_t>::max());
+  check_integer("-9223372036854775808", std::numeric_limits<int64_t>::min());
+  check_integer("0000000000000000000000000000001", 1);
+
+  check_decimal("1.0");
+  check_decimal("1.");
+  check_decimal(".5");
+  check_decimal("1e3");
+  check_decimal("-2.5E-3");
+  check_decimal("0.1");
+  check_decimal("9223372036854775808");
+  check_decimal("-9223372036854775809");
+  check_decimal("123456789012345678901234567890");
+  check_decimal("2.2250738585072013830902327173324040642192159804623318306e-308");
+
+  {
+    auto const answer = lex("-inf");
+    CHECK(answer.kind == fast_float::number_kind::special);
+    CHECK_EQ(answer.decimal, -std::numeric_limits<double>::infinity());
+  }
+  {
+    auto const answer = lex("nan");
+    CHECK(answer.kind == fast_float::number_kind::special);
+    CHECK(std::isnan(answer.decimal));
+  }
+  {
+    std::string const input = "12,5";
+    auto const answer =
+        fast_float::lex_number(input.data(), input.data() + input.size());
+    CHECK(answer.ec == std::errc());
+    CHECK(answer.ptr == input.data() + 2);
+    CHECK(answer.kind == fast_float::number_kind::integer);
+    CHECK_EQ(answer.integer, 12);
+  }
+  {
+    std::string const input = "1e400";
+    auto const answer =
+        fast_float::lex_number(input.data(), input.data() + input.size());
+    CHECK(answer.ec == std::errc::result_out_of_range);
+    CHECK(answer.kind == fast_float::number_kind::decimal);
+    CHECK_EQ(answer.decimal, std::numeric_limits<double>::infinity());
+  }
+  {
+    std::string const input = "abc";
+    auto const answer =
+        fast_float::lex_number(input.data(), input.data() + input.size());
+    CHECK(answer.ec == std::errc::invalid_argument);
+    CHECK(answer.ptr == input.data());
+  }
+  {
+    std::string const input = "inf";
+    auto const answer = fast_float::lex_number(
+        input.data(), input.data() + input.size(), fast_float::chars_format::json);
+    CHECK(answer.ec == std::errc::invalid_argument);
+  }
+  {
+    std::u16string const input = u"-17.25e1";
+    auto const answer =
+        fast_float::lex_number(input.data(), input.data() + input.size());
+    CHECK(answer.ec == std::errc());
+    CHECK(answer.kind == fast_float::number_kind::decimal);
+    CHECK_EQ(answer.decimal, -172.5);
+  }
+}
+
+TEST_CASE("lazy_number") {
+  {
+    std::string const input = "1e3";
+    fast_float::lazy_number number;
+    auto const answer = fast_float::tokenize_number(
+        input.data(), input.data() + input.size(), number);
+    CHECK(answer.ec == std::errc());
+    CHECK(answer.ptr == input.data() + input.size());
+    CHECK_EQ(number.as<double>(), 1000.0);
+    CHECK_EQ(number.as<float>(), 1000.0f);
+    CHECK_EQ(number.as<int64_t>(), 1000);
+    uint8_t small;
+    CHECK(number.as(small).ec == std::errc::result_out_of_range);
+#ifdef __STDCPP_FLOAT16_T__
+    CHECK_EQ(number.as<std::float16_t>(), std::float16_t(1000.0f));
+#endif
+  }
+  {
+    std::string const input = "-0.1";
+    fast_float::lazy_number number;
+    auto const answer = fast_float::tokenize_number(
+        input.data(), input.data() + input.size(), number);
+    CHECK(answer.ec == std::errc());
+    CHECK_EQ(number.as<double>(), -0.1);
+    CHECK_EQ(number.as<float>(), -0.1f);
+    int64_t i;
+    CHECK(number.as(i).ec == std::errc::invalid_argument);
+    uint64_t u;
+    CHECK(number.as(u).ec == std::errc::invalid_argument);
+  }
+  {
+    // too many digits: the conversions use the truncated mantissa and spans
+    std::string const input =
+        "2.2250738585072013830902327173324040642192159804623318306e-308";
+    fast_float::lazy_number number;
+    auto const answer = fast_float::tokenize_number(
+        input.data(), input.data() + input.size(), number);
+    CHECK(answer.ec == std::errc());
+    double expected;
+    fast_float::from_chars(input.data(), input.data() + input.size(), expected);
+    CHECK_EQ(number.as<double>(), expected);
+    float f;
+    CHECK(number.as(f).ec == std::errc::result_out_of_range);
+  }
+  {
+    std::string const input = "12345678901234567890000000000e-9";
+    fast_float::lazy_number number;
+    fast_float::tokenize_number(input.data(), input.data() + input.size(),
+                                number);
+    CHECK_EQ(number.as<uint64_t>(), 12345678901234567890ull);
+    CHECK_EQ(number.as<double>(), 12345678901234567890.0);
+  }
+  {
+    std::string const input = "inf";
+    fast_float::lazy_number number;
+    auto const answer = fast_float::tokenize_number(
+        input.data(), input.data() + input.size(), number);
+    CHECK(answer.ec == std::errc::invalid_argument);
+    CHECK(answer.ptr == input.data());
+  }
+  {
+    std::u32string const input = U"  42.5";
+    fast_float::lazy_number_t<char32_t> number;
+    fast_float::parse_options_t<char32_t> const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::skip_white_space);
+    auto const answer = fast_float::tokenize_number_advanced(
+        input.data(), input.data() + input.size(), number, options);
+    CHECK(answer.ec == std::errc());
+    CHECK(answer.ptr == input.data() + input.size());
+    CHECK_EQ(number.as<double>(), 42.5);
+  }
+}
@@ -0,0 +1,173 @@
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Every value of the column must be parsed as from_chars_advanced parses it,
+// whichever of the kernel and the fallback takes it.
+template <typename T>
+bool check_column(std::string const &text, size_t const count,
+                  fast_float::parse_options const options, char const *name,
+                  bool const expect_shape) {
+  fast_float::column_parser_t<T> parser(options, 32);
+  char const *p = text.data();
+  char const *q = text.data();
+  char const *const end = text.data() + text.size();
+  for (size_t i = 0; i < count; ++i) {
+    T value = 0;
+    T expected = 0;
+    auto const answer = parser.parse(p, end, value);
+    auto const reference = fast_float::from_chars_advanced(q, end, expected,
+                                                           options);
+    if (answer.ec != reference.ec || answer.ptr - p != reference.ptr - q ||
+        std::memcmp(&value, &expected, sizeof(T)) != 0) {
+      std::cerr << name << ": value " << i << " \""
+                << std::string(q, size_t(reference.ptr - q))
+                << "\" differs from from_chars_advanced\n";
+      return false;
+    }
+    if (reference.ec != std::errc()) {
+      return true;
+    }
+    p = answer.ptr + 1;
+    q = reference.ptr + 1;
+  }
+  if (parser.has_shape() != expect_shape ||
+      parser.kernel_hits() + parser.fallbacks() != count) {
+    std::cerr << name << ": " << parser.kernel_hits() << " kernel hits and "
+              << parser.fallbacks() << " fallbacks\n";
+    return false;
+  }
+  if (expect_shape && parser.kernel_hits() < count / 2) {
+    std::cerr << name << ": the kernel parsed only " << parser.kernel_hits()
+              << " values\n";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool check_format(char const *format, double const scale, double const odd,
+                  bool const expect_shape) {
+  std::mt19937_64 rng(45);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  size_t const count = 5000;
+  std::string text;
+  char buffer[64];
+  for (size_t i = 0; i < count; ++i) {
+    double const x = dis(rng);
+    // a few values of another shape, or with an exponent
+    if (std::uniform_real_distribution<double>(0, 1)(rng) < odd) {
+      switch (rng() % 4) {
+      case 0:
+        snprintf(buffer, sizeof(buffer), "%.3e", x * scale);
+        break;
+      case 1:
+        snprintf(buffer, sizeof(buffer), "%.0f", x * scale);
+        break;
+      case 2:
+        snprintf(buffer, sizeof(buffer), "%.10f", x);
+        break;
+      default:
+        snprintf(buffer, sizeof(buffer), "%.2f.5", x * scale);
+      }
+    } else {
+      snprintf(buffer, sizeof(buffer), format, x * scale);
+    }
+    text += buffer;
+    text += (i % 4 == 3) ? '\n' : ',';
+  }
+  fast_float::parse_options const options(fast_float::chars_format::general);
+  return check_column<T>(text, count, options, format, expect_shape);
+}
+
+int main() {
+  // prices, coordinates, and columns the kernel cannot take
+  if (!check_format<double>("%.2f", 100000, 0, true) ||
+      !check_format<double>("%.2f", 100000, 0.05, true) ||
+      !check_format<double>("%.6f", 10, 0.02, true) ||
+      !check_format<float>("%.4f", 1000, 0.01, true) ||
+      !check_format<double>("%.8f", 10000000, 0, true) ||
+      !check_format<double>("%.0f", 1000, 0, true) ||
+      !check_format<double>("%.9g", 1, 0, false) ||
+      !check_format<double>("%.3e", 1, 0, false) ||
+      !check_format<float>("%.8f", 10, 0, false)) {
+    return EXIT_FAILURE;
+  }
+  // the shape is learned again when the column changes
+  std::string text;
+  char buffer[64];
+  for (size_t i = 0; i < 4000; ++i) {
+    snprintf(buffer, sizeof(buffer), i < 2000 ? "%.2f " : "%.5f ",
+             1000 + double(i % 1000) * 1.37);
+    text += buffer;
+  }
+  fast_float::parse_options const options(fast_float::chars_format::general);
+  if (!check_column<double>(text, 4000, options, "two shapes", true)) {
+    return EXIT_FAILURE;
+  }
+  // a number cut by the end of the input, in the padded buffer
+  for (char const *input : {"12.34", "12.3", "12.345", "-12.34", "12.34e1",
+                            "12.34.", "1234", "x", ""}) {
+    std::string values;
+    for (size_t i = 0; i < 100; ++i) {
+      values += "12.34,";
+    }
+    values += input;
+    fast_float::column_parser_t<double> parser(options, 8);
+    char const *p = values.data();
+    char const *const end = values.data() + values.size();
+    double value;
+    for (size_t i = 0; i < 100; ++i) {
+      p = parser.parse(p, end, value).ptr + 1;
+    }
+    double expected = 0;
+    auto const reference = fast_float::from_chars(p, end, expected);
+    auto const answer = parser.parse(p, end, value);
+    if (!parser.has_shape() || answer.ec != reference.ec ||
+        answer.ptr != reference.ptr ||
+        (reference.ec == std::errc() && value != expected)) {
+      std::cerr << "last value \"" << input << "\" differs from from_chars\n";
+      return EXIT_FAILURE;
+    }
+  }
+  // the JSON rules are left to from_chars
+  fast_float::column_parser_t<double> json(
+      fast_float::parse_options(fast_float::chars_format::json), 4);
+  std::string const leading_zero = "01.50,01.50,01.50,01.50,01.50,01.50";
+  double value;
+  for (size_t i = 0; i < 6; ++i) {
+    if (json.parse(leading_zero.data() + 6 * i,
+                   leading_zero.data() + leading_zero.size(), value)
+            .ec != std::errc::invalid_argument) {
+      std::cerr << "a leading zero must be rejected in JSON\n";
+      return EXIT_FAILURE;
+    }
+  }
+  // white space and a comma as decimal separator
+  fast_float::parse_options const spaced(
+      fast_float::chars_format::general |
+          fast_float::chars_format::skip_white_space,
+      ',');
+  text.clear();
+  for (size_t i = 0; i < 1000; ++i) {
+    snprintf(buffer, sizeof(buffer), "%12.3f;", 100 + double(i) * 0.321);
+    for (char *c = buffer; *c; ++c) {
+      if (*c == '.') {
+        *c = ',';
+      }
+    }
+    text += buffer;
+  }
+  if (!check_column<double>(text, 1000, spaced, "%12,3f", true)) {
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,55 @@
+/*
+ * Exercise FASTFLOAT_COMPACT_POWERS_TABLE: every rebuilt power of five must
+ * match the full table, which stays declared but is only used here.
+ */
+#ifndef FASTFLOAT_COMPACT_POWERS_TABLE
+#define FASTFLOAT_COMPACT_POWERS_TABLE
+#endif
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+int main() {
+  for (fast_float::am_pow_t q = fast_float::powers::smallest_power_of_five;
+       q <= fast_float::powers::largest_power_of_five; ++q) {
+    fast_float::value128 const power = fast_float::compact_power_of_five_128(q);
+    fast_float::am_pow_t const index =
+        2 * (q - fast_float::powers::smallest_power_of_five);
+    if (power.high != fast_float::powers::power_of_five_128[index] ||
+        power.low != fast_float::powers::power_of_five_128[index + 1]) {
+      std::cerr << "mismatch for 5^" << q << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  struct {
+    std::string input;
+    double expected;
+  } const cases[] = {
+      {"0.1", 0.1},
+      {"1e23", 1e23},
+      {"2.2250738585072014e-308", 2.2250738585072014e-308},
+      {"4.9406564584124654e-324", 4.9406564584124654e-324},
+      {"1.7976931348623157e308", 1.7976931348623157e308},
+      {"9007199254740993", 9007199254740993.0},
+      {"3.141592653589793238462643383279", 3.141592653589793238462643383279},
+      {"7.2057594037927933e16", 7.2057594037927933e16},
+  };
+  for (auto const &c : cases) {
+    double value = 0;
+    auto const answer = fast_float::from_chars(
+        c.input.data(), c.input.data() + c.input.size(), value);
+    if (answer.ec != std::errc() ||
+        std::memcmp(&value, &c.expected, sizeof(value)) != 0) {
+      std::cerr << "mismatch for " << c.input << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*
+ * Exercise the IEEE 754 decimal64 and decimal128 (BID) conversions.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+struct test_case {
+  std::string input;
+  uint64_t d64;
+  bool d64_in_range;
+  uint64_t d128_high;
+  uint64_t d128_low;
+  bool d128_in_range;
+};
+
+int main() {
+  // Expected encodings match the GCC _Decimal64/_Decimal128 literals, except
+  // where GCC double rounds (e.g. "1234567890123456.50000000000000000001").
+  std::vector<test_case> const cases{
+      {"0", 0x31c0000000000000, true, 0x3040000000000000, 0x0, true},
+      {"-0", 0xb1c0000000000000, true, 0xb040000000000000, 0x0, true},
+      {"0.000", 0x3160000000000000, true, 0x303a000000000000, 0x0, true},
+      {"1", 0x31c0000000000001, true, 0x3040000000000000, 0x1, true},
+      {"1.50", 0x3180000000000096, true, 0x303c000000000000, 0x96, true},
+      {"-7.25e-3", 0xb1200000000002d5, true, 0xb036000000000000, 0x2d5, true},
+      {"123456789012345678", 0x320462d53c8abac1, true, 0x3040000000000000,
+       0x01b69b4ba630f34e, true},
+      {"9999999999999999", 0x6c7386f26fc0ffff, true, 0x3040000000000000,
+       0x002386f26fc0ffff, true},
+      {"99999999999999995", 0x32038d7ea4c68000, true, 0x3040000000000000,
+       0x016345785d89fffb, true},
+      {"99999999999999985", 0x6c7b86f26fc0fffe, true, 0x3040000000000000,
+       0x016345785d89fff1, true},
+      {"1234567890123456.5", 0x31c462d53c8abac0, true, 0x303e000000000000,
+       0x002bdc545d6b4b85, true},
+      {"1234567890123457.5", 0x31c462d53c8abac2, true, 0x303e000000000000,
+       0x002bdc545d6b4b8f, true},
+      {"1234567890123456.50000000000000000001", 0x31c462d53c8abac1, true,
+       0x301c3cde6fff9732, 0xda7f959e06b20000, true},
+      {"9999999999999999e369", 0x77fb86f26fc0ffff, true, 0x3322000000000000,
+       0x002386f26fc0ffff, true},
+      {"1e384", 0x5fe38d7ea4c68000, true, 0x3340000000000000, 0x1, true},
+      {"1e385", 0x7800000000000000, false, 0x3342000000000000, 0x1, true},
+      {"1e-398", 0x0000000000000001, true, 0x2d24000000000000, 0x1, true},
+      {"5e-399", 0x0000000000000000, false, 0x2d22000000000000, 0x5, true},
+      {"15e-399", 0x0000000000000002, true, 0x2d22000000000000, 0xf, true},
+      {"0.5e-398", 0x0000000000000000, false, 0x2d22000000000000, 0x5, true},
+      {"1e-500", 0x0000000000000000, false, 0x2c58000000000000, 0x1, true},
+      {"1e6144", 0x7800000000000000, false, 0x5ffe314dc6448d93,
+       0x38c15b0a00000000, true},
+      {"1e6145", 0x7800000000000000, false, 0x7800000000000000, 0x0, false},
+      {"-1e-6176", 0x8000000000000000, false, 0x8000000000000000, 0x1, true},
+      {"123456789012345678901234567890123456789", 0x34a462d53c8abac1, true,
+       0x304a3cde6fff9732, 0xde825cd07e96aff3, true},
+      {"9999999999999999999999999999999999.5", 0x34238d7ea4c68000, true,
+       0x3042314dc6448d93, 0x38c15b0a00000000, true},
+      {"0.1234567890123456789012345678901234567890e-10", 0x2e8462d53c8abac1,
+       true, 0x2fe83cde6fff9732, 0xde825cd07e96aff3, true},
+      {"-inf", 0xf800000000000000, true, 0xf800000000000000, 0x0, true},
+      {"nan", 0x7c00000000000000, true, 0x7c00000000000000, 0x0, true},
+  };
+
+  for (auto const &c : cases) {
+    char const *first = c.input.data();
+    char const *last = first + c.input.size();
+    fast_float::decimal64 d64{};
+    auto answer = fast_float::from_chars(first, last, d64);
+    if (answer.ptr != last || (answer.ec == std::errc()) != c.d64_in_range ||
+        d64.bits != c.d64) {
+      std::cerr << "decimal64 mismatch for " << c.input << ": " << std::hex
+                << d64.bits << std::dec << "\n";
+      return EXIT_FAILURE;
+    }
+    fast_float::decimal128 d128{};
+    answer = fast_float::from_chars(first, last, d128);
+    if (answer.ptr != last || (answer.ec == std::errc()) != c.d128_in_range ||
+        d128.high != c.d128_high || d128.low != c.d128_low) {
+      std::cerr << "decimal128 mismatch for " << c.input << ": " << std::hex
+                << d128.high << " " << d128.low << std::dec << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  {
+    std::u16string const input = u"  -12.340e2;";
+    fast_float::decimal64 d64{};
+    fast_float::parse_options_t<char16_t> const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::skip_white_space);
+    auto const answer = fast_float::from_chars_advanced(
+        input.data(), input.data() + input.size(), d64, options);
+    if (answer.ec != std::errc() || answer.ptr != input.data() + 11 ||
+        d64.bits != 0xb1a0000000000000 + 12340) {
+      std::cerr << "decimal64 mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "inf";
+    fast_float::decimal64 d64{};
+    auto const answer = fast_float::from_chars(
+        input.data(), input.data() + input.size(), d64,
+        fast_float::chars_format::json);
+    if (answer.ec != std::errc::invalid_argument) {
+      std::cerr << "json should reject inf\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
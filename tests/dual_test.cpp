@@ -0,0 +1,152 @@
+/*
+ * Exercise from_chars_dual: one parse, a double and a float.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+template <typename T>
+bool same(T a, T b) {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// Both values must match from_chars, bit for bit.
+bool check(std::string const &input,
+           fast_float::chars_format fmt = fast_float::chars_format::general) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  double expected_d = 0;
+  float expected_f = 0;
+  auto const rd = fast_float::from_chars(first, last, expected_d, fmt);
+  auto const rf = fast_float::from_chars(first, last, expected_f, fmt);
+  double d = 0;
+  float f = 0;
+  auto const answer = fast_float::from_chars_dual(first, last, d, f, fmt);
+  if (answer.ptr != rd.ptr || answer.ec != rd.ec || answer.float_ec != rf.ec ||
+      (rd.ec != std::errc::invalid_argument &&
+       (!same(d, expected_d) || !same(f, expected_f)))) {
+    std::cerr << "mismatch for " << input << ": " << std::hexfloat << d << " "
+              << expected_d << " " << f << " " << expected_f
+              << std::defaultfloat << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  std::vector<std::string> const inputs{
+      "0",
+      "-0",
+      "1",
+      "-2.5",
+      "0.1",
+      "48.8566140",
+      "-122.4194155",
+      "3.14159",
+      "16777217",
+      "16777216.5",
+      "9007199254740993",
+      "1e23",
+      "7.038531e-26",
+      "1.1754943508e-38",
+      "1.4012984643e-45",
+      "7.0064923216240854e-46",
+      "7.0064923216240862e-46",
+      "3.4028235677973366e38",
+      "3.4028235677973367e38",
+      "1e39",
+      "1e-50",
+      "2.2250738585072014e-308",
+      "4.9406564584124654e-324",
+      "1.7976931348623158e308",
+      "1e-400",
+      "123456789012345678901234567890",
+      "0.10000000000000000555111512312578270211815834045410156250000000001",
+      "1.00000005960464477539062499999999999999999",
+      "1.000000059604644775390625",
+      "1.00000017881393432617187499",
+      "inf",
+      "-nan",
+      "",
+      "x",
+      "1.5e",
+  };
+  for (auto const &input : inputs) {
+    if (!check(input)) {
+      return EXIT_FAILURE;
+    }
+  }
+  if (!check("1d5", fast_float::chars_format::fortran) ||
+      !check("+1", fast_float::chars_format::json)) {
+    return EXIT_FAILURE;
+  }
+  {
+    std::u16string const input = u" 0.1,";
+    double d = 0;
+    float f = 0;
+    fast_float::parse_options_t<char16_t> const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::skip_white_space);
+    auto const answer = fast_float::from_chars_dual_advanced(
+        input.data(), input.data() + input.size(), d, f, options);
+    if (!answer || answer.ptr != input.data() + 4 || d != 0.1 || f != 0.1f) {
+      std::cerr << "mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "0.1";
+    double d = 0;
+    float f = 0;
+    fast_float::parse_options const options(
+        fast_float::chars_format::general, '.', 10,
+        fast_float::rounding_mode::toward_zero);
+    auto const answer = fast_float::from_chars_dual_advanced(
+        input.data(), input.data() + input.size(), d, f, options);
+    if (!answer || d != 0.09999999999999999 || f != 0.099999994f) {
+      std::cerr << "mismatch for toward_zero\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Random doubles and floats printed with a random number of digits, and
+  // halfway points between consecutive floats.
+  std::mt19937_64 rng(11);
+  for (size_t i = 0; i < 50000; ++i) {
+    char buffer[64];
+    uint64_t const bits = rng();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) {
+      snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 20) + 1, value);
+      if (!check(buffer)) {
+        return EXIT_FAILURE;
+      }
+    }
+    uint32_t const float_bits = uint32_t(rng()) & 0x7f7fffff;
+    float narrow;
+    std::memcpy(&narrow, &float_bits, sizeof(narrow));
+    float const next =
+        std::nextafter(narrow, std::numeric_limits<float>::infinity());
+    double const halfway = (double(narrow) + double(next)) / 2;
+    snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 6) + 12, halfway);
+    if (!check(buffer)) {
+      return EXIT_FAILURE;
+    }
+    snprintf(buffer, sizeof(buffer), "%.17g", halfway);
+    if (!check(buffer)) {
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+/*
+ * Exercise the long double, __float128 and std::float128_t conversions.
+ */
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+// Expected encodings: the x87 80-bit extended format as a 16-bit sign and
+// exponent plus the 64-bit significand, and binary128 as two 64-bit words.
+struct test_case {
+  std::string input;
+  uint16_t x87_sign_exponent;
+  uint64_t x87_significand;
+  bool x87_in_range;
+  uint64_t binary128_high;
+  uint64_t binary128_low;
+  bool binary128_in_range;
+};
+
+template <typename T>
+bool check_x87(test_case const &c) {
+  char const *first = c.input.data();
+  char const *last = first + c.input.size();
+  T value{};
+  auto const answer = fast_float::from_chars(first, last, value);
+  uint64_t significand;
+  uint16_t sign_exponent;
+  std::memcpy(&significand, &value, sizeof(significand));
+  std::memcpy(&sign_exponent,
+              reinterpret_cast<unsigned char const *>(&value) + 8,
+              sizeof(sign_exponent));
+  if (answer.ptr != last || (answer.ec == std::errc()) != c.x87_in_range ||
+      sign_exponent != c.x87_sign_exponent ||
+      significand != c.x87_significand) {
+    std::cerr << "x87 mismatch for " << c.input << ": " << std::hex
+              << sign_exponent << " " << significand << std::dec << "\n";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool check_binary128(test_case const &c, char const *name) {
+  char const *first = c.input.data();
+  char const *last = first + c.input.size();
+  T value{};
+  auto const answer = fast_float::from_chars(first, last, value);
+  uint64_t words[2];
+  std::memcpy(words, &value, sizeof(words));
+#if FASTFLOAT_IS_BIG_ENDIAN
+  uint64_t const high = words[0], low = words[1];
+#else
+  uint64_t const high = words[1], low = words[0];
+#endif
+  if (answer.ptr != last ||
+      (answer.ec == std::errc()) != c.binary128_in_range ||
+      high != c.binary128_high || low != c.binary128_low) {
+    std::cerr << name << " mismatch for " << c.input << ": " << std::hex
+              << high << " " << low << std::dec << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool check(test_case const &c) {
+#if LDBL_MANT_DIG == 64
+  if (!check_x87<long double>(c)) {
+    return false;
+  }
+#elif LDBL_MANT_DIG == 113
+  if (!check_binary128<long double>(c, "long double")) {
+    return false;
+  }
+#endif
+#ifdef __SIZEOF_FLOAT128__
+  if (!check_binary128<__float128>(c, "__float128")) {
+    return false;
+  }
+#endif
+#ifdef __STDCPP_FLOAT128_T__
+  if (!check_binary128<std::float128_t>(c, "std::float128_t")) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+int main() {
+  // Expected encodings match glibc strtold and libquadmath strtoflt128,
+  // except that a non-zero subnormal result is not an error.
+  std::vector<test_case> cases{
+      {"0", 0x0000, 0x0000000000000000, true, 0x0000000000000000,
+       0x0000000000000000, true},
+      {"-0", 0x8000, 0x0000000000000000, true, 0x8000000000000000,
+       0x0000000000000000, true},
+      {"1", 0x3fff, 0x8000000000000000, true, 0x3fff000000000000,
+       0x0000000000000000, true},
+      {"-1.5", 0xbfff, 0xc000000000000000, true, 0xbfff800000000000,
+       0x0000000000000000, true},
+      {"0.1", 0x3ffb, 0xcccccccccccccccd, true, 0x3ffb999999999999,
+       0x999999999999999a, true},
+      {"3.14159265358979323846264338327950288", 0x4000, 0xc90fdaa22168c235,
+       true, 0x4000921fb54442d1, 0x8469898cc51701b8, true},
+      {"1e27", 0x4058, 0xcecb8f27f4200f3a, true, 0x40589d971e4fe840,
+       0x1e74000000000000, true},
+      {"1e28", 0x405c, 0x813f3978f8940984, true, 0x405c027e72f1f128,
+       0x1308800000000000, true},
+      {"1e48", 0x409e, 0xaf298d050e4395d7, true, 0x409e5e531a0a1c87,
+       0x2bad2ce16256fe82, true},
+      {"1e49", 0x40a1, 0xdaf3f04651d47b4c, true, 0x40a1b5e7e08ca3a8,
+       0xf6987819baecbe22, true},
+      {"123456789e-20", 0x3fd7, 0xadbffef44813a115, true, 0x3fd75b7ffde89027,
+       0x422a4499416069ef, true},
+      {"1.18973149535723176502e4932", 0x7ffe, 0xffffffffffffffff, true,
+       0x7ffeffffffffffff, 0xfffdf5f7837da5b2, true},
+      {"1.18973149535723176508575932662800702e4932", 0x7fff, 0x8000000000000000,
+       false, 0x7ffeffffffffffff, 0xffffffffffffffff, true},
+      {"1.2e4932", 0x7fff, 0x8000000000000000, false, 0x7fff000000000000,
+       0x0000000000000000, false},
+      {"1e-4932", 0x0000, 0x261247c8f29357f0, true, 0x00004c248f91e526,
+       0xafe05adf4e3af004, true},
+      {"3.3621031431120935063e-4932", 0x0001, 0x8000000000000000, true,
+       0x0001000000000000, 0x0000346c18d497d8, true},
+      {"3.6e-4951", 0x0000, 0x0000000000000001, true, 0x0000000000000000,
+       0x0001f9a6bdb7a009, true},
+      {"1e-4951", 0x0000, 0x0000000000000000, false, 0x0000000000000000,
+       0x00008c756d969002, true},
+      {"1.9e-4951", 0x0000, 0x0000000000000001, true, 0x0000000000000000,
+       0x00010adf1d047805, true},
+      {"6.5e-4966", 0x0000, 0x0000000000000000, false, 0x0000000000000000,
+       0x0000000000000001, true},
+      {"3e-4966", 0x0000, 0x0000000000000000, false, 0x0000000000000000,
+       0x0000000000000000, false},
+      {"1e-5000", 0x0000, 0x0000000000000000, false, 0x0000000000000000,
+       0x0000000000000000, false},
+      {"1e5000", 0x7fff, 0x8000000000000000, false, 0x7fff000000000000,
+       0x0000000000000000, false},
+      {"1.0000000000000000000542101086242752217003726400434970855712890625",
+       0x3fff, 0x8000000000000000, true, 0x3fff000000000000, 0x0001000000000000,
+       true},
+      {"1.0000000000000000000542101086242752217003726400434970855712890626",
+       0x3fff, 0x8000000000000001, true, 0x3fff000000000000, 0x0001000000000000,
+       true},
+      {"1.00000000000000000000000000000000009629649721936179265279889712924636592690508241076940976199693977832794189453125",
+       0x3fff, 0x8000000000000000, true, 0x3fff000000000000, 0x0000000000000000,
+       true},
+      {"0.000000000000000000000000000000000000000000123456789012345678901234567890123456789",
+       0x3f70, 0xb03413276c29973a, true, 0x3f706068264ed853, 0x2e7461d1ef201a88,
+       true},
+      {"9007199254740993", 0x4034, 0x8000000000000400, true, 0x4034000000000000,
+       0x0800000000000000, true},
+      {"18446744073709551615", 0x403e, 0xffffffffffffffff, true,
+       0x403effffffffffff, 0xfffe000000000000, true},
+      {"18446744073709551617e-10", 0x401d, 0xdbe6fecebdedd5c0, true,
+       0x401db7cdfd9d7bdb, 0xab7f22b485ba30ec, true},
+  };
+
+  // A non-zero digit far past the digits that are kept still breaks the tie.
+  std::string const x87_tie =
+      "1.0000000000000000000542101086242752217003726400434970855712890625";
+  std::string const binary128_tie =
+      "1.0000000000000000000000000000000000962964972193617926527988971292463659"
+      "2690508241076940976199693977832794189453125";
+  cases.push_back({x87_tie + std::string(12000, '0') + "1", 0x3fff,
+                   0x8000000000000001, true, 0x3fff000000000000,
+                   0x0001000000000000, true});
+  cases.push_back({binary128_tie + std::string(12000, '0') + "1", 0x3fff,
+                   0x8000000000000000, true, 0x3fff000000000000,
+                   0x0000000000000001, true});
+
+  for (auto const &c : cases) {
+    if (!check(c)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+#if LDBL_MANT_DIG == 53
+  // long double is double: it must agree with the double parser
+  for (auto const &c : cases) {
+    char const *first = c.input.data();
+    char const *last = first + c.input.size();
+    double expected;
+    long double value;
+    auto const reference = fast_float::from_chars(first, last, expected);
+    auto const answer = fast_float::from_chars(first, last, value);
+    if (answer.ptr != reference.ptr || answer.ec != reference.ec ||
+        value != static_cast<long double>(expected)) {
+      std::cerr << "long double mismatch for " << c.input << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+
+  {
+    std::u16string const input = u"  -1.5e0;";
+    long double value{};
+    fast_float::parse_options_t<char16_t> const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::skip_white_space);
+    auto const answer = fast_float::from_chars_advanced(
+        input.data(), input.data() + input.size(), value, options);
+    if (answer.ec != std::errc() || answer.ptr != input.data() + 8 ||
+        value != -1.5L) {
+      std::cerr << "long double mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "-inf";
+    long double value{};
+    auto const answer = fast_float::from_chars(
+        input.data(), input.data() + input.size(), value);
+    if (answer.ec != std::errc() || value != -LDBL_MAX * 2) {
+      std::cerr << "long double mismatch for -inf\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "nan";
+    long double value{};
+    auto const answer = fast_float::from_chars(
+        input.data(), input.data() + input.size(), value);
+    if (answer.ec != std::errc() || value == value) {
+      std::cerr << "long double mismatch for nan\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "1e5";
+    long double value{};
+    auto const answer = fast_float::from_chars(
+        input.data(), input.data() + input.size(), value,
+        fast_float::chars_format::fixed);
+    if (answer.ec != std::errc() || answer.ptr != input.data() + 1 ||
+        value != 1) {
+      std::cerr << "fixed format should stop before the exponent\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// The numbers of a text, extracted `capacity` at a time.
+template <typename UC>
+std::vector<fast_float::extracted_number>
+extract(std::basic_string<UC> const &text,
+        fast_float::extract_options_t<UC> const options, size_t capacity) {
+  std::vector<fast_float::extracted_number> numbers;
+  std::vector<fast_float::extracted_number> buffer(capacity + 1);
+  UC const *p = text.data();
+  UC const *const last = text.data() + text.size();
+  while (true) {
+    auto const answer = fast_float::extract_numbers(p, last, buffer.data(),
+                                                    capacity, options);
+    for (size_t i = 0; i < answer.count; ++i) {
+      buffer[i].offset += size_t(p - text.data());
+      numbers.push_back(buffer[i]);
+    }
+    if (answer.ptr == last) {
+      return numbers;
+    }
+    p = answer.ptr;
+  }
+}
+
+bool same(fast_float::extracted_number const &a,
+          fast_float::extracted_number const &b) {
+  return a.offset == b.offset && a.length == b.length && a.kind == b.kind &&
+         (a.kind == fast_float::number_kind::integer
+              ? a.integer == b.integer
+              : std::memcmp(&a.decimal, &b.decimal, sizeof(double)) == 0);
+}
+
+bool same(std::vector<fast_float::extracted_number> const &a,
+          std::vector<fast_float::extracted_number> const &b) {
+  if (a.size() != b.size()) {
+    std::cerr << a.size() << " numbers instead of " << b.size() << "\n";
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (!same(a[i], b[i])) {
+      std::cerr << "number " << i << " at " << a[i].offset << " differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// The numbers of "took 12.5ms, 3 retries, size=4096" and the like.
+bool check_example(char const *text, fast_float::number_boundary boundary,
+                   char const *expected) {
+  fast_float::extracted_number numbers[16];
+  auto const answer = fast_float::extract_numbers(
+      text, text + std::strlen(text), numbers, 16,
+      fast_float::extract_options(boundary));
+  std::string found;
+  for (size_t i = 0; i < answer.count; ++i) {
+    char buffer[64];
+    if (numbers[i].kind == fast_float::number_kind::integer) {
+      snprintf(buffer, sizeof(buffer), "%s%lld", i ? " " : "",
+               static_cast<long long>(numbers[i].integer));
+    } else {
+      snprintf(buffer, sizeof(buffer), "%s%g", i ? " " : "",
+               numbers[i].decimal);
+    }
+    found += buffer;
+    std::string const token(text + numbers[i].offset, numbers[i].length);
+    if (std::strtod(token.c_str(), nullptr) !=
+        (numbers[i].kind == fast_float::number_kind::integer
+             ? double(numbers[i].integer)
+             : numbers[i].decimal)) {
+      std::cerr << "the token " << token << " is not the number\n";
+      return false;
+    }
+  }
+  if (answer.ec != std::errc() || found != expected) {
+    std::cerr << "\"" << text << "\" gives \"" << found << "\" instead of \""
+              << expected << "\"\n";
+    return false;
+  }
+  return true;
+}
+
+// A text of words, numbers of all kinds, and punctuation.
+std::string make_text(std::mt19937_64 &rng, size_t const pieces) {
+  char const *const words[] = {"took", "ms",  "retries", "size=", "x", "v",
+                               "e",    "E",   "id",      "_",     "é", "",
+                               " ",    ", ",  ".",       "-",     "+", "\n",
+                               "\t",   "...", "--",      ":",     "/", "0x"};
+  char const *const formats[] = {"%.0f", "%.2f", "%.17g", "%.3e", "%g"};
+  std::uniform_real_distribution<double> dis(-1e6, 1e6);
+  std::string text;
+  char buffer[64];
+  for (size_t piece = 0; piece < pieces; ++piece) {
+    if (rng() % 2 == 0) {
+      text += words[rng() % (sizeof(words) / sizeof(words[0]))];
+    } else if (rng() % 3 == 0) {
+      snprintf(buffer, sizeof(buffer), "%llu",
+               static_cast<unsigned long long>(rng() >> (rng() % 64)));
+      text += buffer;
+    } else {
+      snprintf(buffer, sizeof(buffer), formats[rng() % 5], dis(rng));
+      text += buffer;
+    }
+  }
+  return text;
+}
+
+bool is_digit(char const *p, char const *last) {
+  return p != last && *p >= '0' && *p <= '9';
+}
+
+// With number_boundary::none, a number is what lex_number reads from the
+// first digit, or sign or point before a digit: the hand-written loop which
+// extract_numbers replaces.
+std::vector<fast_float::extracted_number> reference(std::string const &text) {
+  std::vector<fast_float::extracted_number> numbers;
+  char const *p = text.data();
+  char const *const last = text.data() + text.size();
+  while (p != last) {
+    if (is_digit(p, last) || (*p == '.' && is_digit(p + 1, last)) ||
+        (*p == '-' && (is_digit(p + 1, last) ||
+                       (p + 1 != last && p[1] == '.' &&
+                        is_digit(p + 2, last))))) {
+      fast_float::extracted_number number;
+      auto const lexed = fast_float::lex_number(p, last);
+      if (lexed.ec != std::errc::invalid_argument) {
+        number.offset = size_t(p - text.data());
+        number.length = size_t(lexed.ptr - p);
+        number.kind = lexed.kind;
+        if (lexed.kind == fast_float::number_kind::integer) {
+          number.integer = lexed.integer;
+        } else {
+          number.decimal = lexed.decimal;
+        }
+        numbers.push_back(number);
+        p = lexed.ptr;
+        continue;
+      }
+    }
+    ++p;
+  }
+  return numbers;
+}
+
+int main() {
+  struct example {
+    char const *text;
+    fast_float::number_boundary boundary;
+    char const *expected;
+  };
+  example const examples[] = {
+      {"took 12.5ms, 3 retries, size=4096", fast_float::number_boundary::none,
+       "12.5 3 4096"},
+      {"took 12.5ms, 3 retries, size=4096", fast_float::number_boundary::start,
+       "12.5 3 4096"},
+      {"took 12.5ms, 3 retries, size=4096", fast_float::number_boundary::word,
+       "3 4096"},
+      {"x86 v1.2.3 2024-10-19 -5 a-1 3rd .5 -.5 1e3",
+       fast_float::number_boundary::none,
+       "86 1.2 0.3 2024 -10 -19 -5 -1 3 0.5 -0.5 1000"},
+      {"x86 v1.2.3 2024-10-19 -5 a-1 3rd .5 -.5 1e3",
+       fast_float::number_boundary::start,
+       "2024 10 19 -5 1 3 0.5 -0.5 1000"},
+      {"x86 v1.2.3 2024-10-19 -5 a-1 3rd .5 -.5 1e3",
+       fast_float::number_boundary::word, "2024 10 19 -5 1 0.5 -0.5 1000"},
+      {"inf nan information 7.", fast_float::number_boundary::word, "7"},
+      {"", fast_float::number_boundary::word, ""},
+      {"no numbers at all, none at all, really none at all",
+       fast_float::number_boundary::none, ""},
+  };
+  for (example const &e : examples) {
+    if (!check_example(e.text, e.boundary, e.expected)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::mt19937_64 rng(50);
+  for (size_t round = 0; round < 200; ++round) {
+    std::string const text = make_text(rng, size_t(rng() % 300));
+    std::u16string const wide(text.begin(), text.end());
+    std::vector<fast_float::extracted_number> const expected = reference(text);
+    fast_float::number_boundary const boundaries[] = {
+        fast_float::number_boundary::none, fast_float::number_boundary::start,
+        fast_float::number_boundary::word};
+    for (fast_float::number_boundary const boundary : boundaries) {
+      std::vector<fast_float::extracted_number> const all =
+          extract(text, fast_float::extract_options(boundary), 1000);
+      if (boundary == fast_float::number_boundary::none &&
+          !same(all, expected)) {
+        std::cerr << "round " << round << ": not the reference\n";
+        return EXIT_FAILURE;
+      }
+      // by a few at a time, and with the scalar scan of UTF-16
+      size_t const capacity = size_t(rng() % 3) + 1;
+      if (!same(extract(text, fast_float::extract_options(boundary), capacity),
+                all) ||
+          !same(extract(wide, fast_float::extract_options_t<char16_t>(boundary),
+                        1000),
+                all)) {
+        std::cerr << "round " << round << ": the extractions differ\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // every number as a decimal
+  std::string const integers = "7 9223372036854775808 -12";
+  fast_float::extracted_number numbers[4];
+  auto const decimals = fast_float::extract_numbers(
+      integers.data(), integers.data() + integers.size(), numbers, 4,
+      fast_float::extract_options(fast_float::number_boundary::start, false));
+  if (decimals.count != 3 ||
+      numbers[0].kind != fast_float::number_kind::decimal ||
+      numbers[0].decimal != 7 ||
+      numbers[1].kind != fast_float::number_kind::decimal ||
+      numbers[1].decimal != 9223372036854775808.0 ||
+      numbers[2].kind != fast_float::number_kind::decimal ||
+      numbers[2].decimal != -12) {
+    std::cerr << "integers were kept\n";
+    return EXIT_FAILURE;
+  }
+  // a value out of range is stored and the extraction goes on
+  std::string const huge = "a 1e999 b 2";
+  auto const out_of_range = fast_float::extract_numbers(
+      huge.data(), huge.data() + huge.size(), numbers, 4);
+  if (out_of_range.ec != std::errc::result_out_of_range ||
+      out_of_range.count != 2 || numbers[1].integer != 2) {
+    std::cerr << "1e999 stopped the extraction\n";
+    return EXIT_FAILURE;
+  }
+  // a decimal comma
+  std::string const comma = "pi=3,14; e=2,72";
+  auto const commas = fast_float::extract_numbers(
+      comma.data(), comma.data() + comma.size(), numbers, 4,
+      fast_float::extract_options(
+          fast_float::number_boundary::none, true,
+          fast_float::parse_options(fast_float::chars_format::general, ',')));
+  if (commas.count != 2 || numbers[0].decimal != 3.14 ||
+      numbers[1].decimal != 2.72) {
+    std::cerr << "the decimal comma was not read\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -1678,6 +1678,276 @@ int main() {
     }
   }
 
+  // allow_integral_float: fraction and exponent forms of integral values
+  {
+    struct integral_float_test {
+      std::string_view input;
+      std::errc ec;
+      int64_t expected;
+      std::size_t consumed;
+    };
+    std::vector<integral_float_test> const tests{
+        {"1e6", std::errc(), 1000000, 3},
+        {"2.50E3", std::errc(), 2500, 6},
+        {"1.0", std::errc(), 1, 3},
+        {"-1.5e1", std::errc(), -15, 6},
+        {"0.000", std::errc(), 0, 5},
+        {"0e999", std::errc(), 0, 5},
+        {"42", std::errc(), 42, 2},
+        {"12e3, 4", std::errc(), 12000, 4},
+        {"1e", std::errc(), 1, 1},
+        {"100e-2", std::errc(), 1, 6},
+        {"9.223372036854775807e18", std::errc(), INT64_MAX, 23},
+        {"-9.223372036854775808e18", std::errc(), INT64_MIN, 24},
+        {"1000000000000000000000e-3", std::errc(), 1000000000000000000, 25},
+        {"123.000000000000000000000", std::errc(), 123, 25},
+        {"12345678901234567.89e2", std::errc(), 1234567890123456789, 22},
+        {"1.5", std::errc::invalid_argument, 0, 0},
+        {"1e-1", std::errc::invalid_argument, 0, 0},
+        {"1e-30", std::errc::invalid_argument, 0, 0},
+        {"123.000000000000000000001", std::errc::invalid_argument, 0, 0},
+        {"1234567890123456789.5e0", std::errc::invalid_argument, 0, 0},
+        {"inf", std::errc::invalid_argument, 0, 0},
+        {"e5", std::errc::invalid_argument, 0, 0},
+        {"9.223372036854775808e18", std::errc::result_out_of_range, 0, 23},
+        {"1e19", std::errc::result_out_of_range, 0, 4},
+        {"1e400", std::errc::result_out_of_range, 0, 5},
+        {"92233720368547758070", std::errc::result_out_of_range, 0, 20}};
+    fast_float::parse_options const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::allow_integral_float);
+    for (auto const &test : tests) {
+      int64_t result = 0;
+      auto answer = fast_float::from_chars_advanced(
+          test.input.data(), test.input.data() + test.input.size(), result,
+          options);
+      if (answer.ec != test.ec ||
+          answer.ptr != test.input.data() + test.consumed ||
+          (test.ec == std::errc() && result != test.expected)) {
+        std::cerr << "allow_integral_float: unexpected result for \""
+                  << test.input << "\": " << result << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    // unsigned and narrow types
+    struct {
+      std::string_view input;
+      std::errc ec;
+      uint64_t expected;
+    } const unsigned_tests[] = {
+        {"1.8446744073709551615e19", std::errc(), UINT64_MAX},
+        {"18446744073709551615.000000", std::errc(), UINT64_MAX},
+        {"1.8446744073709551616e19", std::errc::result_out_of_range, 0},
+        {"-1e0", std::errc::invalid_argument, 0}};
+    for (auto const &test : unsigned_tests) {
+      uint64_t result = 0;
+      auto answer = fast_float::from_chars_advanced(
+          test.input.data(), test.input.data() + test.input.size(), result,
+          options);
+      if (answer.ec != test.ec ||
+          (test.ec == std::errc() && result != test.expected)) {
+        std::cerr << "allow_integral_float: unexpected result for unsigned \""
+                  << test.input << "\"" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      std::string_view const input = "2.56e2";
+      uint8_t result = 0;
+      auto answer = fast_float::from_chars_advanced(
+          input.data(), input.data() + input.size(), result, options);
+      if (answer.ec != std::errc::result_out_of_range) {
+        std::cerr << "allow_integral_float: expected result_out_of_range for "
+                     "uint8_t"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    // JSON grammar still applies
+    {
+      fast_float::parse_options const json_options(
+          fast_float::chars_format::json |
+          fast_float::chars_format::allow_integral_float);
+      std::string_view const good = "1.5E+2";
+      std::string_view const bad = "01";
+      int result = 0;
+      auto answer = fast_float::from_chars_advanced(
+          good.data(), good.data() + good.size(), result, json_options);
+      if (answer.ec != std::errc() || result != 150) {
+        std::cerr << "allow_integral_float: JSON input not parsed" << std::endl;
+        return EXIT_FAILURE;
+      }
+      answer = fast_float::from_chars_advanced(
+          bad.data(), bad.data() + bad.size(), result, json_options);
+      if (answer.ec != std::errc::invalid_argument) {
+        std::cerr << "allow_integral_float: invalid JSON accepted" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+#ifdef FASTFLOAT_HAS_INT128
+  // 128-bit integers: limits and the values just past them in every base,
+  // then random round trips (including UTF-16 input).
+  {
+    auto digit_to_char = [](int d) -> char {
+      return d < 10 ? char('0' + d) : char('a' + (d - 10));
+    };
+    auto to_base_128 = [&](__uint128_t mag, bool neg, int base) {
+      std::string s;
+      if (mag == 0) {
+        s += '0';
+      }
+      while (mag != 0) {
+        s += digit_to_char(int(mag % unsigned(base)));
+        mag /= unsigned(base);
+      }
+      if (neg) {
+        s += '-';
+      }
+      std::reverse(s.begin(), s.end());
+      return s;
+    };
+    __uint128_t const u128_max = ~__uint128_t(0);
+    __uint128_t const i128_max = u128_max >> 1;
+    for (int base = 2; base <= 36; ++base) {
+      for (__uint128_t const mag : {u128_max, i128_max, __uint128_t(0),
+                                    __uint128_t(1), __uint128_t(UINT64_MAX),
+                                    __uint128_t(UINT64_MAX) + 1}) {
+        std::string const s = to_base_128(mag, false, base);
+        __uint128_t result = 123;
+        auto answer =
+            fast_float::from_chars(s.data(), s.data() + s.size(), result, base);
+        if (answer.ec != std::errc() || result != mag ||
+            answer.ptr != s.data() + s.size()) {
+          std::cerr << "base " << base << ": unsigned 128-bit \"" << s
+                    << "\" failed to round-trip" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      struct {
+        __uint128_t mag;
+        bool neg;
+        __int128_t v;
+      } const signed_limits[] = {
+          {i128_max, false, __int128_t(i128_max)},
+          {i128_max + 1, true, -__int128_t(i128_max) - 1},
+          {1, true, -1},
+          {0, false, 0}};
+      for (auto const &lim : signed_limits) {
+        std::string const s = to_base_128(lim.mag, lim.neg, base);
+        __int128_t result = 123;
+        auto answer =
+            fast_float::from_chars(s.data(), s.data() + s.size(), result, base);
+        if (answer.ec != std::errc() || result != lim.v) {
+          std::cerr << "base " << base << ": signed 128-bit \"" << s
+                    << "\" failed to round-trip" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      // 2^128 for unsigned, 2^127 and -(2^127 + 1) for signed.
+      std::string const u_over = to_base_128(u128_max, false, base);
+      std::string const over[] = {u_over + "0", to_base_128(i128_max + 1, false, base),
+                                  to_base_128(i128_max + 2, true, base)};
+      {
+        // append a digit: at least base * (2^128 - 1), always out of range
+        __uint128_t result = 123;
+        auto answer = fast_float::from_chars(
+            over[0].data(), over[0].data() + over[0].size(), result, base);
+        if (answer.ec != std::errc::result_out_of_range ||
+            answer.ptr != over[0].data() + over[0].size()) {
+          std::cerr << "base " << base << ": expected result_out_of_range for "
+                    << "unsigned 128-bit \"" << over[0] << "\"" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      for (int k = 1; k < 3; ++k) {
+        __int128_t result = 123;
+        auto answer = fast_float::from_chars(
+            over[k].data(), over[k].data() + over[k].size(), result, base);
+        if (answer.ec != std::errc::result_out_of_range ||
+            answer.ptr != over[k].data() + over[k].size()) {
+          std::cerr << "base " << base << ": expected result_out_of_range for "
+                    << "signed 128-bit \"" << over[k] << "\"" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    // 2^128 exactly, in decimal.
+    {
+      std::string const s = "340282366920938463463374607431768211456";
+      __uint128_t result = 123;
+      auto answer = fast_float::from_chars(s.data(), s.data() + s.size(), result);
+      if (answer.ec != std::errc::result_out_of_range) {
+        std::cerr << "expected result_out_of_range for 2^128" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    {
+      fast_float::parse_options const options(
+          fast_float::chars_format::general |
+          fast_float::chars_format::allow_integral_float);
+      std::string_view const inputs[] = {"1e38", "-1.7e38", "1e39"};
+      __int128_t result = 0;
+      auto answer = fast_float::from_chars_advanced(
+          inputs[0].data(), inputs[0].data() + inputs[0].size(), result,
+          options);
+      __int128_t const e19 = 10000000000000000000ull;
+      if (answer.ec != std::errc() || result != e19 * e19) {
+        std::cerr << "allow_integral_float: 1e38 failed" << std::endl;
+        return EXIT_FAILURE;
+      }
+      answer = fast_float::from_chars_advanced(
+          inputs[1].data(), inputs[1].data() + inputs[1].size(), result,
+          options);
+      if (answer.ec != std::errc() || result != -17 * e19 * (e19 / 10)) {
+        std::cerr << "allow_integral_float: -1.7e38 failed" << std::endl;
+        return EXIT_FAILURE;
+      }
+      answer = fast_float::from_chars_advanced(
+          inputs[2].data(), inputs[2].data() + inputs[2].size(), result,
+          options);
+      if (answer.ec != std::errc::result_out_of_range) {
+        std::cerr << "allow_integral_float: 1e39 accepted" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    std::mt19937_64 gen(128);
+    for (std::size_t i = 0; i < 100000; ++i) {
+      unsigned const bits = unsigned(gen() % 127) + 1;
+      __uint128_t mag = (__uint128_t(gen()) << 64) | gen();
+      mag >>= 128 - bits;
+      int const base = (i % 4 == 0) ? int(gen() % 35) + 2 : 10;
+      bool const neg = (gen() & 1) != 0;
+      std::size_t const zeros = neg ? 0 : std::size_t(gen() % 3);
+      std::string const s =
+          std::string(zeros, '0') + to_base_128(mag, neg, base) + " x";
+      __int128_t const expected = neg ? -__int128_t(mag) : __int128_t(mag);
+      __int128_t result;
+      auto answer =
+          fast_float::from_chars(s.data(), s.data() + s.size(), result, base);
+      if (answer.ec != std::errc() || result != expected ||
+          *answer.ptr != ' ') {
+        std::cerr << "base " << base << ": signed 128-bit \"" << s
+                  << "\" failed to round-trip" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (base == 10 && !neg) {
+        std::u16string const u(s.begin(), s.end());
+        __uint128_t uresult;
+        auto uanswer =
+            fast_float::from_chars(u.data(), u.data() + u.size(), uresult);
+        if (uanswer.ec != std::errc() || uresult != mag ||
+            *uanswer.ptr != u' ') {
+          std::cerr << "UTF-16 unsigned 128-bit \"" << s
+                    << "\" failed to round-trip" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+#endif
+
   return EXIT_SUCCESS;
 }
 #else
@@ -0,0 +1,91 @@
+/*
+ * Exercise the fast paths beyond the exact powers of ten: short mantissas
+ * with exponents a little out of the range of Clinger's fast path.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include "fast_float/fast_float.h"
+
+template <typename T>
+bool same(T a, T b) {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T> bool check(std::string const &input, T expected) {
+  T value = 0;
+  auto const answer = fast_float::from_chars(
+      input.data(), input.data() + input.size(), value);
+  // ec is not checked: the random floats can overflow or underflow
+  if (answer.ptr != input.data() + input.size() || !same(value, expected)) {
+    std::cerr << "mismatch for " << input << " (" << sizeof(T)
+              << " bytes): " << std::hexfloat << value << " " << expected
+              << std::defaultfloat << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  // The expected values are converted by the compiler.
+  if (!check("123456e25", 123456e25) || !check("-123456e25", -123456e25) ||
+      !check("9e37", 9e37) || !check("10e37", 10e37) ||
+      !check("9007199e31", 9007199e31) || !check("9007200e31", 9007200e31) ||
+      !check("1e38", 1e38) || !check("0e30", 0e30) ||
+      !check("-0e30", -0e30) || !check("1.5e-30", 1.5e-30) ||
+      !check("-1.5e-30", -1.5e-30) || !check("1e-23", 1e-23) ||
+      !check("9007199254740992e-44", 9007199254740992e-44) ||
+      !check("9007199254740993e-44", 9007199254740993e-44) ||
+      !check("4.2e-45", 4.2e-45) || !check("6.62607015e-34", 6.62607015e-34) ||
+      !check("1.602176634e-19", 1.602176634e-19) ||
+      !check("1.1754943508222875e-38", 1.1754943508222875e-38) ||
+      !check("8.077935669463161e-28", 8.077935669463161e-28) ||
+      !check("123456e12", 123456e12f) || !check("1e17", 1e17f) ||
+      !check("16777e13", 16777e13f) || !check("16778e13", 16778e13f) ||
+      !check("6.62607015e-34", 6.62607015e-34f)) {
+    return EXIT_FAILURE;
+  }
+  // 2^-100, and the decimal numbers around it: the spacing below a power of
+  // 2 is halved.
+  if (!check("7.888609052210118e-31", 7.888609052210118e-31) ||
+      !check("7.8886090522101180e-31", 7.8886090522101180e-31) ||
+      !check("7.888609052210117e-31", 7.888609052210117e-31)) {
+    return EXIT_FAILURE;
+  }
+
+#if defined(__GLIBC__)
+  // Random short mantissas, exponents -50 to 50, and the halfway points
+  // between doubles of magnitude 1e-44 to 1e-23.
+  std::mt19937_64 rng(37);
+  for (size_t i = 0; i < 200000; ++i) {
+    char buffer[64];
+    unsigned long long const mantissa = rng() % 10000000000000000ULL;
+    unsigned long long const digits = 1 + rng() % 16;
+    unsigned long long scale = 1;
+    for (unsigned long long j = 0; j < digits; ++j) {
+      scale *= 10;
+    }
+    snprintf(buffer, sizeof(buffer), "%llue%d", mantissa % scale,
+             int(rng() % 101) - 50);
+    if (!check(buffer, std::strtod(buffer, nullptr)) ||
+        !check(buffer, std::strtof(buffer, nullptr))) {
+      return EXIT_FAILURE;
+    }
+    double const value =
+        std::pow(10.0, -44 + double(rng() % 2100000) / 100000) * 7;
+    long double const halfway =
+        (static_cast<long double>(value) + std::nextafter(value, 1.0)) / 2;
+    snprintf(buffer, sizeof(buffer), "%.*Le", int(rng() % 6) + 10, halfway);
+    if (!check(buffer, std::strtod(buffer, nullptr))) {
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include "fast_float/fast_float.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// The index updated edit by edit must be the index built from scratch, read
+// field by field or, once the shifts are applied, as an array.
+template <typename T>
+bool same_fields(fast_float::field_index_t<T> &updated,
+                 std::string const &text, char const *name,
+                 bool const as_array) {
+  std::vector<fast_float::indexed_field_t<T>> storage(text.size() + 1);
+  fast_float::field_index_t<T> built(storage.data(), storage.size());
+  if (built.build(text.data(), text.data() + text.size()) != std::errc()) {
+    std::cerr << name << ": the text cannot be indexed\n";
+    return false;
+  }
+  if (updated.size() != built.size()) {
+    std::cerr << name << ": " << updated.size() << " fields instead of "
+              << built.size() << " in \"" << text << "\"\n";
+    return false;
+  }
+  fast_float::indexed_field_t<T> const *const array =
+      as_array ? updated.fields() : nullptr;
+  for (size_t i = 0; i < built.size(); ++i) {
+    fast_float::indexed_field_t<T> const field =
+        as_array ? array[i] : updated[i];
+    fast_float::indexed_field_t<T> const expected = built[i];
+    if (field.start != expected.start || field.ec != expected.ec ||
+        std::memcmp(&field.value, &expected.value, sizeof(T)) != 0) {
+      std::cerr << name << ": field " << i << " differs in \"" << text
+                << "\"\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T> bool check_edits(char const *name) {
+  std::mt19937_64 rng(47);
+  char const alphabet[] = "0123456789012345678901234567890123456789,,,,\n\n"
+                          ".-e \r";
+  std::string text;
+  std::vector<fast_float::indexed_field_t<T>> storage(4096);
+  fast_float::field_index_t<T> index(storage.data(), storage.size());
+  if (index.build(text.data(), text.data()) != std::errc() ||
+      index.size() != 0) {
+    std::cerr << name << ": the empty text has fields\n";
+    return false;
+  }
+  for (size_t round = 0; round < 20000; ++round) {
+    size_t const offset = rng() % (text.size() + 1);
+    size_t const removed =
+        rng() % (std::min<size_t>(text.size() - offset, 6) + 1);
+    std::string inserted;
+    for (size_t n = rng() % 8; n != 0; --n) {
+      inserted += alphabet[rng() % (sizeof(alphabet) - 1)];
+    }
+    bool const append = round % 5 == 0;
+    std::errc ec;
+    if (append) {
+      text += inserted;
+      ec = index.append(text.data(), text.data() + text.size());
+    } else {
+      text.replace(offset, removed, inserted);
+      ec = index.replace(text.data(), text.data() + text.size(), offset,
+                         removed, inserted.size());
+    }
+    if (ec != std::errc()) {
+      std::cerr << name << ": the edit failed\n";
+      return false;
+    }
+    if (!same_fields(index, text, name, round % 7 == 0)) {
+      return false;
+    }
+    // keep the text short enough for the check to be quick
+    if (text.size() > 2000) {
+      text.erase(0, 1000);
+      if (index.replace(text.data(), text.data() + text.size(), 0, 1000, 0) !=
+          std::errc()) {
+        std::cerr << name << ": the erasure failed\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main() {
+  if (!check_edits<double>("double") || !check_edits<float>("float") ||
+      !check_edits<int64_t>("int64_t")) {
+    return EXIT_FAILURE;
+  }
+  // an edit parses the fields it touches, not the others
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += std::to_string(i) + ".5" + (i % 10 == 9 ? "\r\n" : ",");
+  }
+  std::vector<fast_float::indexed_field_t<double>> storage(1002);
+  fast_float::field_index_t<double> index(storage.data(), storage.size());
+  index.build(text.data(), text.data() + text.size());
+  if (index.size() != 1000 || index[999].value != 999.5 ||
+      index[999].ec != std::errc() || index.parsed() != 1000) {
+    std::cerr << "the text was not indexed\n";
+    return EXIT_FAILURE;
+  }
+  size_t const offset = text.find("500.5");
+  text.replace(offset, 3, "7");
+  index.replace(text.data(), text.data() + text.size(), offset, 3, 1);
+  if (index.parsed() != 1001 || index[500].value != 7.5 ||
+      index[501].start != offset + 4 || index[999].value != 999.5) {
+    std::cerr << "the edit was not parsed in place\n";
+    return EXIT_FAILURE;
+  }
+  text += "1e3,x";
+  index.append(text.data(), text.data() + text.size());
+  if (index.parsed() != 1004 || index.size() != 1002 ||
+      index[1000].value != 1000 || index[1000].start != text.size() - 5 ||
+      index[1001].ec != std::errc::invalid_argument) {
+    std::cerr << "the appended field was not parsed\n";
+    return EXIT_FAILURE;
+  }
+  // a field which does not fit leaves the index as it was
+  text += ",2";
+  if (index.append(text.data(), text.data() + text.size()) !=
+          std::errc::value_too_large ||
+      index.size() != 1002) {
+    std::cerr << "the index went past its capacity\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/*
+ * Exercise the binary16 and bfloat16 bit-pattern conversions.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+struct test_case {
+  std::string input;
+  uint16_t float16;
+  bool float16_in_range;
+  uint16_t bfloat16;
+  bool bfloat16_in_range;
+};
+
+template <typename T>
+bool check_one(std::string const &input, uint16_t expected, bool in_range,
+               char const *name) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  T value{};
+  auto const answer = fast_float::from_chars(first, last, value);
+  if (answer.ptr != last || (answer.ec == std::errc()) != in_range ||
+      value.bits != expected) {
+    std::cerr << name << " mismatch for " << input << ": " << std::hex
+              << value.bits << std::dec << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool check_array(char const *name, std::string const &input, size_t count,
+                 std::errc ec, size_t ptr_offset,
+                 std::vector<uint16_t> const &expected) {
+  std::vector<uint16_t> values(count, 0xdead);
+  auto const answer = fast_float::from_chars_float16(
+      input.data(), input.data() + input.size(), values.data(), count);
+  bool ok = answer.ec == ec && answer.ptr == input.data() + ptr_offset &&
+            answer.count == expected.size();
+  for (size_t i = 0; ok && i < expected.size(); ++i) {
+    ok = values[i] == expected[i];
+  }
+  if (!ok) {
+    std::cerr << "array mismatch for " << name << "\n";
+  }
+  return ok;
+}
+
+int main() {
+  std::vector<test_case> cases{
+      {"0", 0x0000, true, 0x0000, true},
+      {"-0", 0x8000, true, 0x8000, true},
+      {"1", 0x3c00, true, 0x3f80, true},
+      {"-2", 0xc000, true, 0xc000, true},
+      {"0.1", 0x2e66, true, 0x3dcd, true},
+      {"255", 0x5bf8, true, 0x437f, true},
+      {"2049", 0x6800, true, 0x4500, true},
+      {"2051", 0x6802, true, 0x4500, true},
+      {"65504", 0x7bff, true, 0x4780, true},
+      {"65519.99", 0x7bff, true, 0x4780, true},
+      {"65520", 0x7c00, false, 0x4780, true},
+      {"3.39e38", 0x7c00, false, 0x7f7f, true},
+      {"3.4e38", 0x7c00, false, 0x7f80, false},
+      {"6.103515625e-5", 0x0400, true, 0x3880, true},
+      {"5.9604644775390625e-8", 0x0001, true, 0x3380, true},
+      // 6.5 * 2^-24 is a subnormal tie: it rounds to the even 6 * 2^-24.
+      {"0.0000003874301910400390625", 0x0006, true, 0x34d0, true},
+      {"2.98023223876953125e-8", 0x0000, false, 0x3300, true},
+      {"2.98023223876953126e-8", 0x0001, true, 0x3300, true},
+      {"1e-50", 0x0000, false, 0x0000, false},
+      {"inf", 0x7c00, true, 0x7f80, true},
+      {"-infinity", 0xfc00, true, 0xff80, true},
+      {"nan", 0x7e00, true, 0x7fc0, true},
+      {"-nan", 0xfe00, true, 0xffc0, true},
+  };
+  for (auto const &c : cases) {
+    if (!check_one<fast_float::float16_bits>(c.input, c.float16,
+                                             c.float16_in_range, "float16") ||
+        !check_one<fast_float::bfloat16_bits>(c.input, c.bfloat16,
+                                              c.bfloat16_in_range,
+                                              "bfloat16")) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Delimited runs stop at the first character that is not the separator.
+  if (!check_array("row", "1,2.5,-0.5\n7", 8, std::errc(), 10,
+                   {0x3c00, 0x4100, 0xb800}) ||
+      !check_array("count", "1,2,3", 2, std::errc(), 3, {0x3c00, 0x4000}) ||
+      !check_array("invalid", "1,x,3", 3, std::errc::invalid_argument, 2,
+                   {0x3c00}) ||
+      !check_array("trailing separator", "1,", 3, std::errc::invalid_argument,
+                   2, {0x3c00}) ||
+      !check_array("out of range", "1,1e6,2", 3, std::errc::result_out_of_range,
+                   7, {0x3c00, 0x7c00, 0x4000}) ||
+      !check_array("empty count", "1,2", 0, std::errc(), 0, {})) {
+    return EXIT_FAILURE;
+  }
+  {
+    std::string const input = "1.5 0.25 -3";
+    uint16_t values[3];
+    auto const answer = fast_float::from_chars_bfloat16(
+        input.data(), input.data() + input.size(), values, 3, ' ');
+    if (!answer || answer.count != 3 || values[0] != 0x3fc0 ||
+        values[1] != 0x3e80 || values[2] != 0xc040) {
+      std::cerr << "bfloat16 array mismatch\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::u16string const input = u"0.5;0.25";
+    uint16_t values[2];
+    auto const answer = fast_float::from_chars_float16(
+        input.data(), input.data() + input.size(), values, 2, u';');
+    if (!answer || answer.ptr != input.data() + input.size() ||
+        answer.count != 2 || values[0] != 0x3800 || values[1] != 0x3400) {
+      std::cerr << "float16 mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
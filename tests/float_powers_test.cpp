@@ -0,0 +1,104 @@
+/*
+ * float_powers: the binary32 slice of the powers of five, used to parse float
+ * and narrower formats.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+bool check(std::string const &input) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  float value = 0;
+  auto const answer = fast_float::from_chars(first, last, value);
+  float const expected = std::strtof(input.c_str(), nullptr);
+  if (answer.ptr != last ||
+      std::memcmp(&value, &expected, sizeof(value)) != 0) {
+    std::cerr << "mismatch for " << input << ": " << std::hexfloat << value
+              << " " << expected << std::defaultfloat << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  using fast_float::float_powers;
+  using fast_float::powers;
+  for (fast_float::am_pow_t q = float_powers::smallest_power_of_five;
+       q <= float_powers::largest_power_of_five; ++q) {
+    auto const index = q - float_powers::smallest_power_of_five;
+    auto const wide_index = 2 * (q - powers::smallest_power_of_five);
+    if (float_powers::power_of_five_high[index] !=
+            powers::power_of_five_128[wide_index] ||
+        float_powers::power_of_five_low[index] !=
+            powers::power_of_five_128[wide_index + 1]) {
+      std::cerr << "bad entry for 5^" << q << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<std::string> const inputs{
+      "0.1",
+      "-3.14159",
+      "16777217",
+      "16777216.5",
+      "1e38",
+      "3.4028235e38",
+      "3.4028235677973366e38",
+      "3.4028235677973367e38",
+      "1.1754943508e-38",
+      "1.4012984643e-45",
+      "7.0064923216240854e-46",
+      "7.0064923216240862e-46",
+      "1e-64",
+      "9.999999999999999999e-46",
+      "1.00000005960464477539062499999999999999999",
+      "1.000000059604644775390625",
+      "1.00000017881393432617187499",
+      "0.000000000000000000000000000000000000011754943508222875",
+  };
+  for (auto const &input : inputs) {
+    if (!check(input)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Random floats, the halfway points between them, which need the most
+  // product bits, and integers of up to 20 digits times a power of ten.
+  std::mt19937_64 rng(39);
+  for (size_t i = 0; i < 200000; ++i) {
+    uint32_t const bits = uint32_t(rng()) & 0x7f7fffff;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 9) + 1,
+             double(value));
+    if (!check(buffer)) {
+      return EXIT_FAILURE;
+    }
+    float const next =
+        std::nextafter(value, std::numeric_limits<float>::infinity());
+    double const halfway = (double(value) + double(next)) / 2;
+    snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 10) + 9, halfway);
+    if (!check(buffer)) {
+      return EXIT_FAILURE;
+    }
+    snprintf(buffer, sizeof(buffer), "%llue%d",
+             static_cast<unsigned long long>(rng() >> (rng() % 64)),
+             int(rng() % 110) - 80);
+    if (!check(buffer)) {
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,222 @@
+/*
+ * Exercise from_chars_interval: the two values that enclose a decimal number.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+#if defined(__GLIBC__)
+#include <cfenv>
+#include <cstdio>
+#include <random>
+#endif
+
+// `exact` when the number is representable, otherwise whether the nearest
+// value (as returned by from_chars) is the upper bound.
+struct test_case {
+  std::string input;
+  bool double_exact;
+  bool double_nearest_is_hi;
+  bool float_exact;
+  bool float_nearest_is_hi;
+};
+
+template <typename T>
+bool same(T a, T b) {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+bool check(std::string const &input, bool exact, bool nearest_is_hi) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  T nearest = 0;
+  auto const expected = fast_float::from_chars(first, last, nearest);
+  T lo = 0, hi = 0;
+  auto const answer = fast_float::from_chars_interval(first, last, lo, hi);
+  T expected_lo = nearest, expected_hi = nearest;
+  if (!exact) {
+    if (nearest_is_hi) {
+      expected_lo = std::nextafter(nearest, -std::numeric_limits<T>::infinity());
+    } else {
+      expected_hi = std::nextafter(nearest, std::numeric_limits<T>::infinity());
+    }
+  }
+  if (answer.ptr != expected.ptr || answer.exact != exact ||
+      !same(lo, expected_lo) || !same(hi, expected_hi)) {
+    std::cerr << "mismatch for " << input << " (" << sizeof(T)
+              << " bytes): " << std::hexfloat << lo << " " << hi << " "
+              << answer.exact << std::defaultfloat << "\n";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool check_bounds(std::string const &input, T expected_lo, T expected_hi,
+                  std::errc ec) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  T lo = 0, hi = 0;
+  auto const answer = fast_float::from_chars_interval(first, last, lo, hi);
+  if (answer.ptr != last || answer.ec != ec || !same(lo, expected_lo) ||
+      !same(hi, expected_hi)) {
+    std::cerr << "bounds mismatch for " << input << ": " << std::hexfloat
+              << lo << " " << hi << std::defaultfloat << "\n";
+    return false;
+  }
+  return true;
+}
+
+#if defined(__GLIBC__)
+// glibc strtod follows the rounding mode: it gives the reference bounds.
+bool check_against_strtod(std::string const &input) {
+  double lo, hi;
+  auto const answer = fast_float::from_chars_interval(
+      input.data(), input.data() + input.size(), lo, hi);
+  std::fesetround(FE_DOWNWARD);
+  double const expected_lo = std::strtod(input.c_str(), nullptr);
+  std::fesetround(FE_UPWARD);
+  double const expected_hi = std::strtod(input.c_str(), nullptr);
+  std::fesetround(FE_TONEAREST);
+  if (!same(lo, expected_lo) || !same(hi, expected_hi) ||
+      answer.exact != (expected_lo == expected_hi)) {
+    std::cerr << "strtod mismatch for " << input << "\n";
+    return false;
+  }
+  return true;
+}
+#endif
+
+int main() {
+  std::vector<test_case> cases{
+      {"0", true, false, true, false},
+      {"-0", true, false, true, false},
+      {"0e400", true, false, true, false},
+      {"1", true, false, true, false},
+      {"-2.5", true, false, true, false},
+      {"0.25", true, false, true, false},
+      {"1.125e3", true, false, true, false},
+      {"0.1", false, true, false, true},
+      {"-0.1", false, false, false, false},
+      {"0.2", false, true, false, true},
+      {"0.3", false, false, false, true},
+      {"3.14159", false, false, false, true},
+      {"9.5367431640625e-7", true, false, true, false},
+      {"16777217", true, false, false, false},
+      {"16777219", true, false, false, true},
+      {"9007199254740993", false, false, false, false},
+      {"9007199254740995", false, true, false, false},
+      {"1e23", false, false, false, false},
+      {"123456789012345678901234567890", false, false, false, true},
+      {"1.000000000000000000000000000000", true, false, true, false},
+      {"0.1000000000000000055511151231257827021181583404541015625", true,
+       false, false, true},
+      {"0.10000000000000000555111512312578270211815834045410156250000000001",
+       false, false, false, true},
+      {"0.10000000000000000555111512312578270211815834045410156249999999999",
+       false, true, false, true},
+      {"2.2250738585072014e-308", false, false, false, false},
+      {"4.9406564584124654e-324", false, true, false, false},
+      {"1.7976931348623157e308", false, true, false, true},
+  };
+  for (auto const &c : cases) {
+    if (!check<double>(c.input, c.double_exact, c.double_nearest_is_hi) ||
+        !check<float>(c.input, c.float_exact, c.float_nearest_is_hi)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  double const dmax = std::numeric_limits<double>::max();
+  double const dinf = std::numeric_limits<double>::infinity();
+  double const dtrue_min = std::numeric_limits<double>::denorm_min();
+  if (!check_bounds("1.7976931348623158e308", dmax, dinf,
+                    std::errc::result_out_of_range) ||
+      !check_bounds("-1e400", -dinf, -dmax, std::errc::result_out_of_range) ||
+      !check_bounds("1e-400", 0.0, dtrue_min,
+                    std::errc::result_out_of_range) ||
+      !check_bounds("-3e-324", -dtrue_min, -0.0,
+                    std::errc::result_out_of_range) ||
+      !check_bounds("inf", dinf, dinf, std::errc()) ||
+      !check_bounds("-infinity", -dinf, -dinf, std::errc()) ||
+      !check_bounds("3.5e38", std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::infinity(),
+                    std::errc::result_out_of_range)) {
+    return EXIT_FAILURE;
+  }
+  {
+    std::string const input = "nan";
+    double lo = 0, hi = 0;
+    auto const answer = fast_float::from_chars_interval(
+        input.data(), input.data() + input.size(), lo, hi);
+    if (answer.ec != std::errc() || lo == lo || hi == hi) {
+      std::cerr << "nan should be stored in both bounds\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "x";
+    double lo = 1, hi = 2;
+    auto const answer = fast_float::from_chars_interval(
+        input.data(), input.data() + input.size(), lo, hi);
+    if (answer.ec != std::errc::invalid_argument ||
+        answer.ptr != input.data() || lo != 1 || hi != 2) {
+      std::cerr << "invalid input should leave the bounds alone\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::u16string const input = u"  0.1;";
+    float lo = 0, hi = 0;
+    fast_float::parse_options_t<char16_t> const options(
+        fast_float::chars_format::general |
+        fast_float::chars_format::skip_white_space);
+    auto const answer = fast_float::from_chars_interval_advanced(
+        input.data(), input.data() + input.size(), lo, hi, options);
+    if (!answer || answer.ptr != input.data() + 5 || answer.exact ||
+        lo != 0.099999994f || hi != 0.1f) {
+      std::cerr << "mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::string const input = "0.1";
+    fast_float::float16_bits lo{}, hi{};
+    auto const answer = fast_float::from_chars_interval(
+        input.data(), input.data() + input.size(), lo, hi);
+    if (!answer || answer.exact || lo.bits != 0x2e66 || hi.bits != 0x2e67) {
+      std::cerr << "mismatch for float16_bits\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+#if defined(__GLIBC__)
+  std::mt19937_64 rng(42);
+  for (size_t i = 0; i < 20000; ++i) {
+    uint64_t const bits = rng();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 20) + 1, value);
+    if (!check_against_strtod(buffer)) {
+      return EXIT_FAILURE;
+    }
+    snprintf(buffer, sizeof(buffer), "%.4f", double(rng() % 2000000) / 1024);
+    if (!check_against_strtod(buffer)) {
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
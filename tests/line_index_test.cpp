@@ -0,0 +1,213 @@
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Runs the jobs of a parallel build, one thread each.
+void in_threads(size_t const count, std::function<void(size_t)> const &job) {
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < count; ++i) {
+    threads.emplace_back(job, i);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+void one_by_one(size_t const count, std::function<void(size_t)> const &job) {
+  for (size_t i = count; i != 0; --i) {
+    job(i - 1);
+  }
+}
+
+// A text of rows of numbers, some cut short, with "\n" or "\r\n", and the
+// starts of its lines.
+std::string make_text(std::mt19937_64 &rng, size_t const rows,
+                      bool const final_newline,
+                      std::vector<size_t> &line_starts) {
+  std::uniform_real_distribution<double> dis(-1000, 1000);
+  char const *const formats[] = {"%.2f", "%.17g", "%.3e", "%.0f"};
+  std::string text;
+  char buffer[64];
+  for (size_t row = 0; row < rows; ++row) {
+    line_starts.push_back(text.size());
+    size_t const columns = (rng() % 16 == 0) ? size_t(rng() % 5) : 5;
+    for (size_t column = 0; column < columns; ++column) {
+      snprintf(buffer, sizeof(buffer), formats[rng() % 4], dis(rng));
+      text += buffer;
+      if (column + 1 != columns) {
+        text += ',';
+      }
+    }
+    if (row + 1 != rows || final_newline) {
+      text += (rng() % 4 == 0) ? "\r\n" : "\n";
+    }
+  }
+  return text;
+}
+
+bool check_lines(fast_float::line_index_t<char> const &index,
+                 std::string const &text,
+                 std::vector<size_t> const &line_starts, char const *name) {
+  char const *const first = text.data();
+  char const *const last = first + text.size();
+  if (index.lines() != line_starts.size()) {
+    std::cerr << name << ": " << index.lines() << " lines instead of "
+              << line_starts.size() << "\n";
+    return false;
+  }
+  for (size_t row = 0; row < line_starts.size(); ++row) {
+    if (index.line(first, last, row) != first + line_starts[row]) {
+      std::cerr << name << ": line " << row << " is misplaced\n";
+      return false;
+    }
+  }
+  if (index.line(first, last, line_starts.size()) != last) {
+    std::cerr << name << ": a line past the end\n";
+    return false;
+  }
+  return true;
+}
+
+// Every column of every range of rows is parsed as from_chars_advanced parses
+// the fields one by one.
+bool check_columns(fast_float::line_index_t<char> const &index,
+                   std::string const &text,
+                   std::vector<size_t> const &line_starts,
+                   std::mt19937_64 &rng) {
+  char const *const first = text.data();
+  char const *const last = first + text.size();
+  std::vector<double> values(line_starts.size());
+  for (size_t round = 0; round < 2000; ++round) {
+    size_t const row = size_t(rng() % (line_starts.size() + 2));
+    size_t const count = size_t(rng() % 300);
+    size_t const column = size_t(rng() % 6);
+    auto const answer =
+        index.parse_column(first, last, row, count, column, values.data());
+    // the reference, field by field
+    size_t expected = 0;
+    std::errc ec = std::errc();
+    char const *ptr =
+        row < line_starts.size() ? first + line_starts[row] : last;
+    for (size_t r = row; r < line_starts.size() && expected < count; ++r) {
+      char const *field = first + line_starts[r];
+      size_t skipped = 0;
+      while (skipped < column && field != last && *field != '\n') {
+        if (*field++ == ',') {
+          ++skipped;
+        }
+      }
+      double value = 0;
+      auto const number = fast_float::from_chars(field, last, value);
+      if (skipped < column || number.ec != std::errc() ||
+          (number.ptr != last && *number.ptr != ',' && *number.ptr != '\r' &&
+           *number.ptr != '\n')) {
+        ec = std::errc::invalid_argument;
+        ptr = field;
+        break;
+      }
+      if (value != values[expected]) {
+        std::cerr << "row " << r << " column " << column << ": "
+                  << values[expected] << " instead of " << value << "\n";
+        return false;
+      }
+      ++expected;
+      ptr = r + 1 < line_starts.size() ? first + line_starts[r + 1] : last;
+    }
+    if (answer.count != expected || answer.ec != ec || answer.ptr != ptr) {
+      std::cerr << "rows " << row << " to " << row + count << " column "
+                << column << ": " << answer.count << " values instead of "
+                << expected << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  std::mt19937_64 rng(48);
+  size_t const row_counts[] = {0, 1, 2, 1000, 5000};
+  uint64_t const strides[] = {1, 3, 64, 1024};
+  size_t const chunk_counts[] = {1, 3, 7, 256};
+  for (bool const final_newline : {true, false}) {
+    for (size_t const rows : row_counts) {
+      std::vector<size_t> line_starts;
+      std::string const text =
+          make_text(rng, rows, final_newline, line_starts);
+      char const *const first = text.data();
+      char const *const last = first + text.size();
+      for (uint64_t const stride : strides) {
+        size_t const capacity = size_t((rows + stride - 1) / stride);
+        std::vector<uint64_t> starts(capacity);
+        fast_float::line_index_t<char> index(starts.data(), capacity, stride);
+        if (index.build(first, last) != std::errc() ||
+            index.samples() != capacity ||
+            !check_lines(index, text, line_starts, "one pass")) {
+          return EXIT_FAILURE;
+        }
+        for (size_t const chunks : chunk_counts) {
+          std::vector<uint64_t> parallel(capacity);
+          fast_float::line_index_t<char> chunked(parallel.data(), capacity,
+                                                 stride);
+          if (chunked.build(first, last, chunks,
+                            chunks == 7 ? in_threads : one_by_one) !=
+                  std::errc() ||
+              parallel != starts ||
+              !check_lines(chunked, text, line_starts, "in parts")) {
+            std::cerr << chunks << " parts, stride " << stride << "\n";
+            return EXIT_FAILURE;
+          }
+        }
+        // an index read back from storage
+        std::vector<uint64_t> stored(starts);
+        fast_float::line_index_t<char> const reloaded(
+            stored.data(), stored.size(), index.stride(), index.lines());
+        if (!check_lines(reloaded, text, line_starts, "reloaded") ||
+            (stride == 3 && !check_columns(reloaded, text, line_starts, rng))) {
+          return EXIT_FAILURE;
+        }
+        // the same text in UTF-16
+        std::u16string const wide(text.begin(), text.end());
+        std::vector<uint64_t> wide_starts(capacity);
+        fast_float::line_index_t<char16_t> wide_index(wide_starts.data(),
+                                                      capacity, stride);
+        double narrow[8] = {};
+        double values[8] = {};
+        if (wide_index.build(wide.data(), wide.data() + wide.size()) !=
+                std::errc() ||
+            wide_starts != starts ||
+            wide_index
+                    .parse_column(wide.data(), wide.data() + wide.size(), 0, 8,
+                                  1, values)
+                    .count != index.parse_column(first, last, 0, 8, 1, narrow)
+                                  .count ||
+            std::memcmp(values, narrow, sizeof(values)) != 0) {
+          std::cerr << "UTF-16, stride " << stride << "\n";
+          return EXIT_FAILURE;
+        }
+        // one sample too few
+        if (capacity != 0) {
+          fast_float::line_index_t<char> small(starts.data(), capacity - 1,
+                                               stride);
+          if (small.build(first, last) != std::errc::value_too_large ||
+              small.build(first, last, 7, in_threads) !=
+                  std::errc::value_too_large ||
+              small.lines() != 0) {
+            std::cerr << "the index went past its capacity\n";
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
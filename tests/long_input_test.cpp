@@ -0,0 +1,102 @@
+/*
+ * Numbers far longer than any value needs: megabytes of digits or of zeros in
+ * a single token must parse correctly and consume the whole token.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include "fast_float/fast_float.h"
+
+bool check(std::string const &input) {
+  char const *first = input.data();
+  char const *last = first + input.size();
+  double value = 0;
+  auto const answer = fast_float::from_chars(first, last, value);
+  double const expected = std::strtod(input.c_str(), nullptr);
+  if (answer.ptr != last ||
+      std::memcmp(&value, &expected, sizeof(value)) != 0) {
+    std::cerr << "mismatch for a " << input.size() << "-byte input starting "
+              << input.substr(0, 40) << ": " << std::hexfloat << value << " "
+              << expected << std::defaultfloat << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool check_utf16(std::string const &input) {
+  std::u16string const wide(input.begin(), input.end());
+  double value = 0;
+  auto const answer =
+      fast_float::from_chars(wide.data(), wide.data() + wide.size(), value);
+  double const expected = std::strtod(input.c_str(), nullptr);
+  if (answer.ptr != wide.data() + wide.size() ||
+      std::memcmp(&value, &expected, sizeof(value)) != 0) {
+    std::cerr << "char16_t mismatch for a " << input.size()
+              << "-byte input starting " << input.substr(0, 40) << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  std::mt19937_64 rng(41);
+  for (size_t size : {size_t(20), size_t(64), size_t(1000), size_t(1) << 20}) {
+    std::string digits(size, '0');
+    for (char &c : digits) {
+      c = char('0' + rng() % 10);
+    }
+    digits[0] = char('1' + rng() % 9);
+    std::string const zeros(size, '0');
+    std::string const inputs[] = {
+        digits,
+        "3." + digits,
+        digits + "e-300",
+        "0." + zeros + "1",
+        "0." + zeros + digits,
+        zeros + "1.5",
+        zeros + digits + "." + zeros,
+        "-" + zeros + "." + zeros + "7e300",
+        // halfway between two doubles, decided only by the very last digit
+        "9007199254740993" + zeros,
+        "9007199254740993" + zeros + "1",
+        "9007199254740993." + zeros + "1",
+        "1" + zeros + "e-300",
+    };
+    for (auto const &input : inputs) {
+      if (!check(input)) {
+        return EXIT_FAILURE;
+      }
+    }
+    if (!check_utf16(digits) || !check_utf16("0." + zeros + "1") ||
+        !check_utf16("9007199254740993" + zeros + "1")) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A long number ends at the first character that is not a digit.
+  std::string const followed = "0." + std::string(100000, '9') + "x";
+  double value = 0;
+  auto const answer = fast_float::from_chars(
+      followed.data(), followed.data() + followed.size(), value);
+  if (answer.ptr != followed.data() + followed.size() - 1 || value != 1) {
+    std::cerr << "long number followed by a letter\n";
+    return EXIT_FAILURE;
+  }
+
+  // JSON has the same limits on the length of a number as plain parsing.
+  std::string const json = "-2." + std::string(100000, '0') + "25";
+  fast_float::parse_options const options{fast_float::chars_format::json};
+  auto const json_answer = fast_float::from_chars_advanced(
+      json.data(), json.data() + json.size(), value, options);
+  if (json_answer.ec != std::errc() ||
+      json_answer.ptr != json.data() + json.size() || value != -2) {
+    std::cerr << "long json number\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
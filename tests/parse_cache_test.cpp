@@ -0,0 +1,128 @@
+#include "fast_float/fast_float.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Every token must be parsed as from_chars_advanced parses it, whether it
+// comes from the cache or not.
+template <typename T, size_t Slots>
+bool check_tokens(std::string const &text,
+                  fast_float::parse_options const options, char const *name,
+                  bool const expect_hits) {
+  fast_float::parse_cache_t<T, char, Slots> cache(options);
+  char const *p = text.data();
+  char const *const end = text.data() + text.size();
+  size_t count = 0;
+  while (p != end) {
+    T value = 0;
+    T expected = 0;
+    auto const answer = cache.parse(p, end, value);
+    auto const reference =
+        fast_float::from_chars_advanced(p, end, expected, options);
+    if (answer.ec != reference.ec || answer.ptr != reference.ptr ||
+        (reference.ec == std::errc() &&
+         std::memcmp(&value, &expected, sizeof(T)) != 0)) {
+      std::cerr << name << ": \"" << std::string(p, reference.ptr)
+                << "\" differs from from_chars_advanced\n";
+      return false;
+    }
+    ++count;
+    // skip the token, or a character if there is none
+    p = (reference.ptr == p) ? p + 1 : reference.ptr;
+  }
+  if (cache.hits() + cache.misses() != count ||
+      (cache.hits() != 0) != expect_hits) {
+    std::cerr << name << ": " << cache.hits() << " hits and "
+              << cache.misses() << " misses\n";
+    return false;
+  }
+  return true;
+}
+
+std::string repeat_tokens(std::vector<std::string> const &pool,
+                          size_t const count) {
+  std::mt19937_64 rng(46);
+  char const separators[] = {',', ' ', '\n', 'x', ';', 'e', '+', '.', 'd'};
+  std::string text;
+  for (size_t i = 0; i < count; ++i) {
+    text += pool[rng() % pool.size()];
+    text += separators[rng() % sizeof(separators)];
+  }
+  // the last token is cut by the end of the input
+  return text + pool[0];
+}
+
+int main() {
+  std::mt19937_64 rng(46);
+  std::uniform_real_distribution<double> dis(-1000, 1000);
+  std::vector<std::string> pool;
+  char buffer[64];
+  char const *const formats[] = {"%.2f", "%.0f",  "%.17g", "%.3e",
+                                 "%g",   "%.9f", "%.1E",  "%+.2f"};
+  for (size_t i = 0; i < 400; ++i) {
+    snprintf(buffer, sizeof(buffer), formats[i % 8], dis(rng));
+    pool.push_back(buffer);
+  }
+  for (char const *odd : {"1e", "1e+", "-", ".", "+1", "-0", "0.", ".5", "1e400",
+                          "1e-400", "inf", "-nan", "123456789012345",
+                          "1234567890123456", "1.5e+10-3", "2..5", "7"}) {
+    pool.push_back(odd);
+  }
+  std::string const text = repeat_tokens(pool, 50000);
+  fast_float::parse_options const general(fast_float::chars_format::general);
+  if (!check_tokens<double, 1024>(text, general, "double", true) ||
+      !check_tokens<float, 1024>(text, general, "float", true) ||
+      !check_tokens<double, 2>(text, general, "double, 2 slots", true) ||
+      !check_tokens<int64_t, 256>(text, general, "int64_t", true) ||
+      !check_tokens<uint32_t, 256>(text, general, "uint32_t", true)) {
+    return EXIT_FAILURE;
+  }
+  fast_float::parse_options const json(fast_float::chars_format::json);
+  fast_float::parse_options const integral(
+      fast_float::chars_format::general |
+      fast_float::chars_format::allow_integral_float);
+  fast_float::parse_options const plus(
+      fast_float::chars_format::general |
+      fast_float::chars_format::allow_leading_plus);
+  fast_float::parse_options const spaces(
+      fast_float::chars_format::general |
+      fast_float::chars_format::skip_white_space);
+  fast_float::parse_options const comma(fast_float::chars_format::general,
+                                        ',');
+  fast_float::parse_options const fortran(fast_float::chars_format::fortran);
+  fast_float::parse_options const upward(
+      fast_float::chars_format::general, '.', 10,
+      fast_float::rounding_mode::upward);
+  fast_float::parse_options const hexadecimal(
+      fast_float::chars_format::general, '.', 16);
+  if (!check_tokens<double, 1024>(text, json, "json", true) ||
+      !check_tokens<int64_t, 1024>(text, integral, "integral", true) ||
+      !check_tokens<double, 1024>(text, plus, "leading plus", true) ||
+      !check_tokens<double, 1024>(text, spaces, "white space", true) ||
+      !check_tokens<double, 1024>(text, comma, "comma", true) ||
+      !check_tokens<double, 1024>(text, upward, "upward", true) ||
+      !check_tokens<double, 1024>(text, fortran, "fortran", false) ||
+      !check_tokens<int64_t, 1024>(text, hexadecimal, "base 16", false)) {
+    return EXIT_FAILURE;
+  }
+  // the cache must not return a token it stored for a shorter input
+  fast_float::parse_cache_t<double> cache;
+  std::string const first = "1.5e";
+  std::string const second = "1.5e2";
+  double value = 0;
+  cache.parse(first.data(), first.data() + first.size(), value);
+  auto const answer =
+      cache.parse(second.data(), second.data() + second.size(), value);
+  if (answer.ptr != second.data() + second.size() || value != 150) {
+    std::cerr << "1.5e2 was read from the cache as 1.5e\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
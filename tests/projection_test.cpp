@@ -0,0 +1,167 @@
+#include "fast_float/fast_float.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// A text of rows of up to 40 fields of all widths, some rows cut short, with
+// "\n" or "\r\n", and the fields of each row.
+std::string make_text(std::mt19937_64 &rng, size_t const rows,
+                      std::vector<std::vector<std::string>> &fields) {
+  std::uniform_real_distribution<double> dis(-1000, 1000);
+  char const *const formats[] = {"%.2f", "%.17g", "%.3e", "%.0f", "%.25f"};
+  std::string text;
+  char buffer[64];
+  for (size_t row = 0; row < rows; ++row) {
+    size_t const columns = (rng() % 8 == 0) ? size_t(rng() % 40) + 1 : 40;
+    fields.emplace_back();
+    for (size_t column = 0; column < columns; ++column) {
+      snprintf(buffer, sizeof(buffer), formats[rng() % 5], dis(rng));
+      fields.back().push_back(buffer);
+      text += buffer;
+      if (column + 1 != columns) {
+        text += ',';
+      }
+    }
+    if (row + 1 != rows || rng() % 2 == 0) {
+      text += (rng() % 4 == 0) ? "\r\n" : "\n";
+    }
+  }
+  return text;
+}
+
+// The projected columns of the rows, parsed in slices of random sizes, must be
+// the fields parsed one by one.
+bool check_projection(std::string const &text,
+                      std::vector<std::vector<std::string>> const &fields,
+                      std::vector<size_t> const &columns,
+                      std::mt19937_64 &rng) {
+  std::vector<std::vector<double>> values(columns.size(),
+                                          std::vector<double>(fields.size()));
+  std::vector<double *> outputs;
+  for (std::vector<double> &column : values) {
+    outputs.push_back(column.data());
+  }
+  char const *p = text.data();
+  char const *const last = text.data() + text.size();
+  size_t row = 0;
+  while (p != last) {
+    size_t const rows = size_t(rng() % 100);
+    std::vector<double *> slice;
+    for (double *output : outputs) {
+      slice.push_back(output + row);
+    }
+    auto const answer = fast_float::from_chars_columns(
+        p, last, columns.data(), columns.size(), slice.data(), rows);
+    // the reference: the rows up to the first one missing a column
+    size_t expected = 0;
+    while (expected < rows && row + expected < fields.size() &&
+           (columns.empty() ||
+            columns.back() < fields[row + expected].size())) {
+      ++expected;
+    }
+    if (answer.count != expected) {
+      std::cerr << answer.count << " rows instead of " << expected
+                << " from row " << row << "\n";
+      return false;
+    }
+    for (size_t r = row; r < row + expected; ++r) {
+      for (size_t k = 0; k < columns.size(); ++k) {
+        double value = 0;
+        std::string const &field = fields[r][columns[k]];
+        fast_float::from_chars(field.data(), field.data() + field.size(),
+                               value);
+        if (value != values[k][r]) {
+          std::cerr << "row " << r << " column " << columns[k] << ": "
+                    << values[k][r] << " instead of " << value << "\n";
+          return false;
+        }
+      }
+    }
+    row += expected;
+    if (answer.ec == std::errc::invalid_argument) {
+      if (expected == rows || row == fields.size()) {
+        std::cerr << "row " << row << " was refused\n";
+        return false;
+      }
+      // go on from the next row
+      uint64_t one = 1;
+      p = fast_float::skip_lines(answer.ptr, last, one);
+      ++row;
+    } else if (answer.ec != std::errc()) {
+      std::cerr << "row " << row << " failed\n";
+      return false;
+    } else {
+      p = answer.ptr;
+    }
+  }
+  if (row != fields.size()) {
+    std::cerr << row << " rows read instead of " << fields.size() << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  std::mt19937_64 rng(49);
+  std::vector<std::vector<std::string>> fields;
+  std::string const text = make_text(rng, 3000, fields);
+  for (size_t round = 0; round < 200; ++round) {
+    std::vector<size_t> columns;
+    for (size_t n = size_t(rng() % 6); n != 0; --n) {
+      columns.push_back(size_t(rng() % 42));
+    }
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    if (!check_projection(text, fields, columns, rng)) {
+      return EXIT_FAILURE;
+    }
+  }
+  char const *const first = text.data();
+  char const *const last = first + text.size();
+  // the columns must be in increasing order
+  size_t const unordered[] = {3, 1};
+  double a[4];
+  double b[4];
+  double *const outputs[] = {a, b};
+  auto const refused =
+      fast_float::from_chars_columns(first, last, unordered, 2, outputs, 4);
+  if (refused.ec != std::errc::invalid_argument || refused.count != 0) {
+    std::cerr << "columns out of order were accepted\n";
+    return EXIT_FAILURE;
+  }
+  // a field which is not a number of its own
+  std::string const odd = "1,2,3\n4,5x,6\n";
+  size_t const second[] = {1};
+  auto const stopped = fast_float::from_chars_columns(
+      odd.data(), odd.data() + odd.size(), second, 1, outputs, 4);
+  if (stopped.ec != std::errc::invalid_argument || stopped.count != 1 ||
+      stopped.ptr != odd.data() + 8 || a[0] != 2) {
+    std::cerr << "5x was accepted\n";
+    return EXIT_FAILURE;
+  }
+  // the same text in UTF-16
+  std::u16string const wide(text.begin(), text.end());
+  size_t const pair[] = {0, 7};
+  double c[4];
+  double d[4];
+  double *const wide_outputs[] = {c, d};
+  auto const narrow =
+      fast_float::from_chars_columns(first, last, pair, 2, outputs, 4);
+  auto const utf16 = fast_float::from_chars_columns(
+      wide.data(), wide.data() + wide.size(), pair, 2, wide_outputs, 4);
+  if (utf16.count != narrow.count ||
+      std::memcmp(a, c, sizeof(double) * narrow.count) != 0 ||
+      std::memcmp(b, d, sizeof(double) * narrow.count) != 0) {
+    std::cerr << "UTF-16 differs\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
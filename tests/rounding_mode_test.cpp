@@ -0,0 +1,232 @@
+/*
+ * Exercise the rounding field of parse_options_t.
+ */
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "fast_float/fast_float.h"
+
+template <typename T>
+bool same(T a, T b) {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+T parse(std::string const &input, fast_float::rounding_mode rounding,
+        std::errc &ec) {
+  fast_float::parse_options const options(fast_float::chars_format::general,
+                                          '.', 10, rounding);
+  T value = 0;
+  auto const answer = fast_float::from_chars_advanced(
+      input.data(), input.data() + input.size(), value, options);
+  ec = answer.ptr == input.data() + input.size() ? answer.ec
+                                                 : std::errc::invalid_argument;
+  return value;
+}
+
+// The directed modes pick one of the bounds of from_chars_interval.
+template <typename T> bool check(std::string const &input) {
+  T lo = 0, hi = 0;
+  auto const interval = fast_float::from_chars_interval(
+      input.data(), input.data() + input.size(), lo, hi);
+  if (interval.ec != std::errc() || std::isnan(lo)) {
+    return true;
+  }
+  bool const negative = std::signbit(lo) || std::signbit(hi);
+  struct {
+    fast_float::rounding_mode rounding;
+    T expected;
+  } const modes[] = {{fast_float::rounding_mode::toward_zero, negative ? hi : lo},
+                     {fast_float::rounding_mode::upward, hi},
+                     {fast_float::rounding_mode::downward, lo}};
+  for (auto const &mode : modes) {
+    std::errc ec{};
+    T const value = parse<T>(input, mode.rounding, ec);
+    if (ec != std::errc() || !same(value, mode.expected)) {
+      std::cerr << "mismatch for " << input << " (" << sizeof(T)
+                << " bytes, mode " << int(mode.rounding)
+                << "): " << std::hexfloat << value << " " << mode.expected
+                << std::defaultfloat << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(__GLIBC__)
+// follow_fpu rounds like strtod, nearest_even ignores the environment.
+bool check_fpu(std::string const &input) {
+  struct {
+    int fpu;
+    fast_float::rounding_mode rounding;
+  } const modes[] = {
+      {FE_TONEAREST, fast_float::rounding_mode::nearest_even},
+      {FE_TOWARDZERO, fast_float::rounding_mode::toward_zero},
+      {FE_UPWARD, fast_float::rounding_mode::upward},
+      {FE_DOWNWARD, fast_float::rounding_mode::downward},
+  };
+  std::errc ec{};
+  double const nearest =
+      parse<double>(input, fast_float::rounding_mode::nearest_even, ec);
+  for (auto const &mode : modes) {
+    double const expected = parse<double>(input, mode.rounding, ec);
+    std::fesetround(mode.fpu);
+    double const followed =
+        parse<double>(input, fast_float::rounding_mode::follow_fpu, ec);
+    double const strtod_value = std::strtod(input.c_str(), nullptr);
+    double const default_value =
+        parse<double>(input, fast_float::rounding_mode::nearest_even, ec);
+    std::fesetround(FE_TONEAREST);
+    if (!same(followed, expected) || !same(followed, strtod_value) ||
+        !same(default_value, nearest)) {
+      std::cerr << "fpu mismatch for " << input << " (mode " << mode.fpu
+                << ")\n";
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+int main() {
+  std::vector<std::string> const inputs{
+      "0",
+      "-0",
+      "1",
+      "-2.5",
+      "0.1",
+      "-0.1",
+      "0.3",
+      "3.14159",
+      "-3.14159",
+      "16777217",
+      "-16777217",
+      "9007199254740993",
+      "1e23",
+      "-1e23",
+      "0.1000000000000000055511151231257827021181583404541015625",
+      "0.10000000000000000555111512312578270211815834045410156250000000001",
+      "-0.10000000000000000555111512312578270211815834045410156249999999999",
+      "2.2250738585072014e-308",
+      "4.9406564584124654e-324",
+      "-1e-400",
+      "1.7976931348623157e308",
+      "-1.7976931348623158e308",
+      "1e400",
+  };
+  for (auto const &input : inputs) {
+    if (!check<double>(input) || !check<float>(input)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Overflow: toward zero keeps the largest finite value.
+  std::errc ec{};
+  double value = parse<double>("1e400", fast_float::rounding_mode::toward_zero,
+                               ec);
+  if (ec != std::errc() || value != std::numeric_limits<double>::max()) {
+    std::cerr << "toward zero should not overflow\n";
+    return EXIT_FAILURE;
+  }
+  value = parse<double>("1e400", fast_float::rounding_mode::upward, ec);
+  if (ec != std::errc::result_out_of_range || !std::isinf(value)) {
+    std::cerr << "upward should overflow\n";
+    return EXIT_FAILURE;
+  }
+  // Underflow: upward keeps the smallest subnormal.
+  value = parse<double>("1e-400", fast_float::rounding_mode::upward, ec);
+  if (ec != std::errc() ||
+      value != std::numeric_limits<double>::denorm_min()) {
+    std::cerr << "upward should not underflow\n";
+    return EXIT_FAILURE;
+  }
+  value = parse<double>("1e-400", fast_float::rounding_mode::downward, ec);
+  if (ec != std::errc::result_out_of_range || value != 0) {
+    std::cerr << "downward should underflow\n";
+    return EXIT_FAILURE;
+  }
+
+  // The half-precision bit patterns, including the integer fast path.
+  struct {
+    std::string input;
+    fast_float::rounding_mode rounding;
+    uint16_t bits;
+  } const halves[] = {
+      {"0.1", fast_float::rounding_mode::toward_zero, 0x2e66},
+      {"0.1", fast_float::rounding_mode::upward, 0x2e67},
+      {"-0.1", fast_float::rounding_mode::downward, 0xae67},
+      {"-0.1", fast_float::rounding_mode::upward, 0xae66},
+      {"2049", fast_float::rounding_mode::toward_zero, 0x6800},
+      {"2049", fast_float::rounding_mode::upward, 0x6801},
+      {"-2049", fast_float::rounding_mode::downward, 0xe801},
+      {"-2049", fast_float::rounding_mode::upward, 0xe800},
+      {"65519", fast_float::rounding_mode::upward, 0x7c00},
+      {"65519", fast_float::rounding_mode::downward, 0x7bff},
+  };
+  for (auto const &half : halves) {
+    fast_float::float16_bits result{};
+    fast_float::parse_options const options(fast_float::chars_format::general,
+                                            '.', 10, half.rounding);
+    fast_float::from_chars_advanced(half.input.data(),
+                                    half.input.data() + half.input.size(),
+                                    result, options);
+    if (result.bits != half.bits) {
+      std::cerr << "float16 mismatch for " << half.input << ": " << std::hex
+                << result.bits << std::dec << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  {
+    std::u16string const input = u"-0.1";
+    float result = 0;
+    fast_float::parse_options_t<char16_t> const options(
+        fast_float::chars_format::general, u'.', 10,
+        fast_float::rounding_mode::toward_zero);
+    auto const answer = fast_float::from_chars_advanced(
+        input.data(), input.data() + input.size(), result, options);
+    if (!answer || result != -0.099999994f) {
+      std::cerr << "mismatch for char16_t input\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::mt19937_64 rng(7);
+  for (size_t i = 0; i < 20000; ++i) {
+    uint64_t const bits = rng();
+    double random_value;
+    std::memcpy(&random_value, &bits, sizeof(random_value));
+    if (!std::isfinite(random_value)) {
+      continue;
+    }
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 20) + 1,
+             random_value);
+    if (!check<double>(buffer) || !check<float>(buffer)) {
+      return EXIT_FAILURE;
+    }
+#if defined(__GLIBC__)
+    if (i % 8 == 0 && !check_fpu(buffer)) {
+      return EXIT_FAILURE;
+    }
+#endif
+  }
+#if defined(__GLIBC__)
+  for (auto const &input : inputs) {
+    if (!check_fpu(input)) {
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
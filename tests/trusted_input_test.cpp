@@ -0,0 +1,101 @@
+/*
+ * Exercise FASTFLOAT_TRUSTED_INPUT: well-formed numbers parse as they do with
+ * the grammar checked, and the contract is asserted where a check is skipped.
+ */
+#include <cstddef>
+
+static size_t contract_violations = 0;
+
+#ifndef FASTFLOAT_TRUSTED_INPUT
+#define FASTFLOAT_TRUSTED_INPUT
+#endif
+#define FASTFLOAT_DEBUG_ASSERT(x)                                              \
+  {                                                                            \
+    if (!(x)) {                                                                \
+      ++contract_violations;                                                   \
+    }                                                                          \
+  }
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include "fast_float/fast_float.h"
+
+bool check(std::string const &input,
+           fast_float::chars_format const fmt =
+               fast_float::chars_format::general) {
+  double value = 0;
+  auto const answer = fast_float::from_chars(
+      input.data(), input.data() + input.size(), value, fmt);
+  double const expected = std::strtod(input.c_str(), nullptr);
+  if (answer.ec != std::errc() || answer.ptr != input.data() + input.size() ||
+      std::memcmp(&value, &expected, sizeof(value)) != 0) {
+    std::cerr << "trusted parse of " << input << " differs from strtod\n";
+    return false;
+  }
+  return true;
+}
+
+// A malformed input which the parser can still walk without reading out of
+// bounds must be reported by the debug assertions.
+bool violates(std::string const &input, fast_float::chars_format const fmt) {
+  size_t const before = contract_violations;
+  double value;
+  fast_float::from_chars(input.data(), input.data() + input.size(), value,
+                         fmt);
+  if (contract_violations == before) {
+    std::cerr << "no contract violation reported for " << input << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  std::mt19937_64 rng(44);
+  std::uniform_real_distribution<double> dis(-1e6, 1e6);
+  char const *const formats[] = {"%.17g", "%.3f", "%.9e", "%g", "%.0f"};
+  char buffer[64];
+  for (size_t i = 0; i < 100000; ++i) {
+    double const d = dis(rng) * std::pow(10.0, int(rng() % 40) - 20);
+    std::snprintf(buffer, sizeof(buffer), formats[i % 5], d);
+    if (!check(buffer)) {
+      return EXIT_FAILURE;
+    }
+  }
+  if (!check("0") || !check("-0.0") || !check("1e308") || !check("2.5E-3") ||
+      !check("4.9e-324") || !check("123456789012345678901234567890") ||
+      !check("1.5e+10", fast_float::chars_format::scientific) ||
+      !check("-0.25", fast_float::chars_format::json)) {
+    return EXIT_FAILURE;
+  }
+  for (int64_t const expected : {int64_t(0), int64_t(-7), int64_t(42),
+                                 INT64_MAX, INT64_MIN}) {
+    std::string const input = std::to_string(expected);
+    int64_t value = 0;
+    auto const answer =
+        fast_float::from_chars(input.data(), input.data() + input.size(), value);
+    if (answer.ec != std::errc() || value != expected) {
+      std::cerr << "trusted integer parse of " << input << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (contract_violations != 0) {
+    std::cerr << "well-formed input reported as a contract violation\n";
+    return EXIT_FAILURE;
+  }
+
+  if (!violates("1e", fast_float::chars_format::general) ||
+      !violates("1e+", fast_float::chars_format::general) ||
+      !violates("1.5", fast_float::chars_format::scientific) ||
+      !violates("01", fast_float::chars_format::json) ||
+      !violates("1.", fast_float::chars_format::json)) {
+    return EXIT_FAILURE;
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+/*
+ * The emulated 64x64 -> 128-bit multiplication used on 32-bit targets, and
+ * the 8-digit parser built from 32-bit halves.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include "fast_float/fast_float.h"
+
+// Schoolbook multiplication in 16-bit digits.
+void reference(uint64_t a, uint64_t b, uint64_t &lo, uint64_t &hi) {
+  uint32_t digits[8] = {0};
+  for (int i = 0; i < 4; ++i) {
+    uint32_t carry = 0;
+    for (int j = 0; j < 4; ++j) {
+      uint32_t const t = uint32_t((a >> (16 * i)) & 0xFFFF) *
+                             uint32_t((b >> (16 * j)) & 0xFFFF) +
+                         digits[i + j] + carry;
+      digits[i + j] = t & 0xFFFF;
+      carry = t >> 16;
+    }
+    digits[i + 4] = carry;
+  }
+  lo = hi = 0;
+  for (int i = 3; i >= 0; --i) {
+    lo = (lo << 16) | digits[i];
+    hi = (hi << 16) | digits[i + 4];
+  }
+}
+
+bool check(uint64_t a, uint64_t b) {
+  uint64_t expected_lo = 0, expected_hi = 0;
+  reference(a, b, expected_lo, expected_hi);
+  uint64_t hi = 0;
+  uint64_t const lo = fast_float::umul128_generic(a, b, hi);
+  fast_float::value128 const full = fast_float::full_multiplication(a, b);
+  if (lo != expected_lo || hi != expected_hi || full.low != expected_lo ||
+      full.high != expected_hi) {
+    std::cerr << std::hex << "mismatch for " << a << " * " << b << "\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  uint64_t const edges[] = {0,
+                            1,
+                            2,
+                            0xFFFFFFFF,
+                            0x100000000,
+                            0xFFFFFFFF00000000,
+                            0x8000000000000000,
+                            0xFFFFFFFFFFFFFFFE,
+                            0xFFFFFFFFFFFFFFFF};
+  for (uint64_t a : edges) {
+    for (uint64_t b : edges) {
+      if (!check(a, b)) {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  std::mt19937_64 rng(40);
+  for (size_t i = 0; i < 1000000; ++i) {
+    // mostly full words, sometimes with long runs of ones or zeroes
+    uint64_t a = rng();
+    uint64_t b = rng();
+    if (i % 4 == 1) {
+      a |= ~uint64_t(0) >> (rng() % 64);
+    } else if (i % 4 == 2) {
+      b >>= rng() % 64;
+    }
+    if (!check(a, b)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (uint32_t i = 0; i < 100000000; i += 9973) {
+    char digits[8];
+    uint32_t v = i;
+    for (int j = 7; j >= 0; --j) {
+      digits[j] = char('0' + v % 10);
+      v /= 10;
+    }
+    if (fast_float::parse_8_digits(digits) != i) {
+      std::cerr << "parse_8_digits mismatch for " << i << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "all ok" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,7 @@
 #include "fast_float/fast_float.h"
+#include <cstdint>
 #include <iostream>
+#include <random>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -70,9 +72,114 @@ bool test_non_space_with_space_low_byte() {
   return true;
 }
 
+// Digit runs long enough for the 8 and 16 code unit kernels must parse as
+// they do in char, and a code unit whose low bits are a digit must end the
+// run wherever it sits, even though the kernels narrow the units to bytes.
+template <typename UC> bool test_digit_runs(uint32_t const alias) {
+  std::mt19937_64 rng(42);
+  for (size_t i = 0; i < 20000; ++i) {
+    std::string s(1 + rng() % 40, '0');
+    for (char &c : s) {
+      c = char('0' + rng() % 10);
+    }
+    if (i % 2 == 1) {
+      s.insert(rng() % s.size(), ".");
+    }
+    size_t const cut = rng() % (s.size() + 1);
+    std::basic_string<UC> input(s.begin(), s.end());
+    if (cut != s.size()) {
+      input[cut] = static_cast<UC>(alias + uint32_t(s[cut] - '0'));
+    }
+    s.resize(cut);
+    double expected = 0;
+    auto const reference =
+        fast_float::from_chars(s.data(), s.data() + s.size(), expected);
+    double result = 0;
+    auto const answer = fast_float::from_chars(
+        input.data(), input.data() + input.size(), result);
+    if (answer.ec != reference.ec ||
+        answer.ptr - input.data() != reference.ptr - s.data() ||
+        (reference.ec == std::errc() && result != expected)) {
+      std::cerr << "digit run of " << sizeof(UC) << "-byte units differs "
+                << "from char for \"" << s << "\"\n";
+      return false;
+    }
+    uint64_t integer = 0;
+    uint64_t expected_integer = 0;
+    auto const integer_reference = fast_float::from_chars(
+        s.data(), s.data() + s.size(), expected_integer);
+    auto const integer_answer = fast_float::from_chars(
+        input.data(), input.data() + input.size(), integer);
+    if (integer_answer.ec != integer_reference.ec ||
+        integer_answer.ptr - input.data() !=
+            integer_reference.ptr - s.data() ||
+        integer != expected_integer) {
+      std::cerr << "integer run of " << sizeof(UC) << "-byte units differs "
+                << "from char for \"" << s << "\"\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Runs of white space long enough for the vector skipper must end where the
+// scalar one does, also at a wide code unit whose low byte is white space.
+template <typename UC> bool test_space_runs(uint32_t const alias) {
+  char const spaces[] = {' ', '\t', '\n', '\v', '\f', '\r'};
+  fast_float::parse_options_t<UC> const options{
+      fast_float::chars_format::general |
+      fast_float::chars_format::skip_white_space};
+  std::mt19937_64 rng(43);
+  for (size_t i = 0; i < 20000; ++i) {
+    size_t const length = rng() % 80;
+    std::basic_string<UC> input;
+    for (size_t j = 0; j < length; ++j) {
+      input.push_back(UC(spaces[rng() % sizeof(spaces)]));
+    }
+    bool const aliased = alias != 0 && !input.empty() && rng() % 4 == 0;
+    size_t const cut = aliased ? rng() % input.size() : input.size();
+    if (aliased) {
+      input[cut] = static_cast<UC>(alias + uint32_t(input[cut]));
+    } else {
+      input += UC('4');
+      input += UC('2');
+    }
+    // trailing white space is not part of the number
+    input.append(rng() % 40, UC(' '));
+    double result = 0;
+    auto const answer = fast_float::from_chars_advanced(
+        input.data(), input.data() + input.size(), result, options);
+    int integer = 0;
+    auto const integer_answer = fast_float::from_chars_advanced(
+        input.data(), input.data() + input.size(), integer, options);
+    bool const ok =
+        aliased ? (answer.ec == std::errc::invalid_argument &&
+                   integer_answer.ec == std::errc::invalid_argument)
+                : (answer.ec == std::errc() &&
+                   answer.ptr == input.data() + cut + 2 && result == 42 &&
+                   integer_answer.ec == std::errc() &&
+                   integer_answer.ptr == answer.ptr && integer == 42);
+    if (!ok) {
+      std::cerr << "run of " << length << " spaces in " << sizeof(UC)
+                << "-byte units ends at the wrong place\n";
+      return false;
+    }
+  }
+  return true;
+}
+
 int main() {
   if (test_minus() && test_plus() && test_space() && test_nan() &&
-      test_non_space_with_space_low_byte()) {
+      test_non_space_with_space_low_byte() &&
+      test_digit_runs<char16_t>(0x100 + '0') &&
+      test_digit_runs<char16_t>(0xFF00 + '0') &&
+      test_digit_runs<char32_t>(0x10000 + '0') &&
+      test_digit_runs<char32_t>(0xFFFF0000 + '0') &&
+      test_digit_runs<wchar_t>(0x100 + '0') && test_space_runs<char>(0) &&
+      test_space_runs<char16_t>(0x100) && test_space_runs<char16_t>(0xFF00) &&
+      test_space_runs<char32_t>(0x10000) &&
+      test_space_runs<char32_t>(0xFFFFFF00) &&
+      test_space_runs<wchar_t>(0x100)) {
     std::cout << "all ok" << std::endl;
     return EXIT_SUCCESS;
   }